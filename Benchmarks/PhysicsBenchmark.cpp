@@ -0,0 +1,309 @@
+#include <LumosEngine.h>
+#include "Physics/LumosPhysicsEngine/BruteForceBroadphase.h"
+#include "Physics/LumosPhysicsEngine/SortAndSweepBroadphase.h"
+#include "Physics/LumosPhysicsEngine/Octree.h"
+#include "Physics/LumosPhysicsEngine/DistanceConstraint.h"
+#include "Physics/LumosPhysicsEngine/WeldConstraint.h"
+#include "Core/JobSystem.h"
+
+#include <jsonhpp/json.hpp>
+#include <fstream>
+#include <random>
+
+//Headless physics stress runner. Builds each scenario, steps it through LumosPhysicsEngine with every broadphase
+//and writes the per stage step timings as JSON, so CI runs can be compared against each other.
+//
+//	Benchmarks [--steps N] [--scenario name] [--broadphase name] [--output file]
+
+using namespace Lumos;
+using namespace Maths;
+
+namespace
+{
+	struct Scenario
+	{
+		const char* name;
+		void (*build)(entt::registry& registry, LumosPhysicsEngine& engine);
+	};
+
+	struct BroadphaseOption
+	{
+		const char* name;
+		Ref<Broadphase> (*create)();
+		u32 maxBodies;		//Scenarios with more bodies are skipped, brute force is quadratic
+	};
+
+	//Accumulated time of one step stage over a run
+	struct StageStats
+	{
+		double total = 0.0;
+		float  max = 0.0f;
+
+		void Add(float ms)
+		{
+			total += ms;
+			max = Maths::Max(max, ms);
+		}
+
+		nlohmann::json ToJson(u32 steps) const
+		{
+			return { { "total_ms", total }, { "mean_ms", steps > 0 ? total / steps : 0.0 }, { "max_ms", max } };
+		}
+	};
+
+	Ref<PhysicsObject3D> AddBody(entt::registry& registry, const Ref<CollisionShape>& shape, const Vector3& position, float invMass)
+	{
+		auto body = CreateRef<PhysicsObject3D>();
+		body->SetCollisionShape(shape);
+		body->SetPosition(position);
+
+		if (invMass > 0.0f)
+		{
+			body->SetInverseMass(invMass);
+			body->SetInverseInertia(shape->BuildInverseInertia(invMass));
+		}
+		else
+			body->SetIsStatic(true);
+
+		auto entity = registry.create();
+		registry.assign<Maths::Transform>(entity);
+		registry.assign<Physics3DComponent>(entity, body);
+		return body;
+	}
+
+	void AddFloor(entt::registry& registry, float halfSize)
+	{
+		AddBody(registry, CreateRef<CuboidCollisionShape>(Vector3(halfSize, 0.5f, halfSize)), Vector3(0.0f, -0.5f, 0.0f), 0.0f);
+	}
+
+	//Pyramid of resting unit boxes, 24 along the base
+	void BuildBoxPyramid(entt::registry& registry, LumosPhysicsEngine& engine)
+	{
+		AddFloor(registry, 30.0f);
+
+		const int baseWidth = 24;
+		auto cube = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+		for (int row = 0; row < baseWidth; row++)
+		{
+			const int count = baseWidth - row;
+			for (int i = 0; i < count; i++)
+			{
+				const float x = (float(i) - float(count - 1) * 0.5f) * 1.05f;
+				AddBody(registry, cube, Vector3(x, 0.5f + float(row) * 1.01f, 0.0f), 1.0f);
+			}
+		}
+	}
+
+	//10k spheres dropped in a loose grid onto a floor
+	void BuildSphereRain(entt::registry& registry, LumosPhysicsEngine& engine)
+	{
+		AddFloor(registry, 40.0f);
+
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+
+		auto sphere = CreateRef<SphereCollisionShape>(0.5f);
+		for (int y = 0; y < 16; y++)
+		{
+			for (int z = 0; z < 25; z++)
+			{
+				for (int x = 0; x < 25; x++)
+				{
+					const Vector3 position((float(x) - 12.0f) * 1.5f + jitter(rng), 2.0f + float(y) * 1.5f, (float(z) - 12.0f) * 1.5f + jitter(rng));
+					AddBody(registry, sphere, position, 1.0f)->SetLinearVelocity(Vector3(jitter(rng), 0.0f, jitter(rng)));
+				}
+			}
+		}
+	}
+
+	//Box ragdolls piled on top of each other. The head is welded to the torso, limbs hang from distance constraints.
+	void BuildRagdollPile(entt::registry& registry, LumosPhysicsEngine& engine)
+	{
+		AddFloor(registry, 20.0f);
+
+		auto torsoShape = CreateRef<CuboidCollisionShape>(Vector3(0.3f, 0.4f, 0.15f));
+		auto headShape = CreateRef<SphereCollisionShape>(0.2f);
+		auto limbShape = CreateRef<CuboidCollisionShape>(Vector3(0.1f, 0.35f, 0.1f));
+
+		for (int layer = 0; layer < 4; layer++)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				const Vector3 base((float(i % 4) - 1.5f) * 1.2f, 1.5f + float(layer) * 2.5f, (float(i / 4) - 1.5f) * 1.2f);
+
+				auto torso = AddBody(registry, torsoShape, base, 1.0f);
+				auto head = AddBody(registry, headShape, base + Vector3(0.0f, 0.6f, 0.0f), 2.0f);
+				engine.AddConstraint(new WeldConstraint(torso.get(), head.get()));
+
+				// Shoulders and hips, each limb hangs a short distance below its joint
+				const Vector3 joints[4] = { Vector3(-0.45f, 0.35f, 0.0f), Vector3(0.45f, 0.35f, 0.0f), Vector3(-0.15f, -0.45f, 0.0f), Vector3(0.15f, -0.45f, 0.0f) };
+				for (const Vector3& joint : joints)
+				{
+					auto limb = AddBody(registry, limbShape, base + joint - Vector3(0.0f, 0.4f, 0.0f), 2.0f);
+					engine.AddConstraint(new DistanceConstraint(torso.get(), limb.get(), base + joint, base + joint - Vector3(0.0f, 0.05f, 0.0f)));
+				}
+			}
+		}
+	}
+
+	//Few dynamic bodies falling through a large field of static pillars
+	void BuildStaticHeavy(entt::registry& registry, LumosPhysicsEngine& engine)
+	{
+		AddFloor(registry, 110.0f);
+
+		auto pillar = CreateRef<CuboidCollisionShape>(Vector3(0.4f, 1.0f, 0.4f));
+		for (int z = 0; z < 70; z++)
+		{
+			for (int x = 0; x < 70; x++)
+				AddBody(registry, pillar, Vector3((float(x) - 35.0f) * 3.0f, 1.0f, (float(z) - 35.0f) * 3.0f), 0.0f);
+		}
+
+		std::mt19937 rng(2);
+		std::uniform_real_distribution<float> spread(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> height(3.0f, 20.0f);
+
+		auto sphere = CreateRef<SphereCollisionShape>(0.5f);
+		for (int i = 0; i < 256; i++)
+			AddBody(registry, sphere, Vector3(spread(rng), height(rng), spread(rng)), 1.0f);
+	}
+
+	const Scenario s_Scenarios[] =
+	{
+		{ "BoxPyramid", BuildBoxPyramid },
+		{ "SphereRain", BuildSphereRain },
+		{ "RagdollPile", BuildRagdollPile },
+		{ "StaticHeavy", BuildStaticHeavy }
+	};
+
+	const BroadphaseOption s_Broadphases[] =
+	{
+		{ "BruteForce", []() -> Ref<Broadphase> { return CreateRef<BruteForceBroadphase>(); }, 6000 },
+		{ "SortAndSweep", []() -> Ref<Broadphase> { return CreateRef<SortAndSweepBroadphase>(); }, ~0u },
+		{ "Octree", []() -> Ref<Broadphase> { return CreateRef<Octree>(5, 3, CreateRef<SortAndSweepBroadphase>()); }, ~0u }
+	};
+
+	nlohmann::json RunScenario(const Scenario& scenario, const BroadphaseOption& broadphase, u32 steps)
+	{
+		entt::registry registry;
+		LumosPhysicsEngine engine;
+		engine.SetBroadphase(broadphase.create());
+
+		const TimeStamp setupStart = Timer::Now();
+		scenario.build(registry, engine);
+
+		const u32 bodyCount = static_cast<u32>(registry.view<Physics3DComponent>().size());
+		if (bodyCount > broadphase.maxBodies)
+		{
+			Debug::Log::Info("{0} / {1} : skipped, {2} bodies", scenario.name, broadphase.name, bodyCount);
+			return nullptr;
+		}
+
+		engine.ConnectRegistry(registry);
+		engine.Simulate(0);
+		const float setupMs = Timer::Duration(setupStart, Timer::Now(), 1000.0f);
+
+		StageStats broadphaseStats, narrowphaseStats, islandStats, solveStats, ccdStats, integrateStats, sleepStats, totalStats;
+		u64 collisionPairs = 0;
+		u64 islands = 0;
+
+		for (u32 i = 0; i < steps; i++)
+		{
+			engine.Simulate(1);
+
+			const PhysicsStepTimings& timings = engine.GetStepTimings();
+			broadphaseStats.Add(timings.broadphase);
+			narrowphaseStats.Add(timings.narrowphase);
+			islandStats.Add(timings.islands);
+			solveStats.Add(timings.solve);
+			ccdStats.Add(timings.ccd);
+			integrateStats.Add(timings.integrate);
+			sleepStats.Add(timings.sleep);
+			totalStats.Add(timings.total);
+
+			collisionPairs += engine.GetNumberCollisionPairs();
+			islands += engine.GetNumberIslands();
+		}
+
+		engine.DisconnectRegistry();
+
+		Debug::Log::Info("{0} / {1} : {2} bodies, {3:.3f} ms per step", scenario.name, broadphase.name, bodyCount, steps > 0 ? totalStats.total / steps : 0.0);
+
+		nlohmann::json result;
+		result["scenario"] = scenario.name;
+		result["broadphase"] = broadphase.name;
+		result["bodies"] = bodyCount;
+		result["constraints"] = engine.GetNumberConstraints();
+		result["steps"] = steps;
+		result["setup_ms"] = setupMs;
+		result["mean_collision_pairs"] = steps > 0 ? double(collisionPairs) / steps : 0.0;
+		result["mean_islands"] = steps > 0 ? double(islands) / steps : 0.0;
+		result["stages"]["broadphase"] = broadphaseStats.ToJson(steps);
+		result["stages"]["narrowphase"] = narrowphaseStats.ToJson(steps);
+		result["stages"]["islands"] = islandStats.ToJson(steps);
+		result["stages"]["solve"] = solveStats.ToJson(steps);
+		result["stages"]["ccd"] = ccdStats.ToJson(steps);
+		result["stages"]["integrate"] = integrateStats.ToJson(steps);
+		result["stages"]["sleep"] = sleepStats.ToJson(steps);
+		result["stages"]["total"] = totalStats.ToJson(steps);
+		return result;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	u32 steps = 120;
+	std::string scenarioFilter;
+	std::string broadphaseFilter;
+	std::string outputPath = "PhysicsBenchmark.json";
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--steps")
+			steps = static_cast<u32>(std::stoul(argv[i + 1]));
+		else if (arg == "--scenario")
+			scenarioFilter = argv[i + 1];
+		else if (arg == "--broadphase")
+			broadphaseFilter = argv[i + 1];
+		else if (arg == "--output")
+			outputPath = argv[i + 1];
+	}
+
+	Internal::CoreSystem::Init(false);
+
+	nlohmann::json results = nlohmann::json::array();
+	for (const Scenario& scenario : s_Scenarios)
+	{
+		if (!scenarioFilter.empty() && scenarioFilter != scenario.name)
+			continue;
+
+		for (const BroadphaseOption& broadphase : s_Broadphases)
+		{
+			if (!broadphaseFilter.empty() && broadphaseFilter != broadphase.name)
+				continue;
+
+			nlohmann::json result = RunScenario(scenario, broadphase, steps);
+			if (!result.is_null())
+				results.push_back(result);
+		}
+	}
+
+	nlohmann::json output;
+	output["steps"] = steps;
+	output["timestep"] = LumosPhysicsEngine().GetDeltaTime();
+	output["threads"] = System::JobSystem::GetThreadCount();
+	output["results"] = results;
+
+	std::ofstream file(outputPath);
+	file << output.dump(4) << std::endl;
+	const bool written = file.good();
+
+	if (written)
+		Debug::Log::Info("Wrote {0}", outputPath);
+	else
+		Debug::Log::Error("Failed to write {0}", outputPath);
+
+	Internal::CoreSystem::Shutdown();
+
+	return written ? 0 : 1;
+}
@@ -0,0 +1 @@
+LumosConsoleApp("Benchmarks")
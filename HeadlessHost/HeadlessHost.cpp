@@ -0,0 +1,338 @@
+#include <LumosEngine.h>
+#include "Graphics/RenderSnapshot.h"
+#include "Core/JobSystem.h"
+#include "Core/OS/Memory.h"
+#include "Core/OS/MemoryManager.h"
+
+#include <jsonhpp/json.hpp>
+#include <fstream>
+#include <random>
+
+#if defined(LUMOS_PLATFORM_WINDOWS)
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(LUMOS_PLATFORM_UNIX)
+#include <sys/resource.h>
+#endif
+
+//Runs a generated scene for a set number of frames through Application, with a HeadlessWindow and RenderAPI::NONE
+//so no window or GPU is needed and frame costs can be tracked on CI. Frames step at a fixed rate and capture the render
+//snapshot the renderers would record from. Prints the time each system took, the allocations made and the peak memory use.
+//
+//	HeadlessHost [--frames N] [--bodies N] [--rate updatesPerSecond] [--serial] [--output file]
+
+using namespace Lumos;
+using namespace Maths;
+
+namespace
+{
+	struct Options
+	{
+		u32 frames = 600;
+		u32 bodies = 2000;
+		float rate = 60.0f;
+		bool serial = false;
+		std::string outputPath = "HeadlessHost.json";
+	};
+
+	//Accumulated time of one part of the frame over a run
+	struct FrameStats
+	{
+		double total = 0.0;
+		float  max = 0.0f;
+
+		void Add(float ms)
+		{
+			total += ms;
+			max = Maths::Max(max, ms);
+		}
+
+		nlohmann::json ToJson(u32 frames) const
+		{
+			return { { "total_ms", total }, { "mean_ms", frames > 0 ? total / frames : 0.0 }, { "max_ms", max } };
+		}
+	};
+
+	i64 GetPeakResidentBytes()
+	{
+#if defined(LUMOS_PLATFORM_WINDOWS)
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return static_cast<i64>(counters.PeakWorkingSetSize);
+		return 0;
+#elif defined(LUMOS_PLATFORM_UNIX)
+		rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+#if defined(LUMOS_PLATFORM_MACOS)
+		return static_cast<i64>(usage.ru_maxrss);
+#else
+		return static_cast<i64>(usage.ru_maxrss) * 1024;
+#endif
+#else
+		return 0;
+#endif
+	}
+}
+
+//Bodies falling onto a floor in a loose grid, a lit hierarchy of spinning props around them.
+//Meshes only carry bounds, there is no device to upload vertices to.
+class HeadlessScene : public Scene
+{
+public:
+	explicit HeadlessScene(const String& name) : Scene(name)
+	{
+	}
+
+	void OnInit() override
+	{
+		Scene::OnInit();
+
+		m_Camera = CreateScope<FPSCamera>(-20.0f, -40.0f, Vector3(-60.0f, 40.0f, 60.0f), 60.0f, 0.1f, 1000.0f, 16.0f / 9.0f);
+		SetCamera(m_Camera.get());
+
+		GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetPaused(false);
+		GetSystemManager()->GetSystem<B2PhysicsEngine>()->SetPaused(false);
+
+		const TimeStamp start = Timer::Now();
+		BuildScene();
+		m_SetupTime = Timer::Duration(start, Timer::Now(), 1000.0f);
+	}
+
+	void OnCleanupScene() override
+	{
+		// Bodies are released before their engines
+		Scene::OnCleanupScene();
+
+		SetCamera(nullptr);
+		m_Camera.reset();
+	}
+
+	void OnUpdate(TimeStep* timeStep) override
+	{
+		const TimeStamp start = Timer::Now();
+
+		m_Registry.view<Graphics::Light, Transform>().each([&](auto entity, Graphics::Light& light, Transform& transform)
+		{
+			transform.SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(0.0f, timeStep->GetElapsedMillis() * 10.0f, 0.0f));
+		});
+
+		Scene::OnUpdate(timeStep);
+		m_UpdateTime = Timer::Duration(start, Timer::Now(), 1000.0f);
+	}
+
+	static u32 s_BodyCount;
+
+	float GetSetupTime() const { return m_SetupTime; }
+	float GetUpdateTime() const { return m_UpdateTime; }
+
+private:
+	void BuildScene()
+	{
+		Ref<Graphics::VertexArray> vertexArray;
+		Ref<Graphics::IndexBuffer> indexBuffer;
+		auto mesh = CreateRef<Graphics::Mesh>(vertexArray, indexBuffer, CreateRef<BoundingBox>(Vector3(-0.5f), Vector3(0.5f)));
+
+		auto floorBody = CreateRef<PhysicsObject3D>();
+		floorBody->SetCollisionShape(CreateRef<CuboidCollisionShape>(Vector3(100.0f, 0.5f, 100.0f)));
+		floorBody->SetPosition(Vector3(0.0f, -0.5f, 0.0f));
+		floorBody->SetIsStatic(true);
+
+		auto floor = m_Registry.create();
+		m_Registry.assign<Transform>(floor);
+		m_Registry.assign<Physics3DComponent>(floor, floorBody);
+		m_Registry.assign<MeshComponent>(floor, mesh);
+
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+
+		const u32 side = Maths::Max(1u, static_cast<u32>(std::sqrt(float(s_BodyCount) / 8.0f)));
+		auto cube = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+		auto sphere = CreateRef<SphereCollisionShape>(0.5f);
+		for (u32 i = 0; i < s_BodyCount; i++)
+		{
+			const u32 x = i % side;
+			const u32 z = (i / side) % side;
+			const u32 y = i / (side * side);
+
+			auto shape = i % 2 == 0 ? Ref<CollisionShape>(cube) : Ref<CollisionShape>(sphere);
+			auto body = CreateRef<PhysicsObject3D>();
+			body->SetCollisionShape(shape);
+			body->SetPosition(Vector3((float(x) - side * 0.5f) * 1.5f + jitter(rng), 2.0f + float(y) * 1.5f, (float(z) - side * 0.5f) * 1.5f + jitter(rng)));
+			body->SetInverseMass(1.0f);
+			body->SetInverseInertia(shape->BuildInverseInertia(1.0f));
+
+			auto entity = m_Registry.create();
+			m_Registry.assign<Transform>(entity);
+			m_Registry.assign<Physics3DComponent>(entity, body);
+			m_Registry.assign<MeshComponent>(entity, mesh);
+		}
+
+		// Rings of props, each parented to a spinning root
+		for (u32 ring = 0; ring < 16; ring++)
+		{
+			auto root = m_Registry.create();
+			m_Registry.assign<Transform>(root, Vector3(0.0f, 10.0f + float(ring), 0.0f));
+			m_Registry.assign<Graphics::Light>(root, Vector3(0.0f, -1.0f, 0.0f), Vector4(1.0f), 1.0f, Graphics::LightType::PointLight, Vector3(0.0f), 20.0f);
+
+			for (u32 i = 0; i < 64; i++)
+			{
+				const float angle = float(i) / 64.0f * 2.0f * Maths::M_PI;
+				auto prop = m_Registry.create();
+				m_Registry.assign<Transform>(prop, Vector3(std::cos(angle), 0.0f, std::sin(angle)) * (20.0f + float(ring)));
+				m_Registry.assign<Hierarchy>(prop, root);
+				m_Registry.assign<MeshComponent>(prop, mesh);
+			}
+		}
+	}
+
+	Scope<Camera> m_Camera;
+	float m_SetupTime = 0.0f;
+	float m_UpdateTime = 0.0f;
+};
+
+u32 HeadlessScene::s_BodyCount = 0;
+
+class HeadlessHost : public Application
+{
+public:
+	HeadlessHost(const WindowProperties& properties, const Options& options) : Application(properties), m_Options(options)
+	{
+	}
+
+	void Init() override
+	{
+		Application::Init();
+
+		GetSystemManager()->SetParallel(!m_Options.serial);
+		SetFrameStep(1.0f / m_Options.rate);
+
+		HeadlessScene::s_BodyCount = m_Options.bodies;
+		GetSceneManager()->EnqueueScene<HeadlessScene>("Headless");
+		GetSceneManager()->SwitchScene(0);
+		GetSceneManager()->ApplySceneSwitch();
+	}
+
+	//Runs the frames and writes the results, returns false if they couldn't be written
+	bool RunFrames()
+	{
+		auto scene = static_cast<HeadlessScene*>(GetSceneManager()->GetCurrentScene());
+		auto systems = GetSystemManager();
+
+		// The first frame builds the system schedule and the broadphase, keep it out of the totals
+		OnFrame();
+
+		const u32 systemCount = systems->GetSystemCount();
+		std::vector<FrameStats> systemStats(systemCount);
+		FrameStats sceneStats, frameStats;
+
+		Memory::SetCountAllocations(true);
+		const u64 allocationsStart = Memory::GetAllocationCount();
+		const u64 bytesStart = Memory::GetAllocatedBytes();
+		const u64 freesStart = Memory::GetFreeCount();
+
+		u32 frames = 0;
+		for (; frames < m_Options.frames; frames++)
+		{
+			const TimeStamp frameStart = Timer::Now();
+			const bool running = OnFrame();
+			frameStats.Add(Timer::Duration(frameStart, Timer::Now(), 1000.0f));
+
+			sceneStats.Add(scene->GetUpdateTime());
+			for (u32 i = 0; i < systemCount; i++)
+				systemStats[i].Add(systems->GetLastUpdateTime(i));
+
+			if (!running)
+			{
+				frames++;
+				break;
+			}
+		}
+
+		const u64 allocations = Memory::GetAllocationCount() - allocationsStart;
+		const u64 allocatedBytes = Memory::GetAllocatedBytes() - bytesStart;
+		const u64 frees = Memory::GetFreeCount() - freesStart;
+		Memory::SetCountAllocations(false);
+
+		const auto& snapshot = scene->GetRenderSnapshot();
+		const double frameCount = Maths::Max(frames, 1u);
+
+		Debug::Log::Info("{0} frames at {1} Hz, {2} entities, {3} threads", frames, m_Options.rate, scene->GetRegistry().alive(), System::JobSystem::GetThreadCount());
+		Debug::Log::Info("Frame : {0:.3f} ms mean, {1:.3f} ms max", frameStats.total / frameCount, frameStats.max);
+		Debug::Log::Info("Scene update : {0:.3f} ms mean, {1:.3f} ms max", sceneStats.total / frameCount, sceneStats.max);
+		for (u32 i = 0; i < systemCount; i++)
+			Debug::Log::Info("{0} : {1:.3f} ms mean, {2:.3f} ms max", systems->GetSystemAt(i)->GetName(), systemStats[i].total / frameCount, systemStats[i].max);
+		Debug::Log::Info("Render snapshot : {0} meshes, {1} lights", snapshot.GetMeshes().size(), snapshot.GetLights().size());
+		Debug::Log::Info("Allocations : {0:.1f} per frame, {1} per frame, {2:.1f} frees per frame", allocations / frameCount, MemoryManager::BytesToString(static_cast<i64>(allocatedBytes / frameCount)), frees / frameCount);
+		Debug::Log::Info("Peak memory : {0}", MemoryManager::BytesToString(GetPeakResidentBytes()));
+
+		nlohmann::json output;
+		output["frames"] = frames;
+		output["rate"] = m_Options.rate;
+		output["bodies"] = m_Options.bodies;
+		output["entities"] = scene->GetRegistry().alive();
+		output["threads"] = System::JobSystem::GetThreadCount();
+		output["parallel_systems"] = !m_Options.serial;
+		output["setup_ms"] = scene->GetSetupTime();
+		output["frame"] = frameStats.ToJson(frames);
+		output["scene_update"] = sceneStats.ToJson(frames);
+		for (u32 i = 0; i < systemCount; i++)
+			output["systems"][systems->GetSystemAt(i)->GetName()] = systemStats[i].ToJson(frames);
+		output["allocations"] = allocations;
+		output["allocated_bytes"] = allocatedBytes;
+		output["frees"] = frees;
+		output["peak_resident_bytes"] = GetPeakResidentBytes();
+
+		std::ofstream file(m_Options.outputPath);
+		file << output.dump(4) << std::endl;
+		const bool written = file.good();
+
+		if (written)
+			Debug::Log::Info("Wrote {0}", m_Options.outputPath);
+		else
+			Debug::Log::Error("Failed to write {0}", m_Options.outputPath);
+
+		return written;
+	}
+
+private:
+	Options m_Options;
+};
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--serial")
+			options.serial = true;
+		else if (i + 1 < argc)
+		{
+			if (arg == "--frames")
+				options.frames = static_cast<u32>(std::stoul(argv[++i]));
+			else if (arg == "--bodies")
+				options.bodies = static_cast<u32>(std::stoul(argv[++i]));
+			else if (arg == "--rate")
+				options.rate = Maths::Max(std::stof(argv[++i]), 1.0f);
+			else if (arg == "--output")
+				options.outputPath = argv[++i];
+		}
+	}
+
+	Internal::CoreSystem::Init(false);
+
+	WindowProperties properties(1280, 720, static_cast<int>(Graphics::RenderAPI::NONE), "HeadlessHost");
+	properties.VSync = false;
+
+	auto app = new HeadlessHost(properties, options);
+	app->Init();
+	const bool written = app->RunFrames();
+	app->Quit();
+	delete app;
+
+	Internal::CoreSystem::Shutdown();
+
+	return written ? 0 : 1;
+}
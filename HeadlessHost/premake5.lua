@@ -0,0 +1 @@
+LumosConsoleApp("HeadlessHost")
@@ -87,6 +87,9 @@ project "Lumos"
 			"src/Platform/GLFW/*.h",
 			"src/Platform/GLFW/*.cpp",
 
+			"src/Platform/Headless/*.h",
+			"src/Platform/Headless/*.cpp",
+
 			"src/Platform/OpenAL/*.h",
 			"src/Platform/OpenAL/*.cpp",
 
@@ -132,6 +135,9 @@ project "Lumos"
 			"src/Platform/GLFW/*.h",
 			"src/Platform/GLFW/*.cpp",
 
+			"src/Platform/Headless/*.h",
+			"src/Platform/Headless/*.cpp",
+
 			"src/Platform/OpenAL/*.h",
 			"src/Platform/OpenAL/*.cpp",
 
@@ -211,6 +217,9 @@ project "Lumos"
 			"src/Platform/iOS/*.h",
 			"src/Platform/iOS/*.cpp",
 
+			"src/Platform/Headless/*.h",
+			"src/Platform/Headless/*.cpp",
+
 			"src/Platform/OpenAL/*.h",
 			"src/Platform/OpenAL/*.cpp",
 
@@ -273,6 +282,9 @@ project "Lumos"
 			"src/Platform/GLFW/*.h",
 			"src/Platform/GLFW/*.cpp",
 
+			"src/Platform/Headless/*.h",
+			"src/Platform/Headless/*.cpp",
+
 			"src/Platform/OpenAL/*.h",
 			"src/Platform/OpenAL/*.cpp",
 
@@ -3,6 +3,8 @@
 
 #include "Scene.h"
 #include "SceneManager.h"
+#include "TransformInterpolator.h"
+#include "InputRecorder.h"
 #include "Engine.h"
 #include "Editor/Editor.h"
 
@@ -26,6 +28,7 @@
 #include "Audio/Sound.h"
 #include "Physics/B2PhysicsEngine/B2PhysicsEngine.h"
 #include "Physics/LumosPhysicsEngine/LumosPhysicsEngine.h"
+#include "Physics/LumosPhysicsEngine/CollisionDetection.h"
 
 #include <imgui/imgui.h>
 namespace Lumos
@@ -46,6 +49,9 @@ namespace Lumos
 		Engine::Instance();
 
 		m_Timer = CreateScope<Timer>();
+		m_FixedTimeStep = CreateScope<TimeStep>(0.0f);
+		m_TransformInterpolator = CreateScope<TransformInterpolator>();
+		m_InputRecorder = CreateScope<InputRecorder>();
 
 		const String root = ROOT_DIR;
 		
@@ -93,18 +99,22 @@ namespace Lumos
 
 		Graphics::GraphicsContext::GetContext()->Init();
 
+		//Without a render API only the scenes, systems and render snapshots run
+		if (Graphics::GraphicsContext::GetRenderAPI() != Graphics::RenderAPI::NONE)
+		{
 #ifdef  LUMOS_EDITOR
-		m_Editor->OnInit();
+			m_Editor->OnInit();
 #endif
 
-		Graphics::Renderer::Init(screenWidth, screenHeight);
+			Graphics::Renderer::Init(screenWidth, screenHeight);
 
-		//Graphics Loading on main thread
-		AssetsManager::InitializeMeshes();
-		m_RenderManager = CreateScope<Graphics::RenderManager>(screenWidth, screenHeight);
+			//Graphics Loading on main thread
+			AssetsManager::InitializeMeshes();
+			m_RenderManager = CreateScope<Graphics::RenderManager>(screenWidth, screenHeight);
 
-		m_ImGuiLayer = lmnew ImGuiLayer(false);
-		m_ImGuiLayer->OnAttach();
+			m_ImGuiLayer = lmnew ImGuiLayer(false);
+			m_ImGuiLayer->OnAttach();
+		}
 
 		m_LayerStack = lmnew LayerStack();
 
@@ -125,6 +135,8 @@ namespace Lumos
 
 	int Application::Quit(bool pause, const std::string &reason)
 	{
+		m_InputRecorder->StopRecording();
+
 		Engine::Release();
 		Input::Release();
 		AssetsManager::ReleaseResources();
@@ -133,6 +145,9 @@ namespace Lumos
 		m_RenderManager.reset();
 		m_SystemManager.reset();
 
+		// Shared by every physics engine, including those of simulated scenes
+		CollisionDetection::Release();
+
 		delete m_LayerStack;
 		delete m_ImGuiLayer;
 
@@ -169,11 +184,13 @@ namespace Lumos
 
             Profiler::Instance()->Update(now);
             Engine::GetTimeStep()->Update(now);
+			if (m_FrameStep > 0.0f)
+				Engine::GetTimeStep()->SetStep(m_FrameStep);
+			m_InputRecorder->BeginFrame(*Engine::GetTimeStep());
 
 			{
                 LUMOS_PROFILE_BLOCK("Application::Update");
 				OnUpdate(Engine::GetTimeStep());
-				m_Updates++;
 			}
 
 			if(!m_Minimized)
@@ -183,8 +200,15 @@ namespace Lumos
 				m_Frames++;
 			}
 
-			Input::GetInput()->ResetPressed();
+			// Input, events, streaming and scene switches below change the scene
+			System::JobSystem::Wait(m_SimulationJob);
+			m_SceneManager->UpdateLevelStreamers();
+
+			// Presses are kept until an update has run to see them
+			if (m_FixedUpdateRate <= 0.0f || m_FixedUpdatesThisFrame > 0)
+				Input::GetInput()->ResetPressed();
 			m_Window->OnUpdate();
+			m_InputRecorder->EndFrame(BIND_EVENT_FN(Application::OnEvent));
 
 			if (Input::GetInput()->GetKeyPressed(LUMOS_KEY_ESCAPE))
 				m_CurrentState = AppState::Closing;
@@ -217,7 +241,7 @@ namespace Lumos
 
 	void Application::OnRender()
 	{
-		if (m_LayerStack->GetCount() > 0)
+		if (m_ImGuiLayer && m_LayerStack->GetCount() > 0)
 		{
 			Graphics::Renderer::GetRenderer()->Begin();
 
@@ -245,28 +269,125 @@ namespace Lumos
 		if (Input::GetInput()->GetKeyPressed(InputCode::Key::F)) m_SceneManager->SwitchScene(sceneIdx);
 		if (Input::GetInput()->GetKeyPressed(InputCode::Key::V)) m_Window->ToggleVSync();
 
+		bool simulate = true;
 #ifdef LUMOS_EDITOR
-		if (Application::Instance()->GetEditorState() != EditorState::Paused && Application::Instance()->GetEditorState() != EditorState::Preview)
+		simulate = Application::Instance()->GetEditorState() != EditorState::Paused && Application::Instance()->GetEditorState() != EditorState::Preview;
 #endif
-		{
-			m_SceneManager->GetCurrentScene()->OnUpdate(Engine::GetTimeStep());
-			m_SystemManager->OnUpdate(Engine::GetTimeStep(),m_SceneManager->GetCurrentScene());
-		}
+
+		// Pipelined, this frame draws the state left by the last frame's update
+		if (simulate && !m_Pipelined)
+			Simulate(dt);
+
+		CaptureRenderSnapshot();
 
 		if (!m_Minimized)
 		{
 			m_LayerStack->OnUpdate(Engine::GetTimeStep(), m_SceneManager->GetCurrentScene());
-			m_ImGuiLayer->OnUpdate(Engine::GetTimeStep(), m_SceneManager->GetCurrentScene());
+			if (m_ImGuiLayer)
+				m_ImGuiLayer->OnUpdate(Engine::GetTimeStep(), m_SceneManager->GetCurrentScene());
 		}
+
+		// Runs while the main thread renders, OnFrame waits for it before polling the window
+		if (simulate && m_Pipelined)
+			System::JobSystem::ExecuteOnWorker(m_SimulationJob, [this, dt]() { Simulate(dt); });
+	}
+
+	void Application::Simulate(TimeStep* dt)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		if (m_FixedUpdateRate > 0.0f)
+			UpdateFixed(dt);
+		else
+			UpdateSimulation(dt);
+	}
+
+	void Application::CaptureRenderSnapshot()
+	{
+		LUMOS_PROFILE_FUNC;
+
+		auto scene = m_SceneManager->GetCurrentScene();
+		auto& registry = scene->GetRegistry();
+		if (m_FixedUpdateRate > 0.0f)
+			m_TransformInterpolator->Apply(registry, m_FixedUpdateAlpha);
+
+		scene->CaptureRenderSnapshot();
+
+		// The next update carries on from the simulated transforms
+		m_TransformInterpolator->Restore(registry);
+	}
+
+	void Application::UpdateSimulation(TimeStep* dt)
+	{
+		m_SceneManager->GetCurrentScene()->OnUpdate(dt);
+		m_SystemManager->OnUpdate(dt, m_SceneManager->GetCurrentScene());
+		m_SceneManager->UpdateSimulatedScenes(dt);
+		m_Updates++;
+	}
+
+	void Application::UpdateFixed(TimeStep* dt)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		const float step = 1.0f / m_FixedUpdateRate;
+		m_FixedAccumulator += dt->GetMillis();
+
+		u32 updates = static_cast<u32>(m_FixedAccumulator / step);
+		if (updates > MaxFixedUpdatesPerFrame)
+		{
+			updates = MaxFixedUpdatesPerFrame;
+			m_FixedAccumulator = step * updates;
+		}
+
+		auto& registry = m_SceneManager->GetCurrentScene()->GetRegistry();
+		for (u32 i = 0; i < updates; i++)
+		{
+			m_FixedTimeStep->Step(step);
+			UpdateSimulation(m_FixedTimeStep.get());
+			m_FixedAccumulator -= step;
+
+			// Only the last two updates are blended between
+			if (i + 2 >= updates)
+				m_TransformInterpolator->Capture(registry);
+		}
+
+		m_FixedUpdatesThisFrame = updates;
+		m_FixedUpdateAlpha = Maths::Clamp(m_FixedAccumulator / step, 0.0f, 1.0f);
+	}
+
+	void Application::SetFixedUpdateRate(float updatesPerSecond)
+	{
+		System::JobSystem::Wait(m_SimulationJob);
+
+		m_FixedUpdateRate = Maths::Max(updatesPerSecond, 0.0f);
+		m_FixedAccumulator = 0.0f;
+		m_FixedUpdateAlpha = 1.0f;
+		m_TransformInterpolator->Reset();
+	}
+
+	void Application::SetFrameStep(float step)
+	{
+		m_FrameStep = Maths::Max(step, 0.0f);
+	}
+
+	void Application::SetPipelined(bool pipelined)
+	{
+		System::JobSystem::Wait(m_SimulationJob);
+		m_Pipelined = pipelined;
 	}
 
 	void Application::OnEvent(Event& e)
 	{
+		// Live input is ignored while a recording replays
+		if (!m_InputRecorder->OnEvent(e))
+			return;
+
 		EventDispatcher dispatcher(e);
 		dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_FN(Application::OnWindowClose));
 		dispatcher.Dispatch<WindowResizeEvent>(BIND_EVENT_FN(Application::OnWindowResize));
 
-		m_ImGuiLayer->OnEvent(e);
+		if (m_ImGuiLayer)
+			m_ImGuiLayer->OnEvent(e);
 		if (e.Handled())
 			return;
 		m_LayerStack->OnEvent(e);
@@ -299,6 +420,9 @@ namespace Lumos
 
 	void Application::OnExitScene()
 	{
+		// The next scene's transforms have nothing to blend with
+		m_TransformInterpolator->Reset();
+
 		for (auto& layer : m_CurrentSceneLayers)
 		{
 			m_LayerStack->PopLayer(layer);
@@ -349,8 +473,11 @@ namespace Lumos
 		}
 		m_Minimized = false;
 
-		m_RenderManager->OnResize(width, height);
-		Graphics::Renderer::GetRenderer()->OnResize(width, height);
+		if (m_RenderManager)
+		{
+			m_RenderManager->OnResize(width, height);
+			Graphics::Renderer::GetRenderer()->OnResize(width, height);
+		}
 		return false;
 	}
 
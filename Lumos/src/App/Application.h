@@ -1,12 +1,16 @@
 #pragma once
 #include "lmpch.h"
 #include "ECS/SystemManager.h"
+#include "Core/JobSystem.h"
 
 #define LUMOS_EDITOR //temp
 
 namespace Lumos
 {
 	class Timer;
+	class TimeStep;
+	class TransformInterpolator;
+	class InputRecorder;
 	class Window;
 	struct WindowProperties;
     class SceneManager;
@@ -100,6 +104,29 @@ namespace Lumos
 		void SetEditorState(EditorState state)	{ m_EditorState = state; }
 		void SetActiveCamera(Camera* camera);
 
+		//Runs scene and system updates at a fixed rate instead of once a frame. Frames drawn between updates
+		//interpolate moving transforms between the last two, so rendering can run above or below the update rate.
+		//0 goes back to one update a frame.
+		void SetFixedUpdateRate(float updatesPerSecond);
+		float GetFixedUpdateRate() const { return m_FixedUpdateRate; }
+
+		//Fraction of a fixed update the last frame was drawn past the latest update
+		float GetFixedUpdateAlpha() const { return m_FixedUpdateAlpha; }
+
+		//Advances every frame by a set step instead of the clock, so headless runs step the same way on any machine.
+		//0 goes back to the clock.
+		void SetFrameStep(float step);
+		float GetFrameStep() const { return m_FrameStep; }
+
+		//Runs the scene and system updates for the next frame on the job system while the main thread renders the
+		//current one from the scene's render snapshot. Frames show the state one update behind.
+		//Updates must not create or release GPU resources while this is on.
+		void SetPipelined(bool pipelined);
+		bool IsPipelined() const { return m_Pipelined; }
+
+		//Records or replays the input and frame times of a session
+		InputRecorder* GetInputRecorder() const { return m_InputRecorder.get(); }
+
 		void SetSceneActive(bool active) { m_SceneActive = active; }
 		bool GetSceneActive() const { return m_SceneActive; }
 		Maths::Vector2 GetWindowSize() const;
@@ -116,6 +143,11 @@ namespace Lumos
 
 		void PushLayerInternal(Layer* layer, bool overlay, bool sceneAdded);
 
+		void UpdateSimulation(TimeStep* dt);
+		void UpdateFixed(TimeStep* dt);
+		void Simulate(TimeStep* dt);
+		void CaptureRenderSnapshot();
+
 		bool OnWindowClose(WindowCloseEvent& e);
         bool OnWindowResize(WindowResizeEvent& e);
 
@@ -125,6 +157,23 @@ namespace Lumos
 		u32 m_Frames;
 		u32 m_Updates;
 		float m_SecondTimer = 0.0f;
+
+		//Updates further behind than this are dropped, so a slow frame can't make every following frame slower
+		static constexpr u32 MaxFixedUpdatesPerFrame = 5;
+
+		float m_FixedUpdateRate = 0.0f;
+		float m_FixedAccumulator = 0.0f;
+		float m_FixedUpdateAlpha = 1.0f;
+		u32 m_FixedUpdatesThisFrame = 0;
+		float m_FrameStep = 0.0f;
+		Scope<TimeStep> m_FixedTimeStep;
+		Scope<TransformInterpolator> m_TransformInterpolator;
+
+		Scope<InputRecorder> m_InputRecorder;
+
+		bool m_Pipelined = false;
+		System::JobSystem::Context m_SimulationJob;
+
 		bool m_Minimized = false;
 		bool m_SceneActive = true;
 
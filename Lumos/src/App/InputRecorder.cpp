@@ -0,0 +1,334 @@
+#include "lmpch.h"
+#include "InputRecorder.h"
+#include "Core/OS/Input.h"
+#include "Events/ApplicationEvent.h"
+#include "Utilities/TimeStep.h"
+
+#include <fstream>
+
+namespace Lumos
+{
+	using namespace InputRecording;
+
+	namespace
+	{
+		template<typename T>
+		void Append(std::vector<u8>& data, const T& value)
+		{
+			const u8* bytes = reinterpret_cast<const u8*>(&value);
+			data.insert(data.end(), bytes, bytes + sizeof(T));
+		}
+
+		template<typename T>
+		bool Read(const std::vector<u8>& data, size_t& offset, T& out_value)
+		{
+			if (data.size() - offset < sizeof(T))
+				return false;
+
+			memcpy(&out_value, data.data() + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+		u32 FloatBits(float value)
+		{
+			u32 bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		float BitsFloat(u32 bits)
+		{
+			float value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+	}
+
+	bool InputRecorder::StartRecording(const String& path)
+	{
+		StopRecording();
+		StopReplay();
+
+		Input::GetInput()->Reset();
+		const Maths::Vector2& mousePosition = Input::GetInput()->GetMousePosition();
+
+		m_Header = { Magic, Version, 0, 0, { mousePosition.x, mousePosition.y } };
+		m_Path = path;
+		m_Data.clear();
+		m_FrameCount = 0;
+		m_EventCount = 0;
+		m_FrameStarted = false;
+		m_Recording = true;
+
+		Debug::Log::Info("[InputRecorder] - Recording to {0}", path);
+		return true;
+	}
+
+	bool InputRecorder::StopRecording()
+	{
+		if (!m_Recording)
+			return false;
+
+		m_Recording = false;
+		m_Header.frameCount = m_FrameCount;
+		m_Header.eventCount = m_EventCount;
+
+		std::ofstream file(m_Path, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			Debug::Log::Error("Failed to open {0} for writing", m_Path);
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&m_Header), sizeof(m_Header));
+		file.write(reinterpret_cast<const char*>(m_Data.data()), m_Data.size());
+		m_Data.clear();
+
+		if (!file.good())
+		{
+			Debug::Log::Error("Failed to write {0}", m_Path);
+			return false;
+		}
+
+		Debug::Log::Info("[InputRecorder] - Recorded {0} frames, {1} events to {2}", m_FrameCount, m_EventCount, m_Path);
+		return true;
+	}
+
+	bool InputRecorder::StartReplay(const String& path)
+	{
+		StopRecording();
+		StopReplay();
+
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			Debug::Log::Error("Failed to open {0}", path);
+			return false;
+		}
+
+		const std::streamoff size = file.tellg();
+		file.seekg(0);
+		if (size < std::streamoff(sizeof(FileHeader)))
+		{
+			Debug::Log::Error("{0} is not an input recording", path);
+			return false;
+		}
+
+		file.read(reinterpret_cast<char*>(&m_Header), sizeof(m_Header));
+		if (m_Header.magic != Magic || m_Header.version != Version)
+		{
+			Debug::Log::Error("{0} is not an input recording of version {1}", path, Version);
+			return false;
+		}
+
+		if (m_Header.frameCount == 0)
+		{
+			Debug::Log::Error("{0} has no frames", path);
+			return false;
+		}
+
+		m_Data.resize(static_cast<size_t>(size) - sizeof(FileHeader));
+		file.read(reinterpret_cast<char*>(m_Data.data()), m_Data.size());
+		if (!file)
+		{
+			Debug::Log::Error("Failed to read {0}", path);
+			m_Data.clear();
+			return false;
+		}
+
+		Input::GetInput()->Reset();
+		Input::GetInput()->StoreMousePosition(static_cast<int>(m_Header.mousePosition[0]), static_cast<int>(m_Header.mousePosition[1]));
+
+		m_Path = path;
+		m_FrameCount = m_Header.frameCount;
+		m_ReplayedFrames = 0;
+		m_ReadOffset = 0;
+		m_PendingEvents = 0;
+		m_FrameStarted = false;
+		m_Replaying = true;
+
+		Debug::Log::Info("[InputRecorder] - Replaying {0} frames from {1}", m_FrameCount, path);
+		return true;
+	}
+
+	void InputRecorder::StopReplay()
+	{
+		if (!m_Replaying)
+			return;
+
+		m_Replaying = false;
+		m_Data.clear();
+		m_PendingEvents = 0;
+
+		Debug::Log::Info("[InputRecorder] - Replayed {0} of {1} frames from {2}", m_ReplayedFrames, m_FrameCount, m_Path);
+	}
+
+	void InputRecorder::BeginFrame(TimeStep& timeStep)
+	{
+		if (m_Recording)
+		{
+			m_FrameOffset = m_Data.size();
+			Append(m_Data, FrameRecord{ timeStep.GetMillis(), 0 });
+			m_FrameCount++;
+			m_FrameStarted = true;
+		}
+		else if (m_Replaying)
+		{
+			FrameRecord frame;
+			if (!Read(m_Data, m_ReadOffset, frame) || (m_Data.size() - m_ReadOffset) / sizeof(EventRecord) < frame.eventCount)
+			{
+				Debug::Log::Error("[InputRecorder] - {0} ends before its last frame", m_Path);
+				StopReplay();
+				return;
+			}
+
+			timeStep.SetStep(frame.timeStep);
+			m_PendingEvents = frame.eventCount;
+			m_FrameStarted = true;
+		}
+	}
+
+	bool InputRecorder::OnEvent(Event& e)
+	{
+		if (m_Dispatching)
+			return true;
+
+		if (m_Replaying)
+			return !e.IsInCategory(EventCategoryInput);
+
+		// Events before the first frame starts belong to no frame
+		EventRecord record;
+		if (m_Recording && m_FrameStarted && Encode(e, record))
+		{
+			Append(m_Data, record);
+			m_EventCount++;
+
+			FrameRecord* frame = reinterpret_cast<FrameRecord*>(m_Data.data() + m_FrameOffset);
+			frame->eventCount++;
+		}
+
+		return true;
+	}
+
+	void InputRecorder::EndFrame(const std::function<void(Event&)>& handler)
+	{
+		if (!m_Replaying || !m_FrameStarted)
+			return;
+
+		m_Dispatching = true;
+		while (m_PendingEvents > 0 && m_Replaying)
+		{
+			EventRecord record;
+			Read(m_Data, m_ReadOffset, record);
+			m_PendingEvents--;
+
+			Decode(record, handler);
+		}
+		m_Dispatching = false;
+
+		if (m_Replaying && ++m_ReplayedFrames == m_FrameCount)
+			StopReplay();
+	}
+
+	bool InputRecorder::Encode(Event& e, EventRecord& record)
+	{
+		record.type = static_cast<u32>(e.GetEventType());
+		record.data[0] = 0;
+		record.data[1] = 0;
+
+		switch (e.GetEventType())
+		{
+		case EventType::KeyPressed:
+			record.data[0] = static_cast<u32>(static_cast<KeyPressedEvent&>(e).GetKeyCode());
+			record.data[1] = static_cast<u32>(static_cast<KeyPressedEvent&>(e).GetRepeatCount());
+			return true;
+		case EventType::KeyReleased:
+		case EventType::KeyTyped:
+			record.data[0] = static_cast<u32>(static_cast<KeyEvent&>(e).GetKeyCode());
+			return true;
+		case EventType::MouseButtonPressed:
+		case EventType::MouseButtonReleased:
+			record.data[0] = static_cast<u32>(static_cast<MouseButtonEvent&>(e).GetMouseButton());
+			return true;
+		case EventType::MouseMoved:
+			record.data[0] = FloatBits(static_cast<MouseMovedEvent&>(e).GetX());
+			record.data[1] = FloatBits(static_cast<MouseMovedEvent&>(e).GetY());
+			return true;
+		case EventType::MouseScrolled:
+			record.data[0] = FloatBits(static_cast<MouseScrolledEvent&>(e).GetXOffset());
+			record.data[1] = FloatBits(static_cast<MouseScrolledEvent&>(e).GetYOffset());
+			return true;
+		case EventType::MouseEntered:
+			record.data[0] = static_cast<MouseEnterEvent&>(e).GetEntered() ? 1 : 0;
+			return true;
+		case EventType::WindowClose:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void InputRecorder::Decode(const EventRecord& record, const std::function<void(Event&)>& handler)
+	{
+		switch (static_cast<EventType>(record.type))
+		{
+		case EventType::KeyPressed:
+		{
+			KeyPressedEvent e(static_cast<int>(record.data[0]), static_cast<int>(record.data[1]));
+			handler(e);
+			break;
+		}
+		case EventType::KeyReleased:
+		{
+			KeyReleasedEvent e(static_cast<int>(record.data[0]));
+			handler(e);
+			break;
+		}
+		case EventType::KeyTyped:
+		{
+			KeyTypedEvent e(static_cast<int>(record.data[0]));
+			handler(e);
+			break;
+		}
+		case EventType::MouseButtonPressed:
+		{
+			MouseButtonPressedEvent e(static_cast<int>(record.data[0]));
+			handler(e);
+			break;
+		}
+		case EventType::MouseButtonReleased:
+		{
+			MouseButtonReleasedEvent e(static_cast<int>(record.data[0]));
+			handler(e);
+			break;
+		}
+		case EventType::MouseMoved:
+		{
+			MouseMovedEvent e(BitsFloat(record.data[0]), BitsFloat(record.data[1]));
+			handler(e);
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			MouseScrolledEvent e(BitsFloat(record.data[0]), BitsFloat(record.data[1]));
+			handler(e);
+			break;
+		}
+		case EventType::MouseEntered:
+		{
+			MouseEnterEvent e(record.data[0] != 0);
+			handler(e);
+			break;
+		}
+		case EventType::WindowClose:
+		{
+			WindowCloseEvent e;
+			handler(e);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+}
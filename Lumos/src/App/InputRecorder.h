@@ -0,0 +1,91 @@
+#pragma once
+#include "lmpch.h"
+
+namespace Lumos
+{
+	class Event;
+	class TimeStep;
+
+	//Layout of an input recording. The header is followed by one FrameRecord per frame, each followed by the
+	//EventRecords of the events handled at the end of that frame.
+	namespace InputRecording
+	{
+		static const u32 Magic = 0x52494d4c;	// "LMIR"
+		static const u32 Version = 1;
+
+		struct FileHeader
+		{
+			u32 magic;
+			u32 version;
+			u32 frameCount;
+			u32 eventCount;
+			float mousePosition[2];	// Input state when recording started
+		};
+
+		struct FrameRecord
+		{
+			float timeStep;
+			u32 eventCount;
+		};
+
+		struct EventRecord
+		{
+			u32 type;				// EventType
+			u32 data[2];			// Key or button and repeat count, or the bits of two floats
+		};
+	}
+
+	//Records the input events and time step of every frame, or plays a recording back in place of live input and the
+	//clock, so a session can be profiled again on another build and every frame simulates the same way.
+	//Window events other than close aren't recorded, they follow the real window while replaying.
+	class LUMOS_EXPORT InputRecorder
+	{
+	public:
+		InputRecorder() = default;
+		~InputRecorder() = default;
+
+		//Input is reset when recording or replaying starts, so both start from the same state
+		bool StartRecording(const String& path);
+		bool StopRecording();
+		bool StartReplay(const String& path);
+		void StopReplay();
+
+		bool IsRecording() const { return m_Recording; }
+		bool IsReplaying() const { return m_Replaying; }
+
+		//Frames recorded so far, or in the replay
+		u32 GetFrameCount() const { return m_FrameCount; }
+		u32 GetReplayedFrameCount() const { return m_ReplayedFrames; }
+
+		//Call once the frame's time step is updated. Records its length, or replaces it with the recorded one.
+		void BeginFrame(TimeStep& timeStep);
+
+		//Records a live event. Returns false for live input while replaying, the recorded events replace it.
+		bool OnEvent(Event& e);
+
+		//Call once the window's events are handled. Sends the frame's recorded events to handler while replaying,
+		//and ends the replay after its last frame.
+		void EndFrame(const std::function<void(Event&)>& handler);
+
+	private:
+		static bool Encode(Event& e, InputRecording::EventRecord& record);
+		static void Decode(const InputRecording::EventRecord& record, const std::function<void(Event&)>& handler);
+
+		String m_Path;
+		std::vector<u8> m_Data;		// Frames and events, after the header
+		InputRecording::FileHeader m_Header;
+
+		bool m_Recording = false;
+		bool m_Replaying = false;
+		bool m_Dispatching = false;
+		bool m_FrameStarted = false;
+
+		u32 m_FrameCount = 0;
+		u32 m_EventCount = 0;
+		size_t m_FrameOffset = 0;	// Recording, the FrameRecord events are being added to
+
+		u32 m_ReplayedFrames = 0;
+		size_t m_ReadOffset = 0;	// Replaying, the next record to read
+		u32 m_PendingEvents = 0;	// Replaying, events of the current frame still to send
+	};
+}
@@ -0,0 +1,180 @@
+#include "lmpch.h"
+#include "LevelStreamer.h"
+#include "Core/VFS.h"
+#include "Core/Profiler.h"
+#include "Utilities/Timer.h"
+
+namespace Lumos
+{
+	LevelStreamer::~LevelStreamer()
+	{
+		// Decode jobs write to the chunks
+		System::JobSystem::Wait(m_DecodeJobs);
+	}
+
+	u32 LevelStreamer::AddChunk(const String& path, const Maths::BoundingBox& bounds)
+	{
+		auto chunk = CreateScope<Chunk>();
+		chunk->path = path;
+		chunk->bounds = bounds;
+		m_Chunks.push_back(std::move(chunk));
+		return static_cast<u32>(m_Chunks.size() - 1);
+	}
+
+	bool LevelStreamer::IsStreaming() const
+	{
+		for (auto& chunk : m_Chunks)
+		{
+			if (chunk->state != ChunkState::Unloaded && chunk->state != ChunkState::Loaded)
+				return true;
+		}
+
+		return false;
+	}
+
+	void LevelStreamer::Update(entt::registry& registry, const Maths::Vector3& cameraPosition)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		Timer timer;
+
+		for (auto& chunk : m_Chunks)
+		{
+			const float distance = chunk->bounds.DistanceToPoint(cameraPosition);
+
+			switch (chunk->state)
+			{
+			case ChunkState::Unloaded:
+				if (distance < m_LoadDistance && !chunk->failed)
+					StartLoad(*chunk);
+				break;
+
+			case ChunkState::Decoding:
+			{
+				const u32 result = chunk->decodeResult.load();
+				if (result == DecodePending)
+					break;
+
+				chunk->failed = result == DecodeFailed;
+				if (chunk->failed || distance > m_UnloadDistance)
+				{
+					chunk->loader = nullptr;
+					chunk->state = ChunkState::Unloaded;
+				}
+				else
+					chunk->state = ChunkState::Inserting;
+				break;
+			}
+
+			case ChunkState::Inserting:
+			case ChunkState::Loaded:
+				if (distance > m_UnloadDistance)
+					StartUnload(*chunk);
+				break;
+
+			case ChunkState::Unloading:
+				// Finishes unloading first, the next update loads it again if the camera came back
+				break;
+			}
+		}
+
+		// Chunks take what is left of the budget in order, so a chunk in progress finishes before the next starts
+		for (auto& chunk : m_Chunks)
+		{
+			const float budget = m_FrameBudget - timer.GetMS(1000.0f);
+			if (budget <= 0.0f)
+				break;
+
+			if (chunk->state == ChunkState::Inserting && Insert(registry, *chunk, budget))
+				chunk->state = ChunkState::Loaded;
+			else if (chunk->state == ChunkState::Unloading && Destroy(registry, *chunk, budget))
+				chunk->state = ChunkState::Unloaded;
+		}
+	}
+
+	void LevelStreamer::Clear(entt::registry& registry)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		System::JobSystem::Wait(m_DecodeJobs);
+
+		for (auto& chunk : m_Chunks)
+		{
+			if (chunk->state == ChunkState::Inserting || chunk->state == ChunkState::Loaded)
+				StartUnload(*chunk);
+
+			if (chunk->state == ChunkState::Unloading)
+				Destroy(registry, *chunk, 0.0f);
+
+			chunk->loader = nullptr;
+			chunk->state = ChunkState::Unloaded;
+			chunk->failed = false;
+		}
+	}
+
+	void LevelStreamer::StartLoad(Chunk& chunk)
+	{
+		// The VFS isn't thread safe, resolve the path before handing it to a job
+		String physicalPath;
+		if (!VFS::Get()->ResolvePhysicalPath(chunk.path, physicalPath))
+		{
+			Debug::Log::Error("Failed to find level chunk {0}", chunk.path);
+			chunk.failed = true;
+			return;
+		}
+
+		auto loader = CreateRef<SceneBinaryLoader>();
+		chunk.loader = loader;
+		chunk.decodeResult = DecodePending;
+		chunk.state = ChunkState::Decoding;
+
+		Chunk* target = &chunk;
+		System::JobSystem::Execute(m_DecodeJobs, [target, loader, physicalPath]()
+		{
+			target->decodeResult = loader->Decode(physicalPath) ? DecodeSucceeded : DecodeFailed;
+		});
+	}
+
+	void LevelStreamer::StartUnload(Chunk& chunk)
+	{
+		// Partially inserted chunks have all their entities already, just not every component
+		if (chunk.loader)
+			chunk.entities = chunk.loader->GetEntities();
+
+		chunk.loader = nullptr;
+		chunk.destroyed = 0;
+		chunk.state = ChunkState::Unloading;
+	}
+
+	bool LevelStreamer::Insert(entt::registry& registry, Chunk& chunk, float budget)
+	{
+		if (!chunk.loader->Insert(registry, m_LoadOptions, budget))
+			return false;
+
+		// Dropping the loader unmaps the file
+		chunk.entities = chunk.loader->GetEntities();
+		chunk.loader = nullptr;
+		return true;
+	}
+
+	bool LevelStreamer::Destroy(entt::registry& registry, Chunk& chunk, float budget)
+	{
+		Timer timer;
+
+		u32 destroyed = 0;
+		for (; chunk.destroyed < chunk.entities.size(); chunk.destroyed++)
+		{
+			if (budget > 0.0f && ++destroyed % 64 == 0 && timer.GetMS(1000.0f) > budget)
+				return false;
+
+			// Entities can be destroyed by the game while their chunk is loaded
+			const entt::entity entity = chunk.entities[chunk.destroyed];
+			if (registry.valid(entity))
+				registry.destroy(entity);
+		}
+
+		chunk.entities.clear();
+		chunk.destroyed = 0;
+		return true;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "lmpch.h"
+#include "App/SceneBinarySerialiser.h"
+#include "Core/JobSystem.h"
+#include "Maths/BoundingBox.h"
+
+#include <entt/entt.hpp>
+
+namespace Lumos
+{
+	//Splits a world into chunks, each saved as a binary scene, and keeps the chunks near the camera in the registry.
+	//Files are mapped and decoded on the job system. Their entities are added and destroyed on the main thread a slice
+	//at a time, so streaming never takes more than the frame budget.
+	class LUMOS_EXPORT LevelStreamer
+	{
+	public:
+		enum class ChunkState
+		{
+			Unloaded,
+			Decoding,	// Being read on a job thread
+			Inserting,	// Decoded, entities being added to the registry
+			Loaded,
+			Unloading	// Entities being destroyed
+		};
+
+		LevelStreamer() = default;
+		~LevelStreamer();
+
+		//path is the VFS path of a file written by SceneBinarySerialiser::Save, bounds is the world space region the
+		//chunk covers. Returns the chunk's index.
+		u32 AddChunk(const String& path, const Maths::BoundingBox& bounds);
+
+		//Chunks closer than loadDistance to the camera are loaded. Loaded chunks are only removed once they are
+		//further than unloadDistance, so chunks on the border don't load and unload every frame.
+		void SetDistances(float loadDistance, float unloadDistance) { m_LoadDistance = loadDistance; m_UnloadDistance = unloadDistance; }
+		void SetFrameBudget(float milliseconds) { m_FrameBudget = milliseconds; }
+		void SetLoadOptions(const SceneBinaryLoadOptions& options) { m_LoadOptions = options; }
+
+		//Starts loads and unloads for the camera position and spends up to the frame budget adding and destroying
+		//entities. Call once a frame from the main thread, outside of system updates.
+		void Update(entt::registry& registry, const Maths::Vector3& cameraPosition);
+
+		//Waits for loads in flight and destroys every chunk's entities
+		void Clear(entt::registry& registry);
+
+		u32 GetChunkCount() const { return static_cast<u32>(m_Chunks.size()); }
+		ChunkState GetChunkState(u32 index) const { return m_Chunks[index]->state; }
+		const std::vector<entt::entity>& GetChunkEntities(u32 index) const { return m_Chunks[index]->entities; }
+
+		//True while any chunk is being decoded, inserted or destroyed
+		bool IsStreaming() const;
+
+	private:
+		enum DecodeResult : u32
+		{
+			DecodePending,
+			DecodeSucceeded,
+			DecodeFailed
+		};
+
+		struct Chunk
+		{
+			String path;
+			Maths::BoundingBox bounds;
+			ChunkState state = ChunkState::Unloaded;
+			Ref<SceneBinaryLoader> loader;
+			std::atomic<u32> decodeResult{ DecodePending };	// Written by the decode job
+			bool failed = false;				// Not retried once its file failed to load
+			std::vector<entt::entity> entities;
+			size_t destroyed = 0;				// Entities destroyed so far while unloading
+		};
+
+		void StartLoad(Chunk& chunk);
+		void StartUnload(Chunk& chunk);
+
+		//Each returns false if the budget ran out before the chunk finished
+		bool Insert(entt::registry& registry, Chunk& chunk, float budget);
+		bool Destroy(entt::registry& registry, Chunk& chunk, float budget);
+
+		std::vector<Scope<Chunk>> m_Chunks;
+		System::JobSystem::Context m_DecodeJobs;
+		SceneBinaryLoadOptions m_LoadOptions;
+
+		float m_LoadDistance = 100.0f;
+		float m_UnloadDistance = 120.0f;
+		float m_FrameBudget = 2.0f;
+	};
+}
@@ -0,0 +1,136 @@
+#include "lmpch.h"
+#include "Prefab.h"
+#include "SceneGraph.h"
+#include "App/Application.h"
+#include "Core/Profiler.h"
+#include "Maths/Transform.h"
+#include "ECS/Component/Components.h"
+
+namespace Lumos
+{
+	Prefab::Prefab(entt::registry& registry, entt::entity root)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		// Breadth first, so instances can link every child to a parent created before it
+		std::vector<entt::entity> sources = { root };
+		m_Parents.push_back(InvalidIndex);
+		for (u32 i = 0; i < sources.size(); i++)
+		{
+			const Hierarchy* hierarchy = registry.try_get<Hierarchy>(sources[i]);
+			for (entt::entity child = hierarchy ? hierarchy->first() : entt::null; child != entt::null; child = registry.get<Hierarchy>(child).next())
+			{
+				sources.push_back(child);
+				m_Parents.push_back(i);
+			}
+		}
+
+		m_Nodes.resize(sources.size());
+		m_Prototypes.create(m_Nodes.begin(), m_Nodes.end());
+
+		for (u32 i = 0; i < sources.size(); i++)
+		{
+			Capture<NameComponent>(registry, sources[i], m_Nodes[i]);
+			Capture<Maths::Transform>(registry, sources[i], m_Nodes[i]);
+			Capture<MeshComponent>(registry, sources[i], m_Nodes[i]);
+			Capture<MaterialComponent>(registry, sources[i], m_Nodes[i]);
+
+			// Bodies are copied so the prefab keeps the state they had when captured
+			if (auto physics = registry.try_get<Physics3DComponent>(sources[i]))
+			{
+				auto body = CreateRef<PhysicsObject3D>(*physics->GetPhysicsObject());
+				m_Prototypes.assign<Physics3DComponent>(m_Nodes[i], body);
+			}
+		}
+
+		if (auto physics = m_Prototypes.try_get<Physics3DComponent>(m_Nodes[0]))
+			m_Origin = physics->GetPhysicsObject()->GetPosition();
+		else if (auto transform = m_Prototypes.try_get<Maths::Transform>(m_Nodes[0]))
+			m_Origin = transform->GetLocalPosition();
+		else
+			m_Origin = Maths::Vector3(0.0f);
+	}
+
+	template<typename T>
+	void Prefab::Capture(entt::registry& registry, entt::entity source, entt::entity node)
+	{
+		if (auto component = registry.try_get<T>(source))
+			m_Prototypes.assign<T>(node, *component);
+	}
+
+	template<typename T>
+	void Prefab::InstantiatePool(entt::registry& registry, const std::vector<entt::entity>& entities)
+	{
+		const size_t count = entities.size() / m_Nodes.size();
+		auto prototypes = m_Prototypes.view<T>();
+
+		registry.reserve<T>(registry.size<T>() + prototypes.size() * count);
+		for (auto node : prototypes)
+		{
+			// Prototype entities were created in node order
+			const size_t first = static_cast<size_t>(m_Prototypes.entity(node)) * count;
+			const T& prototype = prototypes.get(node);
+			for (size_t i = 0; i < count; i++)
+				registry.assign<T>(entities[first + i], prototype);
+		}
+	}
+
+	entt::entity Prefab::Instantiate(entt::registry& registry, const Maths::Vector3& position)
+	{
+		return Instantiate(registry, std::vector<Maths::Vector3>{ position })[0];
+	}
+
+	std::vector<entt::entity> Prefab::Instantiate(entt::registry& registry, const std::vector<Maths::Vector3>& positions)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		const size_t count = positions.size();
+		if (count == 0)
+			return {};
+
+		// Grouped by node, so entities[node * count + instance] and each prototype's copies are contiguous
+		std::vector<entt::entity> entities(m_Nodes.size() * count);
+		registry.create(entities.begin(), entities.end());
+
+		InstantiatePool<NameComponent>(registry, entities);
+		InstantiatePool<Maths::Transform>(registry, entities);
+		InstantiatePool<MeshComponent>(registry, entities);
+		InstantiatePool<MaterialComponent>(registry, entities);
+
+		// Children keep their local transforms, only the roots move
+		if (registry.has<Maths::Transform>(entities[0]))
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				auto& transform = registry.get<Maths::Transform>(entities[i]);
+				transform.SetLocalPosition(transform.GetLocalPosition() + positions[i] - m_Origin);
+			}
+		}
+
+		auto bodies = m_Prototypes.view<Physics3DComponent>();
+		registry.reserve<Physics3DComponent>(registry.size<Physics3DComponent>() + bodies.size() * count);
+		for (auto node : bodies)
+		{
+			const size_t first = static_cast<size_t>(m_Prototypes.entity(node)) * count;
+			const PhysicsObject3D& prototype = *bodies.get(node).GetPhysicsObject();
+			for (size_t i = 0; i < count; i++)
+			{
+				auto body = CreateRef<PhysicsObject3D>(prototype);
+				body->SetPosition(prototype.GetPosition() + positions[i] - m_Origin);
+				registry.assign<Physics3DComponent>(entities[first + i], body);
+			}
+		}
+
+		registry.reserve<Hierarchy>(registry.size<Hierarchy>() + m_Nodes.size() * count);
+		for (size_t node = 1; node < m_Nodes.size(); node++)
+		{
+			const size_t first = node * count;
+			const size_t parentFirst = m_Parents[node] * count;
+			for (size_t i = 0; i < count; i++)
+				registry.assign<Hierarchy>(entities[first + i], entities[parentFirst + i]);
+		}
+
+		entities.resize(count);
+		return entities;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "lmpch.h"
+#include "Maths/Maths.h"
+
+#include <entt/entt.hpp>
+
+namespace Lumos
+{
+	//An entity and its children captured once so copies can be spawned in bulk. Instances share the captured meshes,
+	//materials and collision shapes by reference, each instance gets its own transforms and physics bodies.
+	//Captures names, transforms, hierarchy, meshes, materials and 3D physics bodies.
+	class LUMOS_EXPORT Prefab
+	{
+	public:
+		//Later changes to the source entities don't affect the prefab
+		Prefab(entt::registry& registry, entt::entity root);
+		~Prefab() = default;
+
+		//Instances are placed relative to the root's position when captured, the root body's position if it has one
+		entt::entity Instantiate(entt::registry& registry, const Maths::Vector3& position);
+
+		//Creates one instance per position and returns their root entities. Entities are created in one batch and
+		//each component pool is filled in one pass.
+		std::vector<entt::entity> Instantiate(entt::registry& registry, const std::vector<Maths::Vector3>& positions);
+
+		u32 GetNodeCount() const { return static_cast<u32>(m_Nodes.size()); }
+		const Maths::Vector3& GetOrigin() const { return m_Origin; }
+
+	private:
+		template<typename T>
+		void Capture(entt::registry& registry, entt::entity source, entt::entity node);
+
+		template<typename T>
+		void InstantiatePool(entt::registry& registry, const std::vector<entt::entity>& entities);
+
+		static constexpr u32 InvalidIndex = ~0u;
+
+		entt::registry			  m_Prototypes;	//!< One entity per node holding the captured components
+		std::vector<entt::entity> m_Nodes;		//!< Prototype entities, parents before children and siblings in order
+		std::vector<u32>		  m_Parents;	//!< Index of the parent node, InvalidIndex for the root
+		Maths::Vector3			  m_Origin;
+	};
+}
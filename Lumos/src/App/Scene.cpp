@@ -7,11 +7,13 @@
 #include "Graphics/Layers/LayerStack.h"
 #include "Graphics/RenderManager.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 #include "Utilities/TimeStep.h"
 #include "Audio/AudioManager.h"
 #include "Physics/LumosPhysicsEngine/SortAndSweepBroadphase.h"
 #include "Physics/LumosPhysicsEngine/Octree.h"
 #include "Physics/LumosPhysicsEngine/LumosPhysicsEngine.h"
+#include "App/LevelStreamer.h"
 
 namespace Lumos
 {
@@ -23,6 +25,7 @@ namespace Lumos
 		m_ScreenWidth(0),
 		m_ScreenHeight(0)
 	{
+		m_RenderSnapshot = CreateScope<Graphics::RenderSnapshot>();
 	}
 
     Scene::~Scene()
@@ -72,17 +75,23 @@ namespace Lumos
 #ifdef LUMOS_RENDER_API_DIRECT3D
 		case DIRECT3D: RenderAPI = "Direct3D"; break;
 #endif
+
+		case Graphics::RenderAPI::NONE: RenderAPI = "None"; break;
 		}
 
-		std::stringstream Title;
-		Title << Platform << dash << RenderAPI << dash << Configuration << dash << m_SceneName << dash << Application::Instance()->GetWindow()->GetTitle();
+		if (!IsSimulated())
+		{
+			std::stringstream Title;
+			Title << Platform << dash << RenderAPI << dash << Configuration << dash << m_SceneName << dash << Application::Instance()->GetWindow()->GetTitle();
 
-		Application::Instance()->GetWindow()->SetWindowTitle(Title.str());
+			Application::Instance()->GetWindow()->SetWindowTitle(Title.str());
+		}
 
 		//Default physics setup
-		Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetDampingFactor(0.998f);
-		Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetIntegrationType(IntegrationType::RUNGE_KUTTA_4);
-		Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetBroadphase(Lumos::CreateRef<Octree>(5, 3, Lumos::CreateRef<SortAndSweepBroadphase>()));
+		auto physicsEngine = GetSystemManager()->GetSystem<LumosPhysicsEngine>();
+		physicsEngine->SetDampingFactor(0.998f);
+		physicsEngine->SetIntegrationType(IntegrationType::RUNGE_KUTTA_4);
+		physicsEngine->SetBroadphase(Lumos::CreateRef<Octree>(5, 3, Lumos::CreateRef<SortAndSweepBroadphase>()));
 
 		m_SceneBoundingRadius = 400.0f; //Default scene radius of 400m
 
@@ -91,14 +100,25 @@ namespace Lumos
 
 	void Scene::OnCleanupScene()
 	{
-		DeleteAllGameObjects();
+		// Release the physics bodies before their components are destroyed
+		GetSystemManager()->DetachScene(this);
+
+		if (m_LevelStreamer)
+			m_LevelStreamer->Clear(m_Registry);
 
-		Application::Instance()->GetRenderManager()->Reset();
+		DeleteAllGameObjects();
+		m_RenderSnapshot->Clear();
 
-		auto audioManager = AudioManager::Create();
-		if (audioManager)
+		if (!IsSimulated())
 		{
-			audioManager->ClearNodes();
+			if (Application::Instance()->GetRenderManager())
+				Application::Instance()->GetRenderManager()->Reset();
+
+			auto audioManager = AudioManager::Create();
+			if (audioManager)
+			{
+				audioManager->ClearNodes();
+			}
 		}
 
 		m_CurrentScene = false;
@@ -112,12 +132,16 @@ namespace Lumos
 		});
 	}
 
-	void Scene::OnUpdate(TimeStep* timeStep)
+	SystemManager* Scene::GetSystemManager() const
 	{
-		const Maths::Vector2 mousePos = Input::GetInput()->GetMousePosition();
+		return m_SystemManager ? m_SystemManager : Application::Instance()->GetSystemManager();
+	}
 
-		if (m_pCamera && Application::Instance()->GetSceneActive())
+	void Scene::OnUpdate(TimeStep* timeStep)
+	{
+		if (m_pCamera && !IsSimulated() && Application::Instance()->GetSceneActive())
 		{
+			const Maths::Vector2 mousePos = Input::GetInput()->GetMousePosition();
 			m_pCamera->HandleMouse(timeStep->GetMillis(), mousePos.x, mousePos.y);
 			m_pCamera->HandleKeyboard(timeStep->GetMillis());
 		}
@@ -125,6 +149,22 @@ namespace Lumos
 		m_SceneGraph.Update(m_Registry);
 	}
 
+	void Scene::SetLevelStreamer(const Ref<LevelStreamer>& streamer)
+	{
+		m_LevelStreamer = streamer;
+	}
+
+	void Scene::UpdateLevelStreamer()
+	{
+		if (m_LevelStreamer && m_pCamera)
+			m_LevelStreamer->Update(m_Registry, m_pCamera->GetPosition());
+	}
+
+	void Scene::CaptureRenderSnapshot()
+	{
+		m_RenderSnapshot->Capture(this);
+	}
+
 	void Scene::OnEvent(Event& e)
 	{
 		EventDispatcher dispatcher(e);
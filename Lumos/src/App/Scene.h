@@ -19,12 +19,15 @@ namespace Lumos
 	class Event;
 	class Layer;
 	class Camera;
+	class SystemManager;
+	class LevelStreamer;
 
 	namespace Graphics
 	{
 		struct Light;
 		class GBuffer;
 		class TextureCube;
+		class RenderSnapshot;
 	}
 
 	class LUMOS_EXPORT Scene : public Serialisable
@@ -85,6 +88,27 @@ namespace Lumos
         const entt::registry& GetRegistry() const { return m_Registry; }
         entt::registry& GetRegistry() { return m_Registry; }
 
+		// Systems that update this scene. Simulated scenes have their own set, so their physics state is separate
+		// from every other scene. Everything else uses the application's systems.
+		SystemManager* GetSystemManager() const;
+		void SetSystemManager(SystemManager* systemManager) { m_SystemManager = systemManager; }
+
+		// Simulated by the SceneManager alongside the current scene. Not rendered and doesn't read input.
+		bool IsSimulated() const { return m_SystemManager != nullptr; }
+
+		// Streams chunks of the world in and out around the camera once a frame
+		const Ref<LevelStreamer>& GetLevelStreamer() const { return m_LevelStreamer; }
+		void SetLevelStreamer(const Ref<LevelStreamer>& streamer);
+
+		// Called by the SceneManager from the main thread, between updates. The scene's update may run on a job
+		// system worker, which mustn't touch the VFS or add and destroy the streamed entities.
+		void UpdateLevelStreamer();
+
+		// What the renderers draw. Captured by the application after each update, renderers read nothing else
+		// from the scene while recording, so recording can overlap the next update.
+		void CaptureRenderSnapshot();
+		const Graphics::RenderSnapshot& GetRenderSnapshot() const { return *m_RenderSnapshot; }
+
 	protected:
 
 		String m_SceneName;
@@ -102,6 +126,9 @@ namespace Lumos
 		u32 m_ScreenHeight;
 
 		SceneGraph m_SceneGraph;
+		SystemManager* m_SystemManager = nullptr;
+		Ref<LevelStreamer> m_LevelStreamer;
+		Scope<Graphics::RenderSnapshot> m_RenderSnapshot;
 
     private:
 		NONCOPYABLE(Scene)
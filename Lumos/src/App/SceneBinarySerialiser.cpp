@@ -0,0 +1,646 @@
+#include "lmpch.h"
+#include "SceneBinarySerialiser.h"
+#include "SceneGraph.h"
+#include "Core/OS/FileSystem.h"
+#include "Core/Profiler.h"
+#include "Maths/Transform.h"
+#include "ECS/Component/Components.h"
+#include "Graphics/Material.h"
+#include "Utilities/AssetsManager.h"
+#include "Utilities/Timer.h"
+#include "Physics/LumosPhysicsEngine/CuboidCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/SphereCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/PyramidCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/CapsuleCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/HullCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/TriangleMeshCollisionShape.h"
+#include "Physics/B2PhysicsEngine/PhysicsObject2D.h"
+
+#include <Box2D/Box2D.h>
+#include <fstream>
+
+namespace Lumos
+{
+	using namespace SceneBinary;
+
+	namespace
+	{
+		template<typename Record>
+		void AddRecord(std::vector<u8>& section, const Record& record)
+		{
+			const size_t offset = section.size();
+			section.resize(offset + sizeof(Record));
+			memcpy(section.data() + offset, &record, sizeof(Record));
+		}
+
+		void Copy(float* out, const Maths::Vector3& v) { out[0] = v.x; out[1] = v.y; out[2] = v.z; }
+		void Copy(float* out, const Maths::Quaternion& q) { out[0] = q.w; out[1] = q.x; out[2] = q.y; out[3] = q.z; }
+
+		Maths::Vector3 ToVector3(const float* v) { return Maths::Vector3(v); }
+		Maths::Quaternion ToQuaternion(const float* q) { return Maths::Quaternion(q[0], q[1], q[2], q[3]); }
+
+		//Builds the sections of one file, strings are shared between the asset sections
+		struct Writer
+		{
+			std::vector<u8> sections[SectionCount];
+			std::unordered_map<String, u32> strings;
+
+			u32 AddString(const String& string)
+			{
+				auto it = strings.find(string);
+				if (it != strings.end())
+					return it->second;
+
+				std::vector<u8>& section = sections[SectionStrings];
+				const u32 offset = static_cast<u32>(section.size());
+				section.insert(section.end(), string.begin(), string.end());
+				section.push_back(0);
+				strings[string] = offset;
+				return offset;
+			}
+		};
+
+		u32 AddShape(Writer& writer, std::unordered_map<const CollisionShape*, u32>& shapes, const CollisionShape* shape)
+		{
+			if (!shape)
+				return ~0u;
+
+			auto it = shapes.find(shape);
+			if (it != shapes.end())
+				return it->second;
+
+			ShapeRecord record = {};
+			record.type = shape->GetType();
+
+			std::vector<u8>& points = writer.sections[SectionShapePoints];
+			record.firstPoint = static_cast<u32>(points.size() / sizeof(ShapePointRecord));
+
+			switch (shape->GetType())
+			{
+			case CollisionCuboid:
+			{
+				auto cuboid = static_cast<const CuboidCollisionShape*>(shape);
+				Copy(record.size, Maths::Vector3(cuboid->GetHalfWidth(), cuboid->GetHalfHeight(), cuboid->GetHalfDepth()));
+				break;
+			}
+			case CollisionPyramid:
+			{
+				auto pyramid = static_cast<const PyramidCollisionShape*>(shape);
+				Copy(record.size, Maths::Vector3(pyramid->GetHalfWidth(), pyramid->GetHalfHeight(), pyramid->GetHalfDepth()));
+				break;
+			}
+			case CollisionSphere:
+				record.size[0] = static_cast<const SphereCollisionShape*>(shape)->GetRadius();
+				break;
+			case CollisionCapsule:
+				record.size[0] = static_cast<const CapsuleCollisionShape*>(shape)->GetRadius();
+				record.size[1] = static_cast<const CapsuleCollisionShape*>(shape)->GetHeight();
+				break;
+			case CollisionHull:
+			{
+				for (const Maths::Vector3& vertex : static_cast<const HullCollisionShape*>(shape)->GetVertices())
+				{
+					ShapePointRecord point;
+					Copy(point.position, vertex);
+					AddRecord(points, point);
+				}
+				break;
+			}
+			case CollisionTriangleMesh:
+			{
+				// Saved as a triangle soup, the tree is rebuilt on load
+				auto mesh = static_cast<const TriangleMeshCollisionShape*>(shape);
+				for (u32 i = 0; i < mesh->GetNumTriangles(); i++)
+				{
+					Maths::Vector3 vertices[3];
+					mesh->GetTriangle(i, vertices);
+					for (const Maths::Vector3& vertex : vertices)
+					{
+						ShapePointRecord point;
+						Copy(point.position, vertex);
+						AddRecord(points, point);
+					}
+				}
+				break;
+			}
+			default:
+				break;
+			}
+
+			record.pointCount = static_cast<u32>(points.size() / sizeof(ShapePointRecord)) - record.firstPoint;
+
+			const u32 index = static_cast<u32>(writer.sections[SectionShapes].size() / sizeof(ShapeRecord));
+			AddRecord(writer.sections[SectionShapes], record);
+			shapes[shape] = index;
+			return index;
+		}
+
+		Ref<CollisionShape> CreateShape(const ShapeRecord& record, const ShapePointRecord* points)
+		{
+			std::vector<Maths::Vector3> vertices(record.pointCount);
+			for (u32 i = 0; i < record.pointCount; i++)
+				vertices[i] = ToVector3(points[record.firstPoint + i].position);
+
+			switch (record.type)
+			{
+			case CollisionCuboid:		return CreateRef<CuboidCollisionShape>(ToVector3(record.size));
+			case CollisionPyramid:		return CreateRef<PyramidCollisionShape>(ToVector3(record.size));
+			case CollisionSphere:		return CreateRef<SphereCollisionShape>(record.size[0]);
+			case CollisionCapsule:		return CreateRef<CapsuleCollisionShape>(record.size[0], record.size[1]);
+			case CollisionHull:			return CreateRef<HullCollisionShape>(vertices, Maths::Max(record.pointCount, HullCollisionShape::DefaultMaxVertices));
+			case CollisionTriangleMesh:
+			{
+				std::vector<u32> indices(record.pointCount);
+				for (u32 i = 0; i < record.pointCount; i++)
+					indices[i] = i;
+				return CreateRef<TriangleMeshCollisionShape>(vertices, indices);
+			}
+			default:
+				return nullptr;
+			}
+		}
+
+		//Typed views of the sections of a mapped file
+		class Reader
+		{
+		public:
+			Reader(const u8* data, i64 size) : m_Data(data), m_Size(size) {}
+
+			bool ReadHeader()
+			{
+				if (m_Size < static_cast<i64>(sizeof(FileHeader)))
+					return false;
+
+				m_Header = reinterpret_cast<const FileHeader*>(m_Data);
+				if (m_Header->magic != Magic)
+					return false;
+
+				if (m_Header->version != Version)
+				{
+					Debug::Log::Error("Unsupported binary scene version {0}, expected {1}", m_Header->version, Version);
+					return false;
+				}
+
+				const u64 tableEnd = sizeof(FileHeader) + u64(m_Header->sectionCount) * sizeof(SectionHeader);
+				if (tableEnd > u64(m_Size))
+					return false;
+
+				m_Sections = reinterpret_cast<const SectionHeader*>(m_Data + sizeof(FileHeader));
+				return true;
+			}
+
+			u32 GetEntityCount() const { return m_Header->entityCount; }
+
+			//Null if the section is missing or doesn't fit in the file. Sections of unknown types are ignored.
+			template<typename Record>
+			const Record* Get(SectionType type, u32& out_count) const
+			{
+				out_count = 0;
+				for (u32 i = 0; i < m_Header->sectionCount; i++)
+				{
+					const SectionHeader& section = m_Sections[i];
+					if (section.type != type)
+						continue;
+
+					// Written so a huge offset or count can't wrap around past the check
+					if (section.offset % alignof(u64) != 0 || section.offset > u64(m_Size) || section.count > (u64(m_Size) - section.offset) / sizeof(Record))
+					{
+						Debug::Log::Error("Binary scene section {0} is out of bounds", type);
+						return nullptr;
+					}
+
+					out_count = section.count;
+					return reinterpret_cast<const Record*>(m_Data + section.offset);
+				}
+
+				return nullptr;
+			}
+
+		private:
+			const u8* m_Data;
+			i64 m_Size;
+			const FileHeader* m_Header = nullptr;
+			const SectionHeader* m_Sections = nullptr;
+		};
+	}
+
+	bool SceneBinarySerialiser::Save(entt::registry& registry, const String& path)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		Writer writer;
+
+		// In id order, so loading into an empty registry gives the entities back their ids
+		std::vector<entt::entity> entities;
+		entities.reserve(registry.alive());
+		registry.each([&](entt::entity entity) { entities.push_back(entity); });
+		std::sort(entities.begin(), entities.end());
+
+		std::unordered_map<entt::entity, u32> entityIndices;
+		entityIndices.reserve(entities.size());
+		for (u32 i = 0; i < entities.size(); i++)
+			entityIndices[entities[i]] = i;
+
+		registry.view<Maths::Transform>().each([&](entt::entity entity, Maths::Transform& transform)
+		{
+			TransformRecord record;
+			record.entity = entityIndices[entity];
+			Copy(record.position, transform.GetLocalPosition());
+			Copy(record.orientation, transform.GetLocalOrientation());
+			Copy(record.scale, transform.GetLocalScale());
+			AddRecord(writer.sections[SectionTransforms], record);
+		});
+
+		// Walk down from the roots so loading appends every child to its parent in the original order
+		std::vector<entt::entity> hierarchyOrder;
+		registry.view<Hierarchy>().each([&](entt::entity entity, Hierarchy& hierarchy)
+		{
+			if (hierarchy.parent() == entt::null)
+				hierarchyOrder.push_back(entity);
+		});
+
+		for (size_t i = 0; i < hierarchyOrder.size(); i++)
+		{
+			const Hierarchy& hierarchy = registry.get<Hierarchy>(hierarchyOrder[i]);
+			for (entt::entity child = hierarchy.first(); child != entt::null; child = registry.get<Hierarchy>(child).next())
+			{
+				hierarchyOrder.push_back(child);
+
+				HierarchyRecord record;
+				record.entity = entityIndices[child];
+				record.parent = entityIndices[hierarchyOrder[i]];
+				AddRecord(writer.sections[SectionHierarchies], record);
+			}
+		}
+
+		std::unordered_map<const CollisionShape*, u32> shapes;
+		registry.view<Physics3DComponent>().each([&](entt::entity entity, Physics3DComponent& component)
+		{
+			const PhysicsObject3D* body = component.GetPhysicsObject().get();
+			if (!body)
+				return;
+
+			Body3DRecord record;
+			record.entity = entityIndices[entity];
+			record.shape = AddShape(writer, shapes, body->GetCollisionShape().get());
+			record.flags = (body->GetIsStatic() ? u32(BodyStatic) : 0u) | (body->GetIsAtRest() ? u32(BodyAtRest) : 0u) | (body->GetIsBullet() ? u32(BodyBullet) : 0u);
+			Copy(record.position, body->GetPosition());
+			Copy(record.orientation, body->GetOrientation());
+			Copy(record.linearVelocity, body->GetLinearVelocity());
+			Copy(record.angularVelocity, body->GetAngularVelocity());
+			Copy(record.force, body->GetForce());
+			Copy(record.torque, body->GetTorque());
+			record.inverseMass = body->GetInverseMass();
+			memcpy(record.inverseInertia, body->GetInverseInertia().Data(), sizeof(record.inverseInertia));
+			record.elasticity = body->GetElasticity();
+			record.friction = body->GetFriction();
+			AddRecord(writer.sections[SectionBodies3D], record);
+		});
+
+		registry.view<Physics2DComponent>().each([&](entt::entity entity, Physics2DComponent& component)
+		{
+			auto body = component.GetPhysicsObject();
+			const b2Body* b2body = body ? body->GetB2Body() : nullptr;
+			if (!b2body)
+				return;
+
+			Body2DRecord record = {};
+			record.entity = entityIndices[entity];
+			record.flags = (b2body->GetType() == b2_staticBody ? u32(BodyStatic) : 0u) | (b2body->IsAwake() ? 0u : u32(BodyAtRest));
+			record.position[0] = b2body->GetPosition().x;
+			record.position[1] = b2body->GetPosition().y;
+			record.angle = b2body->GetAngle();
+			record.linearVelocity[0] = b2body->GetLinearVelocity().x;
+			record.linearVelocity[1] = b2body->GetLinearVelocity().y;
+			record.angularVelocity = b2body->GetAngularVelocity();
+
+			// Bodies are built from a single circle or box fixture
+			const b2Shape* shape = b2body->GetFixtureList() ? b2body->GetFixtureList()->GetShape() : nullptr;
+			if (shape && shape->GetType() == b2Shape::e_circle)
+			{
+				record.shape = static_cast<u32>(Shape::Circle);
+				record.scale[0] = record.scale[1] = shape->m_radius;
+			}
+			else if (shape && shape->GetType() == b2Shape::e_polygon)
+			{
+				auto polygon = static_cast<const b2PolygonShape*>(shape);
+				record.shape = static_cast<u32>(Shape::Square);
+				for (int i = 0; i < polygon->m_count; i++)
+				{
+					record.scale[0] = Maths::Max(record.scale[0], fabsf(polygon->m_vertices[i].x));
+					record.scale[1] = Maths::Max(record.scale[1], fabsf(polygon->m_vertices[i].y));
+				}
+			}
+
+			AddRecord(writer.sections[SectionBodies2D], record);
+		});
+
+		if (AssetsManager::DefaultModels())
+		{
+			std::unordered_map<const Graphics::Mesh*, String> meshNames;
+			registry.view<MeshComponent>().each([&](entt::entity entity, MeshComponent& component)
+			{
+				auto it = meshNames.find(component.GetMesh());
+				if (it == meshNames.end())
+					it = meshNames.emplace(component.GetMesh(), AssetsManager::DefaultModels()->GetName(component.GetMesh())).first;
+
+				// Meshes that weren't registered can't be found again
+				if (it->second.empty())
+					return;
+
+				AssetRecord record;
+				record.entity = entityIndices[entity];
+				record.name = writer.AddString(it->second);
+				AddRecord(writer.sections[SectionMeshes], record);
+			});
+		}
+
+		registry.view<MaterialComponent>().each([&](entt::entity entity, MaterialComponent& component)
+		{
+			if (!component.GetMaterial() || component.GetMaterial()->GetName().empty())
+				return;
+
+			AssetRecord record;
+			record.entity = entityIndices[entity];
+			record.name = writer.AddString(component.GetMaterial()->GetName());
+			AddRecord(writer.sections[SectionMaterials], record);
+		});
+
+		const u32 recordSizes[] = { 1, sizeof(TransformRecord), sizeof(HierarchyRecord), sizeof(ShapeRecord), sizeof(ShapePointRecord),
+			sizeof(Body3DRecord), sizeof(Body2DRecord), sizeof(AssetRecord), sizeof(AssetRecord) };
+		const u32 sectionCount = SectionCount;
+
+		FileHeader header;
+		header.magic = Magic;
+		header.version = Version;
+		header.entityCount = static_cast<u32>(entityIndices.size());
+		header.sectionCount = sectionCount;
+
+		auto align = [](u64 offset) { return (offset + 7) & ~u64(7); };
+
+		SectionHeader sectionHeaders[sectionCount];
+		u64 offset = align(sizeof(FileHeader) + sizeof(sectionHeaders));
+		for (u32 i = 0; i < sectionCount; i++)
+		{
+			sectionHeaders[i].type = i;
+			sectionHeaders[i].count = static_cast<u32>(writer.sections[i].size() / recordSizes[i]);
+			sectionHeaders[i].offset = offset;
+			offset = align(offset + writer.sections[i].size());
+		}
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			Debug::Log::Error("Failed to open {0} for writing", path);
+			return false;
+		}
+
+		const char padding[8] = {};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(sectionHeaders), sizeof(sectionHeaders));
+		u64 written = sizeof(header) + sizeof(sectionHeaders);
+		for (u32 i = 0; i < sectionCount; i++)
+		{
+			file.write(padding, sectionHeaders[i].offset - written);
+			file.write(reinterpret_cast<const char*>(writer.sections[i].data()), writer.sections[i].size());
+			written = sectionHeaders[i].offset + writer.sections[i].size();
+		}
+
+		return file.good();
+	}
+
+	bool SceneBinarySerialiser::Load(entt::registry& registry, const String& path, const SceneBinaryLoadOptions& options)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		SceneBinaryLoader loader;
+		if (!loader.Decode(path))
+			return false;
+
+		loader.Insert(registry, options);
+		return true;
+	}
+
+	SceneBinaryLoader::SceneBinaryLoader() = default;
+
+	SceneBinaryLoader::~SceneBinaryLoader()
+	{
+		if (m_Data)
+			FileSystem::UnmapFile(m_Data, m_Size);
+	}
+
+	bool SceneBinaryLoader::Decode(const String& path)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		m_Data = FileSystem::MapFile(path, m_Size);
+		if (!m_Data)
+		{
+			Debug::Log::Error("Failed to map binary scene {0}", path);
+			return false;
+		}
+
+		// Fault the pages in here, so a job thread decoding the file takes the reads rather than the thread inserting it
+		volatile u8 touched = 0;
+		for (i64 offset = 0; offset < m_Size; offset += 4096)
+			touched += m_Data[offset];
+
+		Reader reader(m_Data, m_Size);
+		if (!reader.ReadHeader())
+		{
+			Debug::Log::Error("{0} is not a binary scene", path);
+			return false;
+		}
+
+		// Entities cost nothing in the file, but a scene with more of them than it has bytes is a corrupt header
+		m_EntityCount = reader.GetEntityCount();
+		if (u64(m_EntityCount) > u64(m_Size))
+		{
+			Debug::Log::Error("{0} has an invalid entity count {1}", path, m_EntityCount);
+			return false;
+		}
+
+		m_Records[SectionStrings] = reader.Get<char>(SectionStrings, m_Counts[SectionStrings]);
+		m_Records[SectionTransforms] = reader.Get<TransformRecord>(SectionTransforms, m_Counts[SectionTransforms]);
+		m_Records[SectionHierarchies] = reader.Get<HierarchyRecord>(SectionHierarchies, m_Counts[SectionHierarchies]);
+		m_Records[SectionBodies3D] = reader.Get<Body3DRecord>(SectionBodies3D, m_Counts[SectionBodies3D]);
+		m_Records[SectionBodies2D] = reader.Get<Body2DRecord>(SectionBodies2D, m_Counts[SectionBodies2D]);
+		m_Records[SectionMeshes] = reader.Get<AssetRecord>(SectionMeshes, m_Counts[SectionMeshes]);
+		m_Records[SectionMaterials] = reader.Get<AssetRecord>(SectionMaterials, m_Counts[SectionMaterials]);
+
+		// Shapes are the only part worth building ahead, the rest is read straight from the mapped records
+		u32 shapeCount, pointCount;
+		const ShapeRecord* shapeRecords = reader.Get<ShapeRecord>(SectionShapes, shapeCount);
+		const ShapePointRecord* pointRecords = reader.Get<ShapePointRecord>(SectionShapePoints, pointCount);
+
+		m_Shapes.resize(shapeCount);
+		for (u32 i = 0; i < shapeCount; i++)
+		{
+			if (u64(shapeRecords[i].firstPoint) + shapeRecords[i].pointCount <= pointCount)
+				m_Shapes[i] = CreateShape(shapeRecords[i], pointRecords);
+		}
+
+		return true;
+	}
+
+	bool SceneBinaryLoader::Insert(entt::registry& registry, const SceneBinaryLoadOptions& options, float budgetMs)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		Timer timer;
+
+		if (m_Entities.size() != m_EntityCount)
+		{
+			m_Entities.resize(m_EntityCount);
+			registry.create(m_Entities.begin(), m_Entities.end());
+		}
+
+		auto meshes = options.meshes;
+		if (!meshes && AssetsManager::DefaultModels())
+			meshes = [](const String& meshName) { return AssetsManager::DefaultModels()->Get(meshName); };
+
+		u32 inserted = 0;
+		for (; m_Section < SectionCount; m_Section++, m_Next = 0)
+		{
+			for (; m_Next < m_Counts[m_Section]; m_Next++)
+			{
+				// Reading the clock costs more than adding a component
+				if (budgetMs > 0.0f && ++inserted % 64 == 0 && timer.GetMS(1000.0f) > budgetMs)
+					return false;
+
+				// Entities that already have the component are skipped, so a record repeated in the file keeps the first
+				switch (m_Section)
+				{
+				case SectionTransforms:	 InsertTransform(registry, m_Next); break;
+				case SectionHierarchies: InsertHierarchy(registry, m_Next); break;
+				case SectionBodies3D:	 InsertBody3D(registry, m_Next); break;
+				case SectionBodies2D:	 InsertBody2D(registry, options, m_Next); break;
+				case SectionMeshes:		 InsertMesh(registry, meshes, m_Next); break;
+				case SectionMaterials:	 InsertMaterial(registry, options.materials, m_Next); break;
+				default:
+					// Strings, shapes and points aren't inserted
+					m_Next = m_Counts[m_Section];
+					break;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	entt::entity SceneBinaryLoader::GetEntity(u32 index) const
+	{
+		return index < m_Entities.size() ? m_Entities[index] : entt::null;
+	}
+
+	String SceneBinaryLoader::GetString(u32 offset) const
+	{
+		// Names are null terminated within the section
+		const char* strings = static_cast<const char*>(m_Records[SectionStrings]);
+		const u32 size = m_Counts[SectionStrings];
+		if (offset >= size || !memchr(strings + offset, 0, size - offset))
+			return String();
+
+		return String(strings + offset);
+	}
+
+	void SceneBinaryLoader::InsertTransform(entt::registry& registry, u32 index)
+	{
+		const TransformRecord& record = static_cast<const TransformRecord*>(m_Records[SectionTransforms])[index];
+		const entt::entity entity = GetEntity(record.entity);
+		if (entity == entt::null || registry.has<Maths::Transform>(entity))
+			return;
+
+		auto& transform = registry.assign<Maths::Transform>(entity, ToVector3(record.position));
+		transform.SetLocalOrientation(ToQuaternion(record.orientation));
+		transform.SetLocalScale(ToVector3(record.scale));
+	}
+
+	void SceneBinaryLoader::InsertHierarchy(entt::registry& registry, u32 index)
+	{
+		const HierarchyRecord& record = static_cast<const HierarchyRecord*>(m_Records[SectionHierarchies])[index];
+
+		// Parents get their own Hierarchy when their first child is linked
+		const entt::entity child = GetEntity(record.entity);
+		const entt::entity parent = GetEntity(record.parent);
+		if (child != entt::null && parent != entt::null && !registry.has<Hierarchy>(child))
+			registry.assign<Hierarchy>(child, parent);
+	}
+
+	void SceneBinaryLoader::InsertBody3D(entt::registry& registry, u32 index)
+	{
+		const Body3DRecord& record = static_cast<const Body3DRecord*>(m_Records[SectionBodies3D])[index];
+		const entt::entity entity = GetEntity(record.entity);
+		if (entity == entt::null || registry.has<Physics3DComponent>(entity))
+			return;
+
+		auto body = CreateRef<PhysicsObject3D>();
+		if (record.shape < m_Shapes.size() && m_Shapes[record.shape])
+			body->SetCollisionShape(m_Shapes[record.shape]);
+
+		body->SetIsBullet((record.flags & BodyBullet) != 0);
+		body->SetPosition(ToVector3(record.position));
+		body->SetOrientation(ToQuaternion(record.orientation));
+		body->SetLinearVelocity(ToVector3(record.linearVelocity));
+		body->SetAngularVelocity(ToVector3(record.angularVelocity));
+		body->SetForce(ToVector3(record.force));
+		body->SetTorque(ToVector3(record.torque));
+		body->SetInverseMass(record.inverseMass);
+		body->SetInverseInertia(Maths::Matrix3(record.inverseInertia));
+		body->SetElasticity(record.elasticity);
+		body->SetFriction(record.friction);
+
+		// Static bodies ignore velocity and force changes, so the flag goes on last
+		body->SetIsStatic((record.flags & BodyStatic) != 0);
+		body->SetIsAtRest((record.flags & BodyAtRest) != 0);
+
+		registry.assign<Physics3DComponent>(entity, body);
+	}
+
+	void SceneBinaryLoader::InsertBody2D(entt::registry& registry, const SceneBinaryLoadOptions& options, u32 index)
+	{
+		const Body2DRecord& record = static_cast<const Body2DRecord*>(m_Records[SectionBodies2D])[index];
+		const entt::entity entity = GetEntity(record.entity);
+		if (entity == entt::null || registry.has<Physics2DComponent>(entity))
+			return;
+
+		PhysicsObjectParamaters params;
+		params.engine = options.engine2D;
+		params.shape = static_cast<Shape>(record.shape);
+		params.isStatic = (record.flags & BodyStatic) != 0;
+		params.position = Maths::Vector3(record.position[0], record.position[1], 0.0f);
+		params.scale = Maths::Vector3(record.scale[0], record.scale[1], 1.0f);
+
+		auto body = CreateRef<PhysicsObject2D>(params);
+		body->SetOrientation(record.angle);
+		body->SetLinearVelocity(Maths::Vector2(record.linearVelocity[0], record.linearVelocity[1]));
+		body->SetAngularVelocity(record.angularVelocity);
+		body->GetB2Body()->SetAwake((record.flags & BodyAtRest) == 0);
+
+		registry.assign<Physics2DComponent>(entity, body);
+	}
+
+	void SceneBinaryLoader::InsertMesh(entt::registry& registry, const MeshResolver& meshes, u32 index)
+	{
+		const AssetRecord& record = static_cast<const AssetRecord*>(m_Records[SectionMeshes])[index];
+		const entt::entity entity = GetEntity(record.entity);
+		if (entity == entt::null || registry.has<MeshComponent>(entity))
+			return;
+
+		Ref<Graphics::Mesh> mesh = meshes ? meshes(GetString(record.name)) : nullptr;
+		if (mesh)
+			registry.assign<MeshComponent>(entity, mesh);
+	}
+
+	void SceneBinaryLoader::InsertMaterial(entt::registry& registry, const MaterialResolver& materials, u32 index)
+	{
+		const AssetRecord& record = static_cast<const AssetRecord*>(m_Records[SectionMaterials])[index];
+		const entt::entity entity = GetEntity(record.entity);
+		if (entity == entt::null || registry.has<MaterialComponent>(entity))
+			return;
+
+		Ref<Material> material = materials ? materials(GetString(record.name)) : nullptr;
+		if (material)
+			registry.assign<MaterialComponent>(entity, material);
+	}
+}
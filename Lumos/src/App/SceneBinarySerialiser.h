@@ -0,0 +1,188 @@
+#pragma once
+#include "lmpch.h"
+
+#include <entt/entt.hpp>
+
+namespace Lumos
+{
+	class Material;
+	class B2PhysicsEngine;
+	class CollisionShape;
+
+	namespace Graphics
+	{
+		class Mesh;
+	}
+
+	//Layout of the binary scene format. Every section is a packed array of one record type, so loading reads the
+	//records straight out of the mapped file. Entities are referred to by their index in the file.
+	namespace SceneBinary
+	{
+		static const u32 Magic = 0x42534d4c;	// "LMSB"
+		static const u32 Version = 1;
+
+		enum SectionType : u32
+		{
+			SectionStrings = 0,		// Null terminated names, referenced by byte offset
+			SectionTransforms,
+			SectionHierarchies,		// Parents before their children, siblings in order
+			SectionShapes,
+			SectionShapePoints,		// Hull points and triangle mesh triangles of the shapes
+			SectionBodies3D,
+			SectionBodies2D,
+			SectionMeshes,
+			SectionMaterials,
+			SectionCount
+		};
+
+		struct FileHeader
+		{
+			u32 magic;
+			u32 version;
+			u32 entityCount;
+			u32 sectionCount;		// Followed by this many SectionHeaders
+		};
+
+		struct SectionHeader
+		{
+			u32 type;
+			u32 count;
+			u64 offset;				// From the start of the file, 8 byte aligned
+		};
+
+		struct TransformRecord
+		{
+			u32 entity;
+			float position[3];
+			float orientation[4];	// w, x, y, z
+			float scale[3];
+		};
+
+		struct HierarchyRecord
+		{
+			u32 entity;
+			u32 parent;
+		};
+
+		struct ShapeRecord
+		{
+			u32 type;				// CollisionShapeType
+			float size[3];			// Half dimensions, or radius and height
+			u32 firstPoint;
+			u32 pointCount;
+		};
+
+		struct ShapePointRecord
+		{
+			float position[3];
+		};
+
+		enum BodyFlags : u32
+		{
+			BodyStatic = 1,
+			BodyAtRest = 2,
+			BodyBullet = 4
+		};
+
+		struct Body3DRecord
+		{
+			u32 entity;
+			u32 shape;				// Index into the shapes, ~0 for none
+			u32 flags;
+			float position[3];
+			float orientation[4];
+			float linearVelocity[3];
+			float angularVelocity[3];
+			float force[3];
+			float torque[3];
+			float inverseMass;
+			float inverseInertia[9];
+			float elasticity;
+			float friction;
+		};
+
+		struct Body2DRecord
+		{
+			u32 entity;
+			u32 shape;				// Lumos::Shape
+			u32 flags;
+			float position[2];
+			float angle;
+			float linearVelocity[2];
+			float angularVelocity;
+			float scale[2];			// Box half extents, or the circle radius
+		};
+
+		struct AssetRecord
+		{
+			u32 entity;
+			u32 name;				// Offset into the strings
+		};
+	}
+
+	typedef std::function<Ref<Graphics::Mesh>(const String&)> MeshResolver;
+	typedef std::function<Ref<Material>(const String&)> MaterialResolver;
+
+	struct LUMOS_EXPORT SceneBinaryLoadOptions
+	{
+		MeshResolver meshes;				// Looked up in the default models when empty
+		MaterialResolver materials;			// Material references are skipped when empty
+		B2PhysicsEngine* engine2D = nullptr;// 2D bodies go in its first world, the application's engine when null
+	};
+
+	//Snapshots the registry's transforms, hierarchy, physics bodies and mesh/material references into the binary
+	//scene format. Meshes and materials are saved as the names they are registered under and looked up again on load.
+	class LUMOS_EXPORT SceneBinarySerialiser
+	{
+	public:
+		static bool Save(entt::registry& registry, const String& path);
+
+		//Maps the file and creates its entities in the registry. Hierarchy links are built by Hierarchy::on_construct,
+		//so the registry's SceneGraph must be initialised first.
+		static bool Load(entt::registry& registry, const String& path, const SceneBinaryLoadOptions& options = SceneBinaryLoadOptions());
+	};
+
+	//Loads a binary scene in two steps. Decode doesn't touch a registry so it can run on a job thread, Insert then adds
+	//the entities to a registry a slice at a time.
+	class LUMOS_EXPORT SceneBinaryLoader
+	{
+	public:
+		SceneBinaryLoader();
+		~SceneBinaryLoader();
+
+		SceneBinaryLoader(const SceneBinaryLoader&) = delete;
+		SceneBinaryLoader& operator=(const SceneBinaryLoader&) = delete;
+
+		//Maps the file, checks its sections and builds its collision shapes. The file stays mapped until destruction.
+		bool Decode(const String& path);
+
+		//Creates the entities and adds their components. Returns false if budgetMs ran out first, the next call carries
+		//on from there. A budget of zero inserts everything.
+		bool Insert(entt::registry& registry, const SceneBinaryLoadOptions& options, float budgetMs = 0.0f);
+
+		//Every entity in the file, created by the first Insert
+		const std::vector<entt::entity>& GetEntities() const { return m_Entities; }
+
+	private:
+		entt::entity GetEntity(u32 index) const;
+		String GetString(u32 offset) const;
+
+		void InsertTransform(entt::registry& registry, u32 index);
+		void InsertHierarchy(entt::registry& registry, u32 index);
+		void InsertBody3D(entt::registry& registry, u32 index);
+		void InsertBody2D(entt::registry& registry, const SceneBinaryLoadOptions& options, u32 index);
+		void InsertMesh(entt::registry& registry, const MeshResolver& meshes, u32 index);
+		void InsertMaterial(entt::registry& registry, const MaterialResolver& materials, u32 index);
+
+		const u8* m_Data = nullptr;
+		i64 m_Size = 0;
+		u32 m_EntityCount = 0;
+		const void* m_Records[SceneBinary::SectionCount] = {};
+		u32 m_Counts[SceneBinary::SectionCount] = {};
+		std::vector<Ref<CollisionShape>> m_Shapes;
+		std::vector<entt::entity> m_Entities;
+
+		u32 m_Section = 0;	// Insert's progress
+		u32 m_Next = 0;
+	};
+}
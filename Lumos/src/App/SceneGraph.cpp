@@ -1,6 +1,8 @@
 #include "lmpch.h"
 #include "SceneGraph.h"
 #include "Maths/Transform.h"
+#include "Core/JobSystem.h"
+#include "ECS/DirtySet.h"
 
 namespace Lumos
 {
@@ -13,28 +15,151 @@ namespace Lumos
 		registry.on_construct<Hierarchy>().connect<&Hierarchy::on_construct>();
 		registry.on_replace<Hierarchy>().connect<&Hierarchy::on_replace>();
 		registry.on_destroy<Hierarchy>().connect<&Hierarchy::on_destroy>();
+
+		registry.on_construct<Maths::Transform>().connect<&SceneGraph::OnTransformConstruct>();
+		registry.on_replace<Maths::Transform>().connect<&SceneGraph::OnTransformConstruct>();
+		registry.on_destroy<Maths::Transform>().connect<&SceneGraph::OnTransformDestroy>();
+
+		// Transforms created before Init aren't counted, so always rebuild on the first update
+		m_Version = ~registry.ctx_or_set<HierarchyVersion>().value;
 	}
 
 	void SceneGraph::Update(entt::registry & registry)
     {
+		const u32 version = registry.ctx_or_set<HierarchyVersion>().value;
+		if (version != m_Version)
+		{
+			Rebuild(registry);
+			m_Version = version;
+		}
+
+		for (u32 level = 0; level + 1 < m_LevelOffsets.size(); level++)
+			UpdateLevel(level);
+
+		// Reported once the level jobs are done, dirty sets aren't thread safe
+		if (HasChangeListeners<Maths::Transform>(registry))
+		{
+			for (u32 i = 0; i < m_Entities.size(); i++)
+			{
+				if (m_Changed[i])
+					MarkChanged<Maths::Transform>(registry, m_Entities[i]);
+			}
+		}
+
+		m_ForceUpdate = false;
+    }
+
+	void SceneGraph::Rebuild(entt::registry& registry)
+	{
 		auto view = registry.view<Maths::Transform>();
 
-		if (view.empty())
-			return;
+		m_Entities.clear();
+		m_Parents.clear();
+		m_LevelOffsets.clear();
 
+		// Roots are transforms without a parent transform
+		m_LevelOffsets.push_back(0);
 		for (auto entity : view)
 		{
 			const auto hierarchy = registry.try_get<Hierarchy>(entity);
-			if (hierarchy && hierarchy->parent() != entt::null)
+			const entt::entity parent = hierarchy ? hierarchy->parent() : entt::null;
+			if (parent == entt::null || !registry.valid(parent) || !view.contains(parent))
 			{
-				UpdateTransform(entity, registry);
+				m_Entities.push_back(entity);
+				m_Parents.push_back(InvalidIndex);
 			}
-			else
+		}
+
+		// Children of each level make up the next one
+		u32 levelStart = 0;
+		while (levelStart < m_Entities.size())
+		{
+			const u32 levelEnd = static_cast<u32>(m_Entities.size());
+			m_LevelOffsets.push_back(levelEnd);
+
+			for (u32 i = levelStart; i < levelEnd; i++)
 			{
-				registry.get<Maths::Transform>(entity).SetWorldMatrix(Maths::Matrix4());
+				const auto hierarchy = registry.try_get<Hierarchy>(m_Entities[i]);
+				entt::entity child = hierarchy ? hierarchy->first() : entt::null;
+				while (child != entt::null)
+				{
+					if (view.contains(child))
+					{
+						m_Entities.push_back(child);
+						m_Parents.push_back(i);
+					}
+
+					const auto childHierarchy = registry.try_get<Hierarchy>(child);
+					child = childHierarchy ? childHierarchy->next() : entt::null;
+				}
 			}
+
+			levelStart = levelEnd;
 		}
-    }
+
+		if (m_Entities.size() != view.size())
+			Debug::Log::Warning("SceneGraph : {0} transforms are part of a parent cycle and won't be updated", view.size() - m_Entities.size());
+
+		m_Transforms.resize(m_Entities.size());
+		for (u32 i = 0; i < m_Entities.size(); i++)
+			m_Transforms[i] = &view.get(m_Entities[i]);
+
+		m_Changed.assign(m_Entities.size(), 0);
+		m_LocalVersions.assign(m_Entities.size(), 0);
+		m_ForceUpdate = true;
+	}
+
+	void SceneGraph::UpdateLevel(u32 level)
+	{
+		const u32 first = m_LevelOffsets[level];
+		const u32 count = m_LevelOffsets[level + 1] - first;
+
+		// A node only reads its parent, which belongs to the previous level
+		auto updateNode = [this](u32 index)
+		{
+			Maths::Transform* transform = m_Transforms[index];
+			const u32 parent = m_Parents[index];
+
+			// Rebuilds the local matrix if it is dirty, which bumps its version
+			transform->GetLocalMatrix();
+
+			const u32 localVersion = transform->GetLocalVersion();
+			const bool changed = m_ForceUpdate || localVersion != m_LocalVersions[index] || (parent != InvalidIndex && m_Changed[parent]);
+			m_Changed[index] = changed ? 1 : 0;
+			m_LocalVersions[index] = localVersion;
+
+			if (!changed)
+				return;
+
+			transform->SetWorldMatrix(parent != InvalidIndex ? m_Transforms[parent]->GetWorldMatrix() : Maths::Matrix4());
+		};
+
+		// Not worth waking the job system for small levels
+		const u32 jobGroupSize = 256;
+		if (count <= jobGroupSize)
+		{
+			for (u32 i = first; i < first + count; i++)
+				updateNode(i);
+			return;
+		}
+
+		System::JobSystem::Dispatch(count, jobGroupSize, [&](JobDispatchArgs args)
+		{
+			updateNode(first + args.jobIndex);
+		});
+
+		System::JobSystem::Wait();
+	}
+
+	void SceneGraph::OnTransformConstruct(entt::entity entity, entt::registry& registry, Maths::Transform& transform)
+	{
+		++registry.ctx_or_set<HierarchyVersion>().value;
+	}
+
+	void SceneGraph::OnTransformDestroy(entt::entity entity, entt::registry& registry)
+	{
+		++registry.ctx_or_set<HierarchyVersion>().value;
+	}
 
 	void SceneGraph::UpdateTransform(entt::entity entity, entt::registry & registry)
 	{
@@ -48,6 +173,7 @@ namespace Lumos
 				if (parentTransform)
 				{
 					transform->SetWorldMatrix(parentTransform->GetWorldMatrix());
+					MarkChanged<Maths::Transform>(registry, entity);
 				}
 			}
 
@@ -96,6 +222,8 @@ namespace Lumos
 
 	void Hierarchy::on_construct(entt::entity entity, entt::registry& registry, Hierarchy& hierarchy)
 	{
+		++registry.ctx_or_set<HierarchyVersion>().value;
+
 		if (hierarchy._parent != entt::null)
 		{
 			auto& parent_hierarchy = registry.get_or_assign<Hierarchy>(hierarchy._parent);
@@ -152,6 +280,8 @@ namespace Lumos
 
 	void Hierarchy::on_replace(entt::entity entity, entt::registry& registry)
 	{
+		++registry.ctx_or_set<HierarchyVersion>().value;
+
 		auto& hierarchy = registry.get<Hierarchy>(entity);
 		// if is the first child
 		if (hierarchy._prev == entt::null)
@@ -201,6 +331,8 @@ namespace Lumos
 
 	void Hierarchy::on_destroy(entt::entity entity, entt::registry& registry) 
 	{
+		++registry.ctx_or_set<HierarchyVersion>().value;
+
 		auto& hierarchy = registry.get<Hierarchy>(entity);
 		// if is the first child
 		if (hierarchy._prev == entt::null || !registry.valid(hierarchy._prev))
@@ -1,9 +1,21 @@
 #pragma once
 
+#include "lmpch.h"
 #include <entt/entt.hpp>
 
 namespace Lumos
 {
+	namespace Maths
+	{
+		class Transform;
+	}
+
+	//Registry context value bumped whenever transforms or hierarchy links are added or removed
+	struct HierarchyVersion
+	{
+		u32 value = 0;
+	};
+
 	class Hierarchy
 	{
 	public:
@@ -33,6 +45,10 @@ namespace Lumos
 		entt::entity _prev = entt::null;
 	};
 
+	//Keeps every Transform in a flat array sorted by depth, parents before children.
+	//World matrices are only recomputed for transforms whose local matrix changed and their descendants,
+	//one depth level at a time with the nodes of a level split across the job system.
+	//Transforms whose world matrix was recomputed are reported to any DirtySet<Maths::Transform> of the registry.
     class SceneGraph
     {
     public:
@@ -43,5 +59,27 @@ namespace Lumos
         
         void Update(entt::registry& registry);
 		void UpdateTransform(entt::entity entity, entt::registry& registry);
+
+		u32 GetNodeCount() const { return static_cast<u32>(m_Entities.size()); }
+		u32 GetDepthCount() const { return m_LevelOffsets.empty() ? 0 : static_cast<u32>(m_LevelOffsets.size() - 1); }
+
+	private:
+		void Rebuild(entt::registry& registry);
+		void UpdateLevel(u32 level);
+
+		static void OnTransformConstruct(entt::entity entity, entt::registry& registry, Maths::Transform& transform);
+		static void OnTransformDestroy(entt::entity entity, entt::registry& registry);
+
+		static constexpr u32 InvalidIndex = ~0u;
+
+		std::vector<entt::entity>	   m_Entities;
+		std::vector<Maths::Transform*> m_Transforms;	//!< Stable until the next transform is added or removed, which triggers a rebuild
+		std::vector<u32>			   m_Parents;		//!< Index of the parent node, InvalidIndex for roots
+		std::vector<u32>			   m_LevelOffsets;	//!< First node of each depth, plus the node count
+		std::vector<u8>				   m_Changed;		//!< World matrix recomputed this update
+		std::vector<u32>			   m_LocalVersions;	//!< Local matrix version the world matrix was last computed from
+
+		u32	 m_Version = 0;
+		bool m_ForceUpdate = true;
     };
 }
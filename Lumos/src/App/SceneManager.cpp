@@ -6,6 +6,9 @@
 #include "App/Application.h"
 #include "Scene.h"
 #include "Physics/LumosPhysicsEngine/LumosPhysicsEngine.h"
+#include "ECS/SystemManager.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
 
 namespace Lumos
 {
@@ -19,6 +22,9 @@ namespace Lumos
 	{
 		m_SceneIdx = 0;
 
+		while (!m_SimulatedScenes.empty())
+			RemoveSimulatedScene(m_SimulatedScenes.back().scene.get());
+
 		if (m_CurrentScene)
 		{
 			Debug::Log::Info("[SceneManager] - Exiting scene : {0}", m_CurrentScene->GetSceneName());
@@ -103,6 +109,68 @@ namespace Lumos
         m_SwitchingScenes = false;
     }
     
+	void SceneManager::AddSimulatedSceneInternal(const Ref<Scene>& scene)
+	{
+		// Separate engines per scene, so no physics state is shared between them
+		auto systems = CreateRef<SystemManager>();
+		systems->RegisterSystem<LumosPhysicsEngine>()->SetDefaults();
+		systems->RegisterSystem<B2PhysicsEngine>()->SetDefaults();
+
+		scene->SetSystemManager(systems.get());
+		scene->OnInit();
+
+		systems->GetSystem<LumosPhysicsEngine>()->SetPaused(false);
+		systems->GetSystem<B2PhysicsEngine>()->SetPaused(false);
+
+		m_SimulatedScenes.push_back({ scene, systems });
+		Debug::Log::Info("[SceneManager] - Simulating scene : {0}", scene->GetSceneName());
+	}
+
+	void SceneManager::RemoveSimulatedScene(Scene* scene)
+	{
+		auto it = std::find_if(m_SimulatedScenes.begin(), m_SimulatedScenes.end(), [scene](const SimulatedScene& simulated) { return simulated.scene.get() == scene; });
+		if (it == m_SimulatedScenes.end())
+			return;
+
+		Debug::Log::Info("[SceneManager] - Stopped simulating scene : {0}", scene->GetSceneName());
+
+		// The scene's bodies are destroyed before its engines
+		SimulatedScene simulated = *it;
+		m_SimulatedScenes.erase(it);
+		simulated.scene->OnCleanupScene();
+		simulated.scene->SetSystemManager(nullptr);
+	}
+
+	void SceneManager::UpdateSimulatedScenes(TimeStep* timeStep)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		if (m_SimulatedScenes.empty())
+			return;
+
+		// One job per scene. Scenes share nothing, so their systems can spread their own work over the other workers
+		System::JobSystem::Context context;
+		System::JobSystem::Dispatch(context, static_cast<u32>(m_SimulatedScenes.size()), 1, [&](JobDispatchArgs args)
+		{
+			SimulatedScene& simulated = m_SimulatedScenes[args.jobIndex];
+			simulated.scene->OnUpdate(timeStep);
+			simulated.systems->OnUpdate(timeStep, simulated.scene.get());
+		});
+
+		System::JobSystem::Wait(context);
+	}
+
+	void SceneManager::UpdateLevelStreamers()
+	{
+		LUMOS_PROFILE_FUNC;
+
+		if (m_CurrentScene)
+			m_CurrentScene->UpdateLevelStreamer();
+
+		for (auto& simulated : m_SimulatedScenes)
+			simulated.scene->UpdateLevelStreamer();
+	}
+
     std::vector<String> SceneManager::GetSceneNames()
     {
         std::vector<String> names;
@@ -5,6 +5,8 @@
 namespace Lumos
 {
 	class Scene;
+	class SystemManager;
+	class TimeStep;
 
 	class LUMOS_EXPORT SceneManager
     {
@@ -46,10 +48,38 @@ namespace Lumos
 			LUMOS_LOG_INFO("[SceneManager] - Enqueued scene : {0}", name.c_str());
 		}
 
+		//Simulated scenes run alongside the current scene, e.g. the rooms of a dedicated server. Each one gets its own
+		//physics engines and is updated on a job system worker. They aren't rendered and don't read input.
+		template<class T>
+		Ref<T> AddSimulatedScene(const String& name)
+		{
+			Ref<T> scene = CreateRef<T>(name);
+			AddSimulatedSceneInternal(scene);
+			return scene;
+		}
+
+		void RemoveSimulatedScene(Scene* scene);
+		void UpdateSimulatedScenes(TimeStep* timeStep);
+
+		//Streams the level chunks of the current and simulated scenes. Main thread, while no scene is updating.
+		void UpdateLevelStreamers();
+
+		u32 GetSimulatedSceneCount() const { return static_cast<u32>(m_SimulatedScenes.size()); }
+		Scene* GetSimulatedScene(u32 index) const { return m_SimulatedScenes[index].scene.get(); }
+
 	protected:
+		struct SimulatedScene
+		{
+			Ref<Scene> scene;
+			Ref<SystemManager> systems;
+		};
+
+		void AddSimulatedSceneInternal(const Ref<Scene>& scene);
+
 		u32 m_SceneIdx;
 		Scene* m_CurrentScene;
 		std::vector<Ref<Scene>> m_vpAllScenes;
+		std::vector<SimulatedScene> m_SimulatedScenes;
 
     private:
         bool m_SwitchingScenes = false;
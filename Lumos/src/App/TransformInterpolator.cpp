@@ -0,0 +1,110 @@
+#include "lmpch.h"
+#include "TransformInterpolator.h"
+#include "Maths/Transform.h"
+#include "Core/Profiler.h"
+#include "ECS/DirtySet.h"
+
+namespace Lumos
+{
+	void TransformInterpolator::Capture(entt::registry& registry)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		if (m_Registry != &registry)
+		{
+			Reset();
+			m_Registry = &registry;
+		}
+
+		std::swap(m_Previous, m_Current);
+		m_Moving.clear();
+
+		// Pool order only changes when transforms are added, removed or sorted, so poses are matched by index
+		const u32 count = static_cast<u32>(registry.size<Maths::Transform>());
+		const entt::entity* entities = registry.data<Maths::Transform>();
+		Maths::Transform* transforms = registry.raw<Maths::Transform>();
+
+		m_Current.resize(count);
+		for (u32 i = 0; i < count; i++)
+		{
+			const u32 version = transforms[i].GetWorldVersion();
+			const bool matched = i < m_Previous.size() && m_Previous[i].entity == entities[i];
+
+			Pose& pose = m_Current[i];
+			if (matched && m_Previous[i].worldVersion == version)
+			{
+				pose = m_Previous[i];
+				continue;
+			}
+
+			pose.entity = entities[i];
+			pose.worldVersion = version;
+			pose.world = transforms[i].GetWorldMatrix();
+			pose.position = pose.world.Translation();
+			pose.orientation = pose.world.Rotation();
+			pose.scale = pose.world.Scale();
+
+			if (matched)
+				m_Moving.push_back(i);
+		}
+	}
+
+	void TransformInterpolator::Apply(entt::registry& registry, float alpha)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		if (m_Registry != &registry || alpha >= 1.0f)
+			return;
+
+		for (u32 index : m_Moving)
+		{
+			const Pose& previous = m_Previous[index];
+			const Pose& current = m_Current[index];
+
+			// Layers can destroy entities between the last tick and rendering
+			if (!registry.valid(current.entity))
+				continue;
+
+			if (auto transform = registry.try_get<Maths::Transform>(current.entity))
+			{
+				const Maths::Matrix4 world = Maths::Matrix4::Translation(previous.position.Lerp(current.position, alpha))
+					* previous.orientation.Nlerp(current.orientation, alpha, true).RotationMatrix4()
+					* Maths::Matrix4::Scale(previous.scale.Lerp(current.scale, alpha));
+				transform->OverrideWorldMatrix(world);
+				MarkChanged<Maths::Transform>(registry, current.entity);
+			}
+		}
+
+		m_Applied = true;
+	}
+
+	void TransformInterpolator::Restore(entt::registry& registry)
+	{
+		if (!m_Applied || m_Registry != &registry)
+			return;
+
+		for (u32 index : m_Moving)
+		{
+			const Pose& current = m_Current[index];
+			if (!registry.valid(current.entity))
+				continue;
+
+			if (auto transform = registry.try_get<Maths::Transform>(current.entity))
+			{
+				transform->OverrideWorldMatrix(current.world);
+				MarkChanged<Maths::Transform>(registry, current.entity);
+			}
+		}
+
+		m_Applied = false;
+	}
+
+	void TransformInterpolator::Reset()
+	{
+		m_Registry = nullptr;
+		m_Previous.clear();
+		m_Current.clear();
+		m_Moving.clear();
+		m_Applied = false;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "lmpch.h"
+#include "Maths/Maths.h"
+
+#include <entt/entt.hpp>
+
+namespace Lumos
+{
+	//Keeps the world pose of every Transform after the last two simulation ticks, so frames drawn between ticks can
+	//show a blend of the two. Transforms that didn't move in the last tick are left alone, and so are transforms
+	//added, removed or reordered in the pool since the previous tick, which snap to their current pose.
+	class LUMOS_EXPORT TransformInterpolator
+	{
+	public:
+		TransformInterpolator() = default;
+		~TransformInterpolator() = default;
+
+		//Call after a tick, once the scene graph is updated. The poses captured last become the previous ones.
+		void Capture(entt::registry& registry);
+
+		//Sets the world matrix of each moving transform between its previous (0) and current (1) pose
+		void Apply(entt::registry& registry, float alpha);
+
+		//Puts the simulated world matrices back, call after rendering and before the next tick
+		void Restore(entt::registry& registry);
+
+		void Reset();
+
+		u32 GetMovingCount() const { return static_cast<u32>(m_Moving.size()); }
+
+	private:
+		struct Pose
+		{
+			entt::entity entity;
+			u32 worldVersion;
+			Maths::Vector3 position;
+			Maths::Quaternion orientation;
+			Maths::Vector3 scale;
+			Maths::Matrix4 world;
+		};
+
+		entt::registry* m_Registry = nullptr;
+		std::vector<Pose> m_Previous;
+		std::vector<Pose> m_Current;
+		std::vector<u32> m_Moving;		// Index of each transform that moved, the same in both pose lists
+		bool m_Applied = false;
+	};
+}
@@ -1,5 +1,6 @@
 #include "lmpch.h"
 #include "AudioManager.h"
+#include "ECS/Component/SoundComponent.h"
 
 #ifdef LUMOS_OPENAL
 #include "Platform/OpenAL/ALManager.h"
@@ -15,4 +16,10 @@ namespace Lumos
         return nullptr;
         #endif
     }
+
+	void AudioManager::DeclareAccess(SystemAccess& access) const
+	{
+		// Only updates its sound nodes and reads the listener camera
+		access.Write<SoundComponent>();
+	}
 }
\ No newline at end of file
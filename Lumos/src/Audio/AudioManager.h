@@ -15,6 +15,7 @@ namespace Lumos
         virtual ~AudioManager() = default;
         virtual void OnInit() override = 0;
         virtual void OnUpdate(TimeStep* dt, Scene* scene) override = 0;
+		void DeclareAccess(SystemAccess& access) const override;
 
 		virtual void SetListener(Camera* camera) { m_Listener = camera; }
 		Camera* GetListener() const { return m_Listener; }
@@ -66,15 +66,40 @@ namespace Lumos
         {
             uint32_t numThreads = 0;
             ThreadSafeRingBuffer<std::function<void()>, 256> jobPool;
-            std::condition_variable wakeCondition;
-            std::mutex wakeMutex;
-            uint64_t currentLabel = 0;
-            std::atomic<uint64_t> finishedLabel;
+            ThreadSafeRingBuffer<std::function<void()>, 64> workerJobPool;	// Only taken by idle workers
+            // Never destroyed, the detached workers are still waiting on them at exit and destroying a
+            // condition variable with waiters blocks on some platforms
+            std::condition_variable& wakeCondition = *new std::condition_variable();
+            std::mutex& wakeMutex = *new std::mutex();
+            thread_local Context threadContext;
+
+            // Runs one queued job on the calling thread, returns false if the queue was empty
+            _FORCE_INLINE_ bool work()
+            {
+                std::function<void()> job;
+                if (!jobPool.pop_front(job))
+                    return false;
 
-            void OnInit()
+                job();
+                return true;
+            }
+
+            // Same as above for an idle worker, which also takes the jobs only workers may run
+            _FORCE_INLINE_ bool workIdle()
             {
-                finishedLabel.store(0);
+                if (work())
+                    return true;
+
+                std::function<void()> job;
+                if (!workerJobPool.pop_front(job))
+                    return false;
 
+                job();
+                return true;
+            }
+
+            void OnInit()
+            {
                 // Retrieve the number of hardware threads in this System:
                 auto numCores = std::thread::hardware_concurrency();
 
@@ -85,16 +110,9 @@ namespace Lumos
                 {
                     std::thread worker([] {
 
-                        std::function<void()> job;
-
                         while (true)
                         {
-                            if (jobPool.pop_front(job))
-                            {
-                                job(); // execute job
-                                finishedLabel.fetch_add(1); // update worker label state
-                            }
-                            else
+                            if (!workIdle())
                             {
                                 // no job, put thread to sleep
                                 std::unique_lock<std::mutex> lock(wakeMutex);
@@ -137,18 +155,52 @@ namespace Lumos
                 return numThreads;
             }
 
-            void Execute(const std::function<void()>& job)
+            // Pushes a job that decrements the context's counter when it finishes. While the pool is full this thread
+            // runs queued jobs to make room, and the job isn't counted meanwhile: a nested wait on the same context
+            // further up this thread's stack would otherwise wait for a job only this thread can push.
+            template<typename Pool>
+            _FORCE_INLINE_ void push(Pool& pool, Context& context, const std::function<void()>& job)
             {
-                // The main thread label state is updated:
-                currentLabel += 1;
-
-                // Try to push a new job until it is pushed successfully:
-                while (!jobPool.push_back(job)) { poll(); }
+                context.counter.fetch_add(1);
+                while (!pool.push_back(job))
+                {
+                    context.counter.fetch_sub(1);
+                    if (!work())
+                        poll();
+                    context.counter.fetch_add(1);
+                }
 
                 wakeCondition.notify_one(); // wake one thread
             }
 
-            void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job)
+            void Execute(Context& context, const std::function<void()>& job)
+            {
+                Context* jobContext = &context;
+                push(jobPool, context, [jobContext, job]()
+                {
+                    job();
+                    jobContext->counter.fetch_sub(1);
+                });
+            }
+
+            void ExecuteOnWorker(Context& context, const std::function<void()>& job)
+            {
+                // Nothing would ever run it
+                if (numThreads == 0)
+                {
+                    job();
+                    return;
+                }
+
+                Context* jobContext = &context;
+                push(workerJobPool, context, [jobContext, job]()
+                {
+                    job();
+                    jobContext->counter.fetch_sub(1);
+                });
+            }
+
+            void Dispatch(Context& context, uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job)
             {
                 if (jobCount == 0 || groupSize == 0)
                 {
@@ -158,13 +210,12 @@ namespace Lumos
                 // Calculate the amount of job groups to dispatch (overestimate, or "ceil"):
                 const uint32_t groupCount = (jobCount + groupSize - 1) / groupSize;
 
-                // The main thread label state is updated:
-                currentLabel += groupCount;
+                Context* jobContext = &context;
 
                 for (uint32_t groupIndex = 0; groupIndex < groupCount; ++groupIndex)
                 {
                     // For each group, generate one real job:
-                    const auto& jobGroup = [jobCount, groupSize, job, groupIndex]() {
+                    const auto& jobGroup = [jobCount, groupSize, job, groupIndex, jobContext]() {
 
                         // Calculate the current group's offset into the jobs:
                         const uint32_t groupJobOffset = groupIndex * groupSize;
@@ -179,26 +230,47 @@ namespace Lumos
                             args.jobIndex = i;
                             job(args);
                         }
+
+                        jobContext->counter.fetch_sub(1);
                     };
 
-                    // Try to push a new job until it is pushed successfully:
-                    while (!jobPool.push_back(jobGroup)) { poll(); }
+                    push(jobPool, context, jobGroup);
+                }
+            }
 
-                    wakeCondition.notify_one(); // wake one thread
+            bool IsBusy(const Context& context)
+            {
+                return context.counter.load() > 0;
+            }
+
+            void Wait(const Context& context)
+            {
+                // Helping instead of sleeping keeps nested waits from running out of worker threads
+                while (IsBusy(context))
+                {
+                    if (!work())
+                        poll();
                 }
+            }
 
+            void Execute(const std::function<void()>& job)
+            {
+                Execute(threadContext, job);
+            }
 
+            void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job)
+            {
+                Dispatch(threadContext, jobCount, groupSize, job);
             }
 
             bool IsBusy()
             {
-                // Whenever the main thread label is not reached by the workers, it indicates that some worker is still alive
-                return finishedLabel.load() < currentLabel;
+                return IsBusy(threadContext);
             }
 
             void Wait()
             {
-                while (IsBusy()) { poll(); }
+                Wait(threadContext);
             }
         }
     }
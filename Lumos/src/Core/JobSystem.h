@@ -1,6 +1,8 @@
 #pragma once
 #include "lmpch.h"
 
+#include <atomic>
+
 struct JobDispatchArgs
 {
 	uint32_t jobIndex;
@@ -13,23 +15,41 @@ namespace Lumos
     {
         namespace JobSystem
         {
+            // Counts the unfinished jobs started through it, so a thread only waits for its own work.
+            // Must outlive the jobs it tracks.
+            struct Context
+            {
+                std::atomic<uint32_t> counter{ 0 };
+            };
+
             void OnInit();
 
             uint32_t GetThreadCount();
 
             // Add a job to execute asynchronously. Any idle thread will execute this job.
-            void Execute(const std::function<void()>& job);
+            void Execute(Context& context, const std::function<void()>& job);
+
+            // Add a long job, like a frame's simulation, that only an idle worker thread will execute. Threads helping
+            // out in Wait never pick it up, so waiting for short jobs can't end up running it inline.
+            void ExecuteOnWorker(Context& context, const std::function<void()>& job);
 
             // Divide a job onto multiple jobs and execute in parallel.
             //	jobCount	: how many jobs to generate for this task.
             //	groupSize	: how many jobs to execute per thread. Jobs inside a group execute serially. It might be worth to increase for small jobs
             //	func		: receives a JobDispatchArgs as parameter
-            void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job);
+            void Dispatch(Context& context, uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job);
 
-            // Check if any threads are working currently or not
-            bool IsBusy();
+            // Check if jobs of the context are still running
+            bool IsBusy(const Context& context);
+
+            // Wait until all jobs of the context are done. The waiting thread runs queued jobs in the meantime,
+            // so jobs can dispatch and wait for jobs of their own. Jobs added with ExecuteOnWorker aren't run.
+            void Wait(const Context& context);
 
-            // Wait until all threads become idle
+            // Same as above with a context owned by the calling thread
+            void Execute(const std::function<void()>& job);
+            void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job);
+            bool IsBusy();
             void Wait();
         }
     }
@@ -16,6 +16,10 @@ namespace Lumos
 
 		static bool WriteFile(const String& path, u8* buffer);
 		static bool WriteTextFile(const String& path, const String& text);
+
+		//Maps the whole file into memory read only. Returns null if it can't be mapped, release it with UnmapFile.
+		static const u8* MapFile(const String& path, i64& out_size);
+		static void UnmapFile(const u8* data, i64 size);
         
         static bool IsRelativePath(const char *path)
         {
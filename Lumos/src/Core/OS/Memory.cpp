@@ -4,10 +4,17 @@
 #include "Allocators/DefaultAllocator.h"
 #include "Allocators/StbAllocator.h"
 
+#include <atomic>
+
 namespace Lumos
 {
 	Allocator* const Memory::MemoryAllocator = new DefaultAllocator();
 
+	static bool s_CountAllocations = false;
+	static std::atomic<uint64_t> s_AllocationCount{ 0 };
+	static std::atomic<uint64_t> s_AllocatedBytes{ 0 };
+	static std::atomic<uint64_t> s_FreeCount{ 0 };
+
     void* Memory::AlignedAlloc(size_t size, size_t alignment)
     {
         void *data;
@@ -32,6 +39,12 @@ namespace Lumos
     
     void* Memory::NewFunc(std::size_t size, const char *file, int line)
     {
+		if (s_CountAllocations)
+		{
+			s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+			s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+
 		if (MemoryAllocator)
 			return MemoryAllocator->Malloc(size, file, line);
 		else
@@ -40,6 +53,9 @@ namespace Lumos
     
     void Memory::DeleteFunc(void* p)
     {
+		if (s_CountAllocations && p)
+			s_FreeCount.fetch_add(1, std::memory_order_relaxed);
+
 		if (MemoryAllocator)
 			return MemoryAllocator->Free(p);
 		else
@@ -51,6 +67,26 @@ namespace Lumos
 		if (MemoryAllocator)
 			return MemoryAllocator->Print();
     }
+
+	void Memory::SetCountAllocations(bool count)
+	{
+		s_CountAllocations = count;
+	}
+
+	uint64_t Memory::GetAllocationCount()
+	{
+		return s_AllocationCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t Memory::GetAllocatedBytes()
+	{
+		return s_AllocatedBytes.load(std::memory_order_relaxed);
+	}
+
+	uint64_t Memory::GetFreeCount()
+	{
+		return s_FreeCount.load(std::memory_order_relaxed);
+	}
 }
 
 #ifdef CUSTOM_MEMORY_ALLOCATOR
@@ -14,6 +14,13 @@ namespace Lumos
 		static void DeleteFunc(void* p);
 		static void LogMemoryInformation();
 
+		//Counts calls through the engine's new and delete while enabled, for benchmarks.
+		//Off by default, each counted call is an atomic add.
+		static void SetCountAllocations(bool count);
+		static uint64_t GetAllocationCount();
+		static uint64_t GetAllocatedBytes();
+		static uint64_t GetFreeCount();
+
 		static Allocator* const MemoryAllocator;
 	};
 }
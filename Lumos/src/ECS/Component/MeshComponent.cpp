@@ -1,5 +1,6 @@
 #include "lmpch.h"
 #include "MeshComponent.h"
+#include "Maths/Transform.h"
 
 namespace Lumos
 {
@@ -17,6 +18,23 @@ namespace Lumos
         m_Mesh = Lumos::Ref<Graphics::Mesh>(mesh);
 	}
 
+	const Maths::BoundingBox& MeshComponent::GetWorldBoundingBox(Maths::Transform& transform)
+	{
+		if (!m_WorldBoundingBoxValid)
+			UpdateWorldBoundingBox(transform);
+
+		return m_WorldBoundingBox;
+	}
+
+	void MeshComponent::UpdateWorldBoundingBox(Maths::Transform& transform)
+	{
+		if (!m_Mesh)
+			return;
+
+		m_WorldBoundingBox = m_Mesh->GetBoundingBox()->Transformed(transform.GetWorldMatrix());
+		m_WorldBoundingBoxValid = true;
+	}
+
 	void MeshComponent::OnImGui()
 	{
 		
@@ -1,11 +1,17 @@
 #pragma once
 #include "lmpch.h"
 #include "Graphics/Mesh.h"
+#include "Maths/BoundingBox.h"
 
 #include <jsonhpp/json.hpp>
 
 namespace Lumos
 {
+	namespace Maths
+	{
+		class Transform;
+	}
+
 	class LUMOS_EXPORT MeshComponent
 	{
 	public:
@@ -17,13 +23,22 @@ namespace Lumos
 		void OnImGui();
 
 		Graphics::Mesh* GetMesh() const { return m_Mesh.get(); }
+		const Ref<Graphics::Mesh>& GetMeshRef() const { return m_Mesh; }
 
 		bool& GetActive() { return m_Mesh->GetActive(); }
 
+		//Mesh bounds transformed by the entity's world matrix. Computed on first use, after that only by
+		//UpdateWorldBoundingBox, which the render snapshot calls for the transforms that changed.
+		const Maths::BoundingBox& GetWorldBoundingBox(Maths::Transform& transform);
+		void UpdateWorldBoundingBox(Maths::Transform& transform);
+
 		nlohmann::json Serialise() { return nullptr; };
 		void Deserialise(nlohmann::json& data) {};
 
 	private:
 		Ref<Graphics::Mesh> m_Mesh;
+
+		Maths::BoundingBox m_WorldBoundingBox;
+		bool m_WorldBoundingBoxValid = false;
 	};
 }
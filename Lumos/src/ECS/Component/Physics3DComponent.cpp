@@ -38,6 +38,7 @@ namespace Lumos
         auto friction = m_PhysicsObject->GetFriction();
         auto isStatic = m_PhysicsObject->GetIsStatic();
         auto isRest = m_PhysicsObject->GetIsAtRest();
+        auto isBullet = m_PhysicsObject->GetIsBullet();
         auto mass = 1.0f / m_PhysicsObject->GetInverseMass();
         auto velocity = m_PhysicsObject->GetLinearVelocity();
         auto elasticity = m_PhysicsObject->GetElasticity();
@@ -143,6 +144,16 @@ namespace Lumos
         ImGui::PopItemWidth();
         ImGui::NextColumn();
 
+        ImGui::AlignTextToFramePadding();
+        ImGui::TextUnformatted("Bullet");
+        ImGui::NextColumn();
+        ImGui::PushItemWidth(-1);
+        if(ImGui::Checkbox("##Bullet", &isBullet))
+            m_PhysicsObject->SetIsBullet(isBullet);
+
+        ImGui::PopItemWidth();
+        ImGui::NextColumn();
+
         ImGui::Columns(1);
         ImGui::Separator();
         ImGui::PopStyleVar();
@@ -0,0 +1,162 @@
+#pragma once
+#include "lmpch.h"
+
+#include <entt/entt.hpp>
+
+namespace Lumos
+{
+	template<typename T>
+	class DirtySet;
+
+	//Registry context value listing the dirty sets of one component type. The registry signals are only connected
+	//while at least one set is listening, so untracked types cost nothing.
+	template<typename T>
+	struct ComponentChanges
+	{
+		std::vector<DirtySet<T>*> sets;
+
+		static void OnChange(entt::entity entity, entt::registry& registry)
+		{
+			for (auto set : registry.ctx<ComponentChanges<T>>().sets)
+				set->Mark(entity);
+		}
+
+		static void OnDestroy(entt::entity entity, entt::registry& registry)
+		{
+			for (auto set : registry.ctx<ComponentChanges<T>>().sets)
+				set->Remove(entity);
+		}
+	};
+
+	//True if a dirty set is listening for changes to T, so producers can skip collecting changes nobody reads
+	template<typename T>
+	bool HasChangeListeners(const entt::registry& registry)
+	{
+		auto changes = registry.try_ctx<ComponentChanges<T>>();
+		return changes && !changes->sets.empty();
+	}
+
+	//Reports a component edited in place. Only assign and replace are seen by the registry, so code changing a
+	//component through a reference (scene graph and physics updates, interpolation) calls this for listeners to see it.
+	//Like any other registry edit, call it from the thread updating the registry and never from parallel jobs.
+	//Systems calling it declare access.Write<ComponentChanges<T>>(), so two of them never run in the same stage.
+	template<typename T>
+	void MarkChanged(entt::registry& registry, entt::entity entity)
+	{
+		// Entities without a T would never be removed by on_destroy
+		auto changes = registry.try_ctx<ComponentChanges<T>>();
+		if (changes && registry.has<T>(entity))
+		{
+			for (auto set : changes->sets)
+				set->Mark(entity);
+		}
+	}
+
+	//Entities whose T was added, replaced or marked changed since the set was last consumed.
+	//Each system keeps its own set, so one system consuming its changes doesn't hide them from another.
+	//Sets aren't thread safe, so consume them while no other thread is updating the registry.
+	//Disconnect before the registry is destroyed.
+	template<typename T>
+	class DirtySet
+	{
+	public:
+		DirtySet() = default;
+		explicit DirtySet(entt::registry& registry) { Connect(registry); }
+		~DirtySet() { Disconnect(); }
+
+		DirtySet(const DirtySet&) = delete;
+		DirtySet& operator=(const DirtySet&) = delete;
+
+		void Connect(entt::registry& registry)
+		{
+			Disconnect();
+
+			auto& changes = registry.ctx_or_set<ComponentChanges<T>>();
+			if (changes.sets.empty())
+			{
+				registry.on_construct<T>().template connect<&ComponentChanges<T>::OnChange>();
+				registry.on_replace<T>().template connect<&ComponentChanges<T>::OnChange>();
+				registry.on_destroy<T>().template connect<&ComponentChanges<T>::OnDestroy>();
+			}
+
+			changes.sets.push_back(this);
+			m_Registry = &registry;
+		}
+
+		void Disconnect()
+		{
+			if (!m_Registry)
+				return;
+
+			auto& changes = m_Registry->ctx<ComponentChanges<T>>();
+			changes.sets.erase(std::find(changes.sets.begin(), changes.sets.end(), this));
+			if (changes.sets.empty())
+			{
+				m_Registry->on_construct<T>().template disconnect<&ComponentChanges<T>::OnChange>();
+				m_Registry->on_replace<T>().template disconnect<&ComponentChanges<T>::OnChange>();
+				m_Registry->on_destroy<T>().template disconnect<&ComponentChanges<T>::OnDestroy>();
+			}
+
+			m_Registry = nullptr;
+			Clear();
+		}
+
+		bool IsConnected() const { return m_Registry != nullptr; }
+		bool Empty() const { return m_Entities.empty(); }
+		size_t Size() const { return m_Entities.size(); }
+		bool Contains(entt::entity entity) const { return m_Entities.has(entity); }
+
+		void Clear()
+		{
+			// Removing one at a time keeps the sparse pages allocated for the next frame
+			while (!m_Entities.empty())
+				m_Entities.destroy(m_Entities.data()[m_Entities.size() - 1]);
+		}
+
+		//Calls func(entity, component) for every changed entity, then clears the set.
+		//Changes reported from inside func are kept for the next call.
+		template<typename Func>
+		void Consume(Func func)
+		{
+			if (!m_Registry)
+				return;
+
+			std::swap(m_Entities, m_Consuming);
+
+			const entt::entity* entities = m_Consuming.data();
+			for (size_t i = 0; i < m_Consuming.size(); i++)
+			{
+				// func may destroy entities that haven't been visited yet
+				if (!m_Registry->valid(entities[i]))
+					continue;
+
+				if (auto component = m_Registry->try_get<T>(entities[i]))
+					func(entities[i], *component);
+			}
+
+			while (!m_Consuming.empty())
+				m_Consuming.destroy(m_Consuming.data()[m_Consuming.size() - 1]);
+		}
+
+	private:
+		friend struct ComponentChanges<T>;
+		template<typename U>
+		friend void MarkChanged(entt::registry& registry, entt::entity entity);
+
+		void Mark(entt::entity entity)
+		{
+			if (!m_Entities.has(entity))
+				m_Entities.construct(entity);
+		}
+
+		void Remove(entt::entity entity)
+		{
+			if (m_Entities.has(entity))
+				m_Entities.destroy(entity);
+		}
+
+		entt::registry* m_Registry = nullptr;
+		entt::sparse_set<entt::entity> m_Entities;
+		entt::sparse_set<entt::entity> m_Consuming;
+	};
+}
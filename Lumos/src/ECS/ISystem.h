@@ -6,6 +6,84 @@ namespace Lumos
 {
 	class TimeStep;
 
+	//Components a system reads and writes during OnUpdate, by type.
+	//Write<T, With, Without>() narrows a write to entities that have a With component and no Without component.
+	//An entity can have both body components, so two writes of T only run alongside each other when one of them
+	//skips the entities the other writes.
+	class LUMOS_EXPORT SystemAccess
+	{
+	public:
+		template<typename T>
+		SystemAccess& Read()
+		{
+			m_Entries.push_back({ typeid(T).hash_code(), 0, 0, false });
+			return *this;
+		}
+
+		template<typename T>
+		SystemAccess& Write()
+		{
+			m_Entries.push_back({ typeid(T).hash_code(), 0, 0, true });
+			return *this;
+		}
+
+		template<typename T, typename With>
+		SystemAccess& Write()
+		{
+			m_Entries.push_back({ typeid(T).hash_code(), typeid(With).hash_code(), 0, true });
+			return *this;
+		}
+
+		template<typename T, typename With, typename Without>
+		SystemAccess& Write()
+		{
+			m_Entries.push_back({ typeid(T).hash_code(), typeid(With).hash_code(), typeid(Without).hash_code(), true });
+			return *this;
+		}
+
+		//Conflicts with every other system
+		SystemAccess& WriteAll()
+		{
+			m_All = true;
+			return *this;
+		}
+
+		bool ConflictsWith(const SystemAccess& other) const
+		{
+			if (m_All || other.m_All)
+				return true;
+
+			for (auto& entry : m_Entries)
+			{
+				for (auto& otherEntry : other.m_Entries)
+				{
+					if (entry.type != otherEntry.type || (!entry.write && !otherEntry.write))
+						continue;
+
+					// Disjoint when one only touches entities the other excludes
+					if ((entry.with != 0 && entry.with == otherEntry.without) || (otherEntry.with != 0 && otherEntry.with == entry.without))
+						continue;
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+	private:
+		struct Entry
+		{
+			size_t type;
+			size_t with;
+			size_t without;
+			bool write;
+		};
+
+		std::vector<Entry> m_Entries;
+		bool m_All = false;
+	};
+
 	class LUMOS_EXPORT ISystem
 	{
 	public:
@@ -15,6 +93,17 @@ namespace Lumos
 		virtual void OnInit() = 0;
 		virtual void OnUpdate(TimeStep* dt, Scene* scene) = 0;
 		virtual void OnImGui() = 0;
+
+		//Called by the SystemManager on its own thread before the first update with a scene, whether or not the system
+		//is paused, and again when systems are added. Create registry pools, groups and signal connections here,
+		//OnUpdate may run alongside other systems. Must be safe to call again for the same scene.
+		virtual void OnSceneAttach(Scene* scene) {}
+
+		//Called when the scene is cleaned up, undoes OnSceneAttach
+		virtual void OnSceneDetach(Scene* scene) {}
+
+		//Systems that don't declare their access never run alongside another system
+		virtual void DeclareAccess(SystemAccess& access) const { access.WriteAll(); }
         
         _FORCE_INLINE_ const String& GetName() const { return m_DebugName; }
 
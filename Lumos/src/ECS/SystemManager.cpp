@@ -0,0 +1,132 @@
+#include "lmpch.h"
+#include "SystemManager.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+#include "Utilities/Timer.h"
+
+namespace Lumos
+{
+	void SystemManager::AddSystem(size_t typeName, const Ref<ISystem>& system)
+	{
+		m_Systems.push_back(system);
+		m_SystemTypes.push_back(typeName);
+		RebuildIndices();
+	}
+
+	void SystemManager::RebuildIndices()
+	{
+		m_SystemIndices.clear();
+		for (u32 i = 0; i < m_SystemTypes.size(); i++)
+			m_SystemIndices[m_SystemTypes[i]] = i;
+
+		m_UpdateTimes.assign(m_Systems.size(), 0.0f);
+		m_ScheduleDirty = true;
+	}
+
+	void SystemManager::BuildSchedule()
+	{
+		const u32 systemCount = static_cast<u32>(m_Systems.size());
+
+		std::vector<SystemAccess> access(systemCount);
+		for (u32 i = 0; i < systemCount; i++)
+			m_Systems[i]->DeclareAccess(access[i]);
+
+		// A system runs one stage after the latest earlier system it conflicts with
+		std::vector<u32> stages(systemCount, 0);
+		u32 stageCount = 0;
+		for (u32 i = 0; i < systemCount; i++)
+		{
+			for (u32 j = 0; j < i; j++)
+			{
+				if (access[i].ConflictsWith(access[j]))
+					stages[i] = Maths::Max(stages[i], stages[j] + 1);
+			}
+
+			stageCount = Maths::Max(stageCount, stages[i] + 1);
+		}
+
+		m_StageSystems.clear();
+		m_StageOffsets.clear();
+		for (u32 stage = 0; stage < stageCount; stage++)
+		{
+			m_StageOffsets.push_back(static_cast<u32>(m_StageSystems.size()));
+			for (u32 i = 0; i < systemCount; i++)
+			{
+				if (stages[i] == stage)
+					m_StageSystems.push_back(i);
+			}
+		}
+		m_StageOffsets.push_back(static_cast<u32>(m_StageSystems.size()));
+
+		m_ScheduleDirty = false;
+	}
+
+	void SystemManager::AttachScene(Scene* scene)
+	{
+		if (m_AttachedScene && m_AttachedScene != scene)
+			DetachScene(m_AttachedScene);
+
+		for (auto& system : m_Systems)
+			system->OnSceneAttach(scene);
+
+		m_AttachedScene = scene;
+	}
+
+	void SystemManager::DetachScene(Scene* scene)
+	{
+		if (m_AttachedScene != scene)
+			return;
+
+		for (auto& system : m_Systems)
+			system->OnSceneDetach(scene);
+
+		m_AttachedScene = nullptr;
+	}
+
+	void SystemManager::OnUpdate(TimeStep* dt, Scene* scene)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		// Registry pools, groups and signal connections aren't safe to create while other systems update
+		if (scene && (scene != m_AttachedScene || m_ScheduleDirty))
+			AttachScene(scene);
+
+		if (m_ScheduleDirty)
+			BuildSchedule();
+
+		if (!m_Parallel)
+		{
+			for (u32 i = 0; i < m_Systems.size(); i++)
+				UpdateSystem(i, dt, scene);
+
+			return;
+		}
+
+		for (u32 stage = 0; stage + 1 < m_StageOffsets.size(); stage++)
+		{
+			const u32 first = m_StageOffsets[stage];
+			const u32 count = m_StageOffsets[stage + 1] - first;
+
+			if (count == 1)
+			{
+				UpdateSystem(m_StageSystems[first], dt, scene);
+				continue;
+			}
+
+			System::JobSystem::Context context;
+			System::JobSystem::Dispatch(context, count, 1, [&](JobDispatchArgs args)
+			{
+				UpdateSystem(m_StageSystems[first + args.jobIndex], dt, scene);
+			});
+
+			System::JobSystem::Wait(context);
+		}
+	}
+
+	void SystemManager::UpdateSystem(u32 index, TimeStep* dt, Scene* scene)
+	{
+		const TimeStamp start = Timer::Now();
+		m_Systems[index]->OnUpdate(dt, scene);
+		m_UpdateTimes[index] = Timer::Duration(start, Timer::Now(), 1000.0f);
+	}
+}
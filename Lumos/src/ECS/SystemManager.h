@@ -4,7 +4,10 @@
 
 namespace Lumos
 {
-    class SystemManager
+	//Runs systems in registration order. Systems whose declared access doesn't conflict run at the same time on the
+	//job system: each system goes in the first stage after every earlier system it conflicts with, and the stages
+	//run one after the other, so the order of conflicting systems never changes between runs.
+    class LUMOS_EXPORT SystemManager
     {
     public:
 
@@ -12,12 +15,12 @@ namespace Lumos
         Ref<T> RegisterSystem(Args&& ...args)
         {
 			auto typeName = typeid(T).hash_code();
-            
-            LUMOS_ASSERT(m_Systems.find(typeName) == m_Systems.end(), "Registering system more than once.");
-            
+
+            LUMOS_ASSERT(m_SystemIndices.find(typeName) == m_SystemIndices.end(), "Registering system more than once.");
+
             // Create a pointer to the system and return it so it can be used externally
             Ref<T> system = CreateRef<T>(std::forward<Args>(args) ...);
-            m_Systems.insert({typeName, std::move( system) });
+			AddSystem(typeName, system);
             return system;
         }
 
@@ -26,60 +29,85 @@ namespace Lumos
 		{
 			auto typeName = typeid(T).hash_code();
 
-			LUMOS_ASSERT(m_Systems.find(typeName) == m_Systems.end(), "Registering system more than once.");
+			LUMOS_ASSERT(m_SystemIndices.find(typeName) == m_SystemIndices.end(), "Registering system more than once.");
 
 			// Create a pointer to the system and return it so it can be used externally
             Ref<T> system = Ref<T>(t);
-            m_Systems.insert({ typeName,std::move( system) });
+			AddSystem(typeName, system);
 			return system;
 		}
 
 		template<typename T>
 		void RemoveSystem()
 		{
-			auto typeName = typeid(T).hash_code();
+			auto it = m_SystemIndices.find(typeid(T).hash_code());
 
-			if (m_Systems.find(typeName) != m_Systems.end())
+			if (it != m_SystemIndices.end())
 			{
-				m_Systems.erase(typeName);
+				m_Systems.erase(m_Systems.begin() + it->second);
+				m_SystemTypes.erase(m_SystemTypes.begin() + it->second);
+				RebuildIndices();
 			}
 		}
 
 		template<typename T>
 		T* GetSystem()
 		{
-			auto typeName = typeid(T).hash_code();
+			auto it = m_SystemIndices.find(typeid(T).hash_code());
 
-			if (m_Systems.find(typeName) != m_Systems.end())
-			{
-				return dynamic_cast<T*>(m_Systems[typeName].get());
-			}
+			// Systems are keyed by their registered type, no cast check needed
+			if (it != m_SystemIndices.end())
+				return static_cast<T*>(m_Systems[it->second].get());
 
 			return nullptr;
 		}
 
 		template<typename T>
-		T* HasSystem()
+		bool HasSystem()
 		{
-			auto typeName = typeid(T).hash_code();
-
-			return m_Systems.find(typeName) != m_Systems.end();
+			return m_SystemIndices.find(typeid(T).hash_code()) != m_SystemIndices.end();
 		}
 
-		void OnUpdate(TimeStep* dt, Scene* scene)
-		{
-			for (auto& system : m_Systems)
-				system.second->OnUpdate(dt, scene);
-		}
+		void OnUpdate(TimeStep* dt, Scene* scene);
+
+		//Scenes detach before they are cleaned up, the next update with the scene attaches the systems again
+		void DetachScene(Scene* scene);
 
 		void OnImGui()
 		{
 			for (auto& system : m_Systems)
-				system.second->OnImGui();
+				system->OnImGui();
 		}
 
+		//Serial updates run every system on the calling thread in registration order
+		bool IsParallel() const { return m_Parallel; }
+		void SetParallel(bool parallel) { m_Parallel = parallel; }
+
+		u32 GetStageCount() const { return static_cast<u32>(m_StageOffsets.empty() ? 0 : m_StageOffsets.size() - 1); }
+
+		u32 GetSystemCount() const { return static_cast<u32>(m_Systems.size()); }
+		ISystem* GetSystemAt(u32 index) const { return m_Systems[index].get(); }
+
+		//Milliseconds the system at a registration index spent in the last OnUpdate
+		float GetLastUpdateTime(u32 index) const { return m_UpdateTimes[index]; }
+
     private:
-        // Map from system type string pointer to a system pointer
-        std::unordered_map<size_t, Ref<ISystem>> m_Systems;
+		void AddSystem(size_t typeName, const Ref<ISystem>& system);
+		void RebuildIndices();
+		void BuildSchedule();
+		void AttachScene(Scene* scene);
+		void UpdateSystem(u32 index, TimeStep* dt, Scene* scene);
+
+		std::vector<Ref<ISystem>> m_Systems;	// In registration order
+		std::vector<size_t>		  m_SystemTypes;
+		std::unordered_map<size_t, u32> m_SystemIndices;	// Type hash -> index into m_Systems
+
+		std::vector<u32> m_StageSystems;	// Indices into m_Systems grouped by stage
+		std::vector<u32> m_StageOffsets;	// First entry of each stage in m_StageSystems, plus the total
+		std::vector<float> m_UpdateTimes;	// By registration index, each system only writes its own
+
+		bool   m_Parallel = true;
+		bool   m_ScheduleDirty = true;
+		Scene* m_AttachedScene = nullptr;
     };
 }
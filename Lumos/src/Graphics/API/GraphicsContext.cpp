@@ -13,6 +13,7 @@
 #include "Graphics/DirectX/DXContext.h"
 #include "Graphics/DirectX/DXFunctions.h"
 #endif
+#include "Platform/Headless/RenderAPINone.h"
 
 namespace Lumos
 {
@@ -62,6 +63,10 @@ namespace Lumos
 				Graphics::DIRECT3D::MakeDefault();
 				break;
 #endif
+
+			case RenderAPI::NONE:
+				Graphics::None::MakeDefault();
+				break;
 			}
 		}
 	}
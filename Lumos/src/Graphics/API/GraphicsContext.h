@@ -13,7 +13,7 @@ namespace Lumos
 			VULKAN,
 			DIRECT3D, //Unsupported
 			METAL, //Unsupported
-			NONE, //Unsupported
+			NONE, //No rendering, runs without a window or GPU
 		};
 
 		class LUMOS_EXPORT GraphicsContext
@@ -0,0 +1,119 @@
+#include "lmpch.h"
+#include "RenderSnapshot.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/Material.h"
+#include "Graphics/Camera/Camera.h"
+#include "App/Scene.h"
+#include "Maths/Transform.h"
+#include "ECS/Component/Components.h"
+#include "Core/Profiler.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		RenderSnapshot::RenderSnapshot() = default;
+
+		RenderSnapshot::~RenderSnapshot() = default;
+
+		void RenderSnapshot::Capture(Scene* scene)
+		{
+			LUMOS_PROFILE_FUNC;
+
+			// Releases the previous frame's references, capacity is kept
+			Clear();
+			m_Frame++;
+
+			auto camera = scene->GetCamera();
+			m_HasCamera = camera != nullptr;
+			if (camera)
+			{
+				m_ViewMatrix = camera->GetViewMatrix();
+				m_ProjectionMatrix = camera->GetProjectionMatrix();
+				m_Frustum = camera->GetFrustum();
+				m_CameraPosition = camera->GetPosition();
+				m_Near = camera->GetNear();
+				m_Far = camera->GetFar();
+			}
+
+			auto& registry = scene->GetRegistry();
+
+			// Captured on the main thread while no update runs, so the dirty set is never touched concurrently
+			if (!m_ChangedTransforms.IsConnected())
+				m_ChangedTransforms.Connect(registry);
+
+			m_ChangedTransforms.Consume([&](entt::entity entity, Maths::Transform& trans)
+			{
+				if (auto mesh = registry.try_get<MeshComponent>(entity))
+					mesh->UpdateWorldBoundingBox(trans);
+			});
+
+			auto meshes = registry.group<MeshComponent>(entt::get<Maths::Transform>);
+			m_Meshes.reserve(meshes.size());
+			for (auto entity : meshes)
+			{
+				const auto &[mesh, trans] = meshes.get<MeshComponent, Maths::Transform>(entity);
+				if (!mesh.GetMesh() || !mesh.GetMesh()->GetActive())
+					continue;
+
+				MeshInstance& instance = m_Meshes.emplace_back();
+				instance.mesh = mesh.GetMeshRef();
+				instance.materialActive = false;
+				instance.transform = trans.GetWorldMatrix();
+				instance.bounds = mesh.GetWorldBoundingBox(trans);
+
+				if (auto material = registry.try_get<MaterialComponent>(entity))
+				{
+					instance.material = material->GetMaterial();
+					instance.materialActive = material->GetActive();
+				}
+
+				if (auto textureMatrix = registry.try_get<TextureMatrixComponent>(entity))
+					instance.textureMatrix = textureMatrix->GetMatrix();
+			}
+
+			auto lights = registry.group<Graphics::Light>(entt::get<Maths::Transform>);
+			m_Lights.reserve(lights.size());
+			for (auto entity : lights)
+			{
+				const auto &[light, trans] = lights.get<Graphics::Light, Maths::Transform>(entity);
+
+				LightInstance& instance = m_Lights.emplace_back();
+				instance.entity = entity;
+				instance.light = light;
+
+				if (light.m_Type != float(LightType::DirectionalLight))
+					instance.light.m_Position = trans.GetWorldPosition();
+
+				instance.light.m_Direction = (trans.GetWorldOrientation() * Maths::Vector3::FORWARD).Normalized();
+			}
+
+			auto sprites = registry.group<Graphics::Sprite>(entt::get<Maths::Transform>);
+			m_Sprites.reserve(sprites.size());
+			for (auto entity : sprites)
+			{
+				const auto &[sprite, trans] = sprites.get<Graphics::Sprite, Maths::Transform>(entity);
+				m_Sprites.push_back({ sprite, trans.GetWorldMatrix() });
+			}
+		}
+
+		void RenderSnapshot::Clear()
+		{
+			m_Meshes.clear();
+			m_Lights.clear();
+			m_Sprites.clear();
+			m_HasCamera = false;
+		}
+
+		const Light* RenderSnapshot::FindLight(entt::entity entity) const
+		{
+			for (auto& instance : m_Lights)
+			{
+				if (instance.entity == entity)
+					return &instance.light;
+			}
+
+			return nullptr;
+		}
+	}
+}
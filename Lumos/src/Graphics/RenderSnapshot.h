@@ -0,0 +1,93 @@
+#pragma once
+#include "lmpch.h"
+#include "Maths/Maths.h"
+#include "Maths/BoundingBox.h"
+#include "Maths/Frustum.h"
+#include "Maths/Transform.h"
+#include "Graphics/Light.h"
+#include "Graphics/Sprite.h"
+
+#include "ECS/DirtySet.h"
+
+#include <entt/entt.hpp>
+
+namespace Lumos
+{
+	class Scene;
+	class Material;
+
+	namespace Graphics
+	{
+		class Mesh;
+
+		//Copy of everything the renderers read from a scene while recording a frame. Captured once the frame's update
+		//is done, so recording only reads this and can run while the next update changes the scene.
+		//Meshes, materials and sprite textures are held by reference, so they outlive entities destroyed meanwhile.
+		class LUMOS_EXPORT RenderSnapshot
+		{
+		public:
+			struct MeshInstance
+			{
+				Ref<Mesh> mesh;
+				Ref<Material> material;
+				bool materialActive;
+				Maths::Matrix4 transform;
+				Maths::Matrix4 textureMatrix;
+				Maths::BoundingBox bounds;		// World space
+			};
+
+			struct LightInstance
+			{
+				entt::entity entity;
+				Light light;					// Position and direction in world space
+			};
+
+			struct SpriteInstance
+			{
+				Sprite sprite;
+				Maths::Matrix4 transform;
+			};
+
+			//Defined where Mesh and Material are complete, the instances release their references
+			RenderSnapshot();
+			~RenderSnapshot();
+
+			void Capture(Scene* scene);
+			void Clear();
+
+			const std::vector<MeshInstance>& GetMeshes() const { return m_Meshes; }
+			const std::vector<LightInstance>& GetLights() const { return m_Lights; }
+			const std::vector<SpriteInstance>& GetSprites() const { return m_Sprites; }
+
+			//Null if the entity has no light or wasn't captured
+			const Light* FindLight(entt::entity entity) const;
+
+			bool HasCamera() const { return m_HasCamera; }
+			const Maths::Matrix4& GetViewMatrix() const { return m_ViewMatrix; }
+			const Maths::Matrix4& GetProjectionMatrix() const { return m_ProjectionMatrix; }
+			const Maths::Frustum& GetFrustum() const { return m_Frustum; }
+			const Maths::Vector3& GetCameraPosition() const { return m_CameraPosition; }
+			float GetNear() const { return m_Near; }
+			float GetFar() const { return m_Far; }
+
+			u64 GetFrame() const { return m_Frame; }
+
+		private:
+			DirtySet<Maths::Transform> m_ChangedTransforms;	// Since the last capture, their mesh bounds are recomputed
+
+			std::vector<MeshInstance> m_Meshes;
+			std::vector<LightInstance> m_Lights;
+			std::vector<SpriteInstance> m_Sprites;
+
+			bool m_HasCamera = false;
+			Maths::Matrix4 m_ViewMatrix;
+			Maths::Matrix4 m_ProjectionMatrix;
+			Maths::Frustum m_Frustum;
+			Maths::Vector3 m_CameraPosition;
+			float m_Near = 0.0f;
+			float m_Far = 0.0f;
+
+			u64 m_Frame = 0;
+		};
+	}
+}
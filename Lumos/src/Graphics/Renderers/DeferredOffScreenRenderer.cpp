@@ -2,9 +2,6 @@
 #include "DeferredOffScreenRenderer.h"
 #include "App/Scene.h"
 #include "App/Application.h"
-#include "ECS/Component/MaterialComponent.h"
-#include "ECS/Component/MeshComponent.h"
-#include "ECS/Component/TextureMatrixComponent.h"
 
 #include "Maths/Maths.h"
 #include "Maths/Transform.h"
@@ -12,6 +9,7 @@
 
 #include "Graphics/RenderManager.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 #include "Graphics/Mesh.h"
 #include "Graphics/Material.h"
 #include "Graphics/GBuffer.h"
@@ -155,45 +153,23 @@ namespace Lumos
 
 			Begin();
 
-            auto& registry = scene->GetRegistry();
-            
-            auto group = registry.group<MeshComponent>(entt::get<Maths::Transform>);
-
-            for(auto entity : group)
+            for (auto& instance : scene->GetRenderSnapshot().GetMeshes())
             {
-                const auto &[mesh, trans] = group.get<MeshComponent, Maths::Transform>(entity);
+				auto inside = m_Frustum.IsInsideFast(instance.bounds);
+
+                if (inside == Maths::Intersection::OUTSIDE)
+					continue;
 
-                if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
+                Material* material = nullptr;
+                if (instance.material && instance.materialActive)
                 {
-                    auto& worldTransform = trans.GetWorldMatrix();
-
-					auto bb = mesh.GetMesh()->GetBoundingBox();
-                    auto bbCopy = bb->Transformed(worldTransform);
-					auto inside = m_Frustum.IsInsideFast(bbCopy);
-
-                    if (inside == Maths::Intersection::OUTSIDE)
-						continue;
-
-                    auto meshPtr = mesh.GetMesh();
-                    auto materialComponent = registry.try_get<MaterialComponent>(entity);
-                    Material* material = nullptr;
-                    if (materialComponent && materialComponent->GetActive() && materialComponent->GetMaterial())
-                    {
-                        material = materialComponent->GetMaterial().get();
-
-                        if (material->GetDescriptorSet() == nullptr || material->GetPipeline() != m_Pipeline)
-                            material->CreateDescriptorSet(m_Pipeline, 1);
-                    }
-
-                    auto textureMatrixTransform = registry.try_get<TextureMatrixComponent>(entity);
-                    Maths::Matrix4 textureMatrix;
-                    if (textureMatrixTransform)
-                        textureMatrix = textureMatrixTransform->GetMatrix();
-                    else
-                        textureMatrix = Maths::Matrix4();
-
-                    SubmitMesh(meshPtr, material, worldTransform, textureMatrix);
+                    material = instance.material.get();
+
+                    if (material->GetDescriptorSet() == nullptr || material->GetPipeline() != m_Pipeline)
+                        material->CreateDescriptorSet(m_Pipeline, 1);
                 }
+
+                SubmitMesh(instance.mesh.get(), material, instance.transform, instance.textureMatrix);
 			}
 
 			SetSystemUniforms(m_Shader);
@@ -221,12 +197,12 @@ namespace Lumos
 
 		void DeferredOffScreenRenderer::BeginScene(Scene* scene)
 		{
-			auto camera = scene->GetCamera();
+			auto& snapshot = scene->GetRenderSnapshot();
 
-			auto projView = camera->GetProjectionMatrix() * camera->GetViewMatrix();
+			auto projView = snapshot.GetProjectionMatrix() * snapshot.GetViewMatrix();
 			memcpy(m_VSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_ProjectionViewMatrix], &projView, sizeof(Maths::Matrix4));
 
-            m_Frustum = camera->GetFrustum();
+            m_Frustum = snapshot.GetFrustum();
 		}
 
 		void DeferredOffScreenRenderer::Submit(const RenderCommand& command)
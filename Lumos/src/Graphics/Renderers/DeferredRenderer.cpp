@@ -11,6 +11,7 @@
 
 #include "Graphics/RenderManager.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 #include "Graphics/Mesh.h"
 #include "Graphics/MeshFactory.h"
 #include "Graphics/Material.h"
@@ -235,45 +236,37 @@ namespace Lumos
 		{
 			LUMOS_PROFILE_FUNC;
 
-            auto& registry = scene->GetRegistry();
-                      
-            auto group = registry.group<Graphics::Light>(entt::get<Maths::Transform>);
+            auto& snapshot = scene->GetRenderSnapshot();
 
             u32 numLights = 0;
 
-			auto& frustum = scene->GetCamera()->GetFrustum();
+			auto& frustum = snapshot.GetFrustum();
 			
-			for(auto entity : group)
+			// Positions and directions were taken from the light transforms when the snapshot was captured
+			for (auto& instance : snapshot.GetLights())
 			{
-				const auto &[light, trans] = group.get<Graphics::Light, Maths::Transform>(entity);
+				const Light& light = instance.light;
 
 				if (light.m_Type != float(LightType::DirectionalLight))
 				{
-                    light.m_Position = trans.GetWorldPosition();
-
 					auto inside = frustum.IsInsideFast(Maths::Sphere(light.m_Position.ToVector3(), light.m_Radius));
 
 					if (inside == Maths::Intersection::OUTSIDE)
 						continue;
 				}
 
-				Maths::Vector3 forward = Maths::Vector3::FORWARD;
-				forward = trans.GetWorldOrientation() * forward;
-
-				light.m_Direction = forward.Normalized();
-
 				memcpy(m_PSSystemUniformBuffer + m_PSSystemUniformBufferOffsets[PSSystemUniformIndex_Lights] + sizeof(Graphics::Light) * numLights, &light, sizeof(Graphics::Light));
 				numLights++;
 			}
             
-            Maths::Vector4 cameraPos = Maths::Vector4(scene->GetCamera()->GetPosition());
+            Maths::Vector4 cameraPos = Maths::Vector4(snapshot.GetCameraPosition());
             memcpy(m_PSSystemUniformBuffer + m_PSSystemUniformBufferOffsets[PSSystemUniformIndex_CameraPosition], &cameraPos, sizeof(Maths::Vector4));
             
             auto shadowRenderer = Application::Instance()->GetRenderManager()->GetShadowRenderer();
             if (shadowRenderer)
             {
                 Maths::Matrix4* shadowTransforms = shadowRenderer->GetShadowProjView();
-                auto viewMat = scene->GetCamera()->GetViewMatrix();
+                auto viewMat = snapshot.GetViewMatrix();
                 Lumos::Maths::Vector4* uSplitDepth = shadowRenderer->GetSplitDepths();
                 
                 memcpy(m_PSSystemUniformBuffer + m_PSSystemUniformBufferOffsets[PSSystemUniformIndex_ViewMatrix], &viewMat, sizeof(Maths::Matrix4));
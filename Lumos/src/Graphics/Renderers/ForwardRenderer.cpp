@@ -15,15 +15,13 @@
 #include "Graphics/API/GraphicsContext.h"
 #include "Graphics/GBuffer.h"
 #include "App/Scene.h"
-#include "ECS/Component/MaterialComponent.h"
-#include "ECS/Component/MeshComponent.h"
-#include "ECS/Component/TextureMatrixComponent.h"
 #include "Maths/Maths.h"
 #include "Maths/Transform.h"
 
 #include "App/Application.h"
 #include "Graphics/RenderManager.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 
 namespace Lumos
 {
@@ -74,45 +72,23 @@ namespace Lumos
 
 				Begin();
 
-                auto& registry = scene->GetRegistry();
-                
-                auto group = registry.group<MeshComponent>(entt::get<Maths::Transform>);
-
-                for(auto entity : group)
+                for (auto& instance : scene->GetRenderSnapshot().GetMeshes())
                 {
-                    const auto &[mesh, trans] = group.get<MeshComponent, Maths::Transform>(entity);
+					auto inside = m_Frustum.IsInsideFast(instance.bounds);
+
+					if (inside == Maths::Intersection::OUTSIDE)
+						continue;
 
-                    if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
+                    Material* material = nullptr;
+                    if (instance.material /* && instance.materialActive*/)
                     {
-                        auto& worldTransform = trans.GetWorldMatrix();
-
-						auto bb = mesh.GetMesh()->GetBoundingBox();
-						auto bbCopy = bb->Transformed(worldTransform);
-						auto inside = m_Frustum.IsInsideFast(bbCopy);
-
-						if (inside == Maths::Intersection::OUTSIDE)
-							continue;
-
-                        auto meshPtr = mesh.GetMesh();
-                        auto materialComponent = registry.try_get<MaterialComponent>(entity);
-                        Material* material = nullptr;
-                        if (materialComponent && /* materialComponent->GetActive() &&*/ materialComponent->GetMaterial())
-                        {
-                            material = materialComponent->GetMaterial().get();
-
-                            if (material->GetDescriptorSet() == nullptr || material->GetPipeline() != m_Pipeline)
-                                material->CreateDescriptorSet(m_Pipeline, 1, false);
-                        }
-
-                        auto textureMatrixTransform = registry.try_get<TextureMatrixComponent>(entity);
-                        Maths::Matrix4 textureMatrix;
-                        if (textureMatrixTransform)
-                            textureMatrix = textureMatrixTransform->GetMatrix();
-                        else
-                            textureMatrix = Maths::Matrix4();
-
-                        SubmitMesh(meshPtr, material, worldTransform, textureMatrix);
+                        material = instance.material.get();
+
+                        if (material->GetDescriptorSet() == nullptr || material->GetPipeline() != m_Pipeline)
+                            material->CreateDescriptorSet(m_Pipeline, 1, false);
                     }
+
+                    SubmitMesh(instance.mesh.get(), material, instance.transform, instance.textureMatrix);
                 }
 
 				SetSystemUniforms(m_Shader);
@@ -271,13 +247,12 @@ namespace Lumos
 
 		void ForwardRenderer::BeginScene(Scene* scene)
 		{
-			auto camera = scene->GetCamera();
-			auto proj = camera->GetProjectionMatrix();
+			auto& snapshot = scene->GetRenderSnapshot();
 
-			memcpy(m_VSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_ProjectionMatrix], &proj, sizeof(Maths::Matrix4));
-			memcpy(m_VSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_ViewMatrix], &camera->GetViewMatrix(), sizeof(Maths::Matrix4));
+			memcpy(m_VSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_ProjectionMatrix], &snapshot.GetProjectionMatrix(), sizeof(Maths::Matrix4));
+			memcpy(m_VSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_ViewMatrix], &snapshot.GetViewMatrix(), sizeof(Maths::Matrix4));
 
-			m_Frustum = camera->GetFrustum();
+			m_Frustum = snapshot.GetFrustum();
 
 		}
 
@@ -16,6 +16,7 @@
 #include "App/Scene.h"
 #include "App/Application.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 
 #include <imgui/imgui.h>
 
@@ -149,16 +150,15 @@ namespace Lumos
 
 		void GridRenderer::BeginScene(Scene* scene)
 		{
-			auto camera = scene->GetCamera();
-			auto proj = camera->GetProjectionMatrix();
+			auto& snapshot = scene->GetRenderSnapshot();
 
 			UniformBufferObjectFrag test;
 			test.res = m_GridRes;
 			test.scale = m_GridSize;
-            test.cameraPos = scene->GetCamera()->GetPosition();
+            test.cameraPos = snapshot.GetCameraPosition();
             test.maxDistance = m_MaxDistance;
 
-			auto invViewProj = proj * camera->GetViewMatrix();
+			auto invViewProj = snapshot.GetProjectionMatrix() * snapshot.GetViewMatrix();
 			memcpy(m_VSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_InverseProjectionViewMatrix], &invViewProj, sizeof(Maths::Matrix4));
 			memcpy(m_PSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_InverseProjectionViewMatrix], &test, sizeof(UniformBufferObjectFrag));
 		}
@@ -19,6 +19,7 @@
 #include "Platform/OpenGL/GLDescriptorSet.h"
 #include "Graphics/Renderable2D.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 #include "Maths/Transform.h"
 #include "Core/Profiler.h"
 
@@ -249,12 +250,12 @@ namespace Lumos
 
 		void Renderer2D::BeginScene(Scene* scene)
 		{
-			auto camera = scene->GetCamera();
-			auto projView = camera->GetProjectionMatrix() * camera->GetViewMatrix();
+			auto& snapshot = scene->GetRenderSnapshot();
+			auto projView = snapshot.GetProjectionMatrix() * snapshot.GetViewMatrix();
 
 			memcpy(m_VSSystemUniformBuffer, &projView, sizeof(Maths::Matrix4));
             
-            m_Frustum = camera->GetFrustum();
+            m_Frustum = snapshot.GetFrustum();
 		}
 
 		void Renderer2D::Present()
@@ -312,21 +313,18 @@ namespace Lumos
 
 			SetSystemUniforms(m_Shader);
 			
-            auto& registry = scene->GetRegistry();
-            auto group = registry.group<Graphics::Sprite>(entt::get<Maths::Transform>);
-
-            for(auto entity: group)
+            for (auto& instance : scene->GetRenderSnapshot().GetSprites())
             {
-                const auto &[sprite, trans] = group.get<Graphics::Sprite, Maths::Transform>(entity);
-                
+                const Sprite& sprite = instance.sprite;
+
 				auto bb = Maths::BoundingBox(Maths::Rect(sprite.GetPosition(), sprite.GetPosition() + sprite.GetScale()));
-				bb.Transform(trans.GetWorldMatrix());
+				bb.Transform(instance.transform);
                 auto inside = m_Frustum.IsInside(bb);
                 
 				if (inside == Maths::Intersection::OUTSIDE)
 					continue;
                 
-                Submit(reinterpret_cast<Renderable2D*>(&sprite), trans.GetWorldMatrix());
+                Submit(const_cast<Renderable2D*>(static_cast<const Renderable2D*>(&sprite)), instance.transform);
             };
 
 			Present();
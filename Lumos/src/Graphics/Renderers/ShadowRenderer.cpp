@@ -13,6 +13,7 @@
 
 #include "Graphics/ModelLoader/ModelLoader.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 #include "Graphics/Light.h"
 
 #include "ECS/Component/MeshComponent.h"
@@ -210,9 +211,7 @@ namespace Lumos
 
 			Begin();
             
-            auto& registry = scene->GetRegistry();
-                                    
-            auto group = registry.group<MeshComponent>(entt::get<Maths::Transform>);
+            auto& meshes = scene->GetRenderSnapshot().GetMeshes();
             
 			for (u32 i = 0; i < m_ShadowMapNum; ++i)
 			{
@@ -221,23 +220,14 @@ namespace Lumos
 				Maths::Frustum f;
 				f.Define(m_ShadowProjView[i]);
 
-                for(auto entity : group)
+                for (auto& instance : meshes)
                 {
-                    const auto &[mesh, trans] = group.get<MeshComponent, Maths::Transform>(entity);
+					auto inside = f.IsInsideFast(instance.bounds);
 
-                    if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
-                    {
-                        auto& worldTransform = trans.GetWorldMatrix();
+					if (inside == Maths::Intersection::OUTSIDE)
+						continue;
 
-						auto bb = mesh.GetMesh()->GetBoundingBox();
-						auto bbCopy = bb->Transformed(worldTransform);
-						auto inside = f.IsInsideFast(bbCopy);
-
-						if (inside == Maths::Intersection::OUTSIDE)
-							continue;
-            
-                        SubmitMesh(mesh.GetMesh(), nullptr, worldTransform, Maths::Matrix4());
-					}
+                    SubmitMesh(instance.mesh.get(), nullptr, instance.transform, Maths::Matrix4());
                 }
 
 				SetSystemUniforms(m_Shader);
@@ -262,16 +252,17 @@ namespace Lumos
 			if (m_LightEntity == entt::null)
 				return;
 
-			Light* light = &scene->GetRegistry().get<Graphics::Light>(m_LightEntity);
+			// The snapshot light has its direction from the entity's transform
+			auto& snapshot = scene->GetRenderSnapshot();
+			const Light* light = snapshot.FindLight(m_LightEntity);
 
 			if (!light)
 				return;
 
 			float cascadeSplits[SHADOWMAP_MAX];
-			auto camera = scene->GetCamera();
 
-			float nearClip = camera->GetNear();
-			float farClip = camera->GetFar();
+			float nearClip = snapshot.GetNear();
+			float farClip = snapshot.GetFar();
 			float clipRange = farClip - nearClip;
 
 			float minZ = nearClip;
@@ -312,7 +303,7 @@ namespace Lumos
 					Maths::Vector3(-1.0f, -1.0f,  1.0f),
 				};
 
-				const Maths::Matrix4 invCam = Maths::Matrix4::Inverse(camera->GetProjectionMatrix() * camera->GetViewMatrix());
+				const Maths::Matrix4 invCam = Maths::Matrix4::Inverse(snapshot.GetProjectionMatrix() * snapshot.GetViewMatrix());
 
 				// Project frustum corners into world space
 				for (uint32_t j = 0; j < 8; j++)
@@ -358,7 +349,7 @@ namespace Lumos
 				Maths::Matrix4 lightOrthoMatrix = Maths::Matrix4::Orthographic(minExtents.x, maxExtents.x, minExtents.y, maxExtents.y, -(maxExtents.z - minExtents.z), maxExtents.z - minExtents.z);
 
 				// Store split distance and matrix in cascade
-				m_SplitDepth[i] = Maths::Vector4((camera->GetNear() + splitDist * clipRange) * -1.0f);
+				m_SplitDepth[i] = Maths::Vector4((nearClip + splitDist * clipRange) * -1.0f);
 				m_ShadowProjView[i] = lightOrthoMatrix * lightViewMatrix.Inverse();
 			}
 #ifdef THREAD_CASCADE_GEN
@@ -17,6 +17,7 @@
 #include "App/Scene.h"
 #include "App/Application.h"
 #include "Graphics/Camera/Camera.h"
+#include "Graphics/RenderSnapshot.h"
 
 #include <imgui/imgui.h>
 
@@ -142,8 +143,8 @@ namespace Lumos
 
 		void SkyboxRenderer::BeginScene(Scene* scene)
 		{
-			auto camera = scene->GetCamera();
-			auto invViewProj = Maths::Matrix4::Inverse(camera->GetProjectionMatrix() * camera->GetViewMatrix());
+			auto& snapshot = scene->GetRenderSnapshot();
+			auto invViewProj = Maths::Matrix4::Inverse(snapshot.GetProjectionMatrix() * snapshot.GetViewMatrix());
 			memcpy(m_VSSystemUniformBuffer + m_VSSystemUniformBufferOffsets[VSSystemUniformIndex_InverseProjectionViewMatrix], &invViewProj, sizeof(Maths::Matrix4));
 		}
 
@@ -42,6 +42,7 @@ namespace Lumos
 			m_LocalMatrix = Matrix4::Translation(m_LocalPosition) * m_LocalOrientation.RotationMatrix4() * Matrix4::Scale(m_LocalScale);
 			m_Dirty = false;
             m_HasUpdated = true;
+			++m_LocalVersion;
 		}
 
 		void Transform::ApplyTransform()
@@ -56,12 +57,14 @@ namespace Lumos
              if (m_Dirty)
                  UpdateMatrices();
              m_WorldMatrix =  mat * m_LocalMatrix;
+			 ++m_WorldVersion;
         }
         
         void Transform::SetLocalTransform(const Matrix4& localMat)
         {
             m_LocalMatrix		= localMat;
             m_HasUpdated		= true;
+			++m_LocalVersion;
 
 			ApplyTransform();
         }
@@ -16,6 +16,10 @@ namespace Lumos
 			~Transform();
 
             void SetWorldMatrix(const Matrix4& mat);
+
+			//Replaces the world matrix without touching the local one, for drawing poses between simulation ticks.
+			//The world version is left alone, the override is undone before the next tick so it never changes the pose.
+			void OverrideWorldMatrix(const Matrix4& world) { m_WorldMatrix = world; }
             
             void SetLocalTransform(const Matrix4& localMat);
 
@@ -39,6 +43,11 @@ namespace Lumos
 			bool HasUpdated() const { return m_HasUpdated; }
 			void SetHasUpdated(bool set) { m_HasUpdated = set; }
 
+			//Incremented every time the local / world matrix is rebuilt or set. Caches of anything derived from
+			//a matrix store the version they were built from and only rebuild when it differs.
+			u32 GetLocalVersion() const { return m_LocalVersion; }
+			u32 GetWorldVersion() const { return m_WorldVersion; }
+
 			//Sets R,T and S vectors from Local Matrix
 			void ApplyTransform();
 
@@ -48,12 +57,22 @@ namespace Lumos
 			{
 				nlohmann::json output;
 				output["typeID"] = LUMOS_TYPENAME(Transform);
+				output["position"] = { m_LocalPosition.x, m_LocalPosition.y, m_LocalPosition.z };
+				output["orientation"] = { m_LocalOrientation.w, m_LocalOrientation.x, m_LocalOrientation.y, m_LocalOrientation.z };
+				output["scale"] = { m_LocalScale.x, m_LocalScale.y, m_LocalScale.z };
 
 				return output;
 			};
 
 			void Deserialise(nlohmann::json& data)
 			{
+				const std::vector<float> position = data["position"].get<std::vector<float>>();
+				const std::vector<float> orientation = data["orientation"].get<std::vector<float>>();
+				const std::vector<float> scale = data["scale"].get<std::vector<float>>();
+
+				SetLocalPosition(Vector3(position.data()));
+				SetLocalOrientation(Quaternion(orientation[0], orientation[1], orientation[2], orientation[3]));
+				SetLocalScale(Vector3(scale.data()));
 			};
 
 		protected:
@@ -66,6 +85,9 @@ namespace Lumos
 
 			bool m_HasUpdated = false;
 			bool m_Dirty = false;
+
+			u32 m_LocalVersion = 0;
+			u32 m_WorldVersion = 0;
 		};
 	}
 }
@@ -3,8 +3,12 @@
 #include "PhysicsObject2D.h"
 
 #include "Utilities/TimeStep.h"
+#include "Utilities/Timer.h"
 #include "Core/Profiler.h"
+#include "Core/JobSystem.h"
 #include "ECS/Component/Physics2DComponent.h"
+#include "ECS/Component/Physics3DComponent.h"
+#include "ECS/DirtySet.h"
 
 #include "Maths/Transform.h"
 
@@ -16,11 +20,12 @@
 namespace Lumos
 {
 	B2PhysicsEngine::B2PhysicsEngine()
-		: m_B2DWorld(CreateScope<b2World>(b2Vec2(0.0f,-9.81f)))
+		: m_Budget(4, 8)
 		, m_UpdateTimestep(1.0f / 60.f)
         , m_UpdateAccum(0.0f)
 	{
         m_DebugName = "Box2D Physics Engine";
+		CreateWorld(Maths::Vector2(0.0f, -9.81f));
 	}
 
 	B2PhysicsEngine::~B2PhysicsEngine() = default;
@@ -34,45 +39,146 @@ namespace Lumos
 	void B2PhysicsEngine::OnUpdate(TimeStep* timeStep, Scene* scene)
 	{
 		LUMOS_PROFILE_FUNC;
-		const int max_updates_per_frame = 5;
 
 		if (!m_Paused)
 		{	
 			if(m_MultipleUpdates)
 			{
 				m_UpdateAccum += timeStep->GetMillis();
-				for (int i = 0; (m_UpdateAccum >= m_UpdateTimestep) && i < max_updates_per_frame; ++i)
-				{
-					m_UpdateAccum -= m_UpdateTimestep;
-					m_B2DWorld->Step(m_UpdateTimestep, 6, 2);
-				}
-
-				if (m_UpdateAccum >= m_UpdateTimestep)
-				{
-					Debug::Log::Error("Physics too slow to run in real time!");
-					//Drop Time in the hope that it can continue to run in real-time
-					m_UpdateAccum = 0.0f;
-				}
 
+				const u32 steps = m_Budget.BeginFrame(m_UpdateAccum, m_UpdateTimestep);
+				for (u32 i = 0; i < steps; ++i)
+					StepWorlds();
 			}
 			else
-				m_B2DWorld->Step(m_UpdateTimestep, 6, 2);
-            
-            auto& registry = scene->GetRegistry();
-            
-            auto group = registry.group<Physics2DComponent>(entt::get<Maths::Transform>);
-
-            for(auto entity : group)
-            {
-                const auto &[phys, trans] = group.get<Physics2DComponent, Maths::Transform>(entity);
-
-               // if (!phys.GetPhysicsObject()->GetB2Body()->IsAwake())
-               //     break;
-
-                trans.SetLocalPosition(Maths::Vector3(phys.GetPhysicsObject()->GetPosition(), 0.0f));
-				trans.SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(0.0f, 0.0f, phys.GetPhysicsObject()->GetAngle() * Maths::M_RADTODEG));
-                trans.SetWorldMatrix(Maths::Matrix4()); // temp
-            };
+				StepWorlds();
+
+			SyncTransforms(scene);
+		}
+	}
+
+	void B2PhysicsEngine::DeclareAccess(SystemAccess& access) const
+	{
+		access.Write<Physics2DComponent>();
+		// Entities that also have a 3D body take their transform from the 3D engine
+		access.Write<Maths::Transform, Physics2DComponent, Physics3DComponent>();
+		// Marking the transforms changed edits the dirty sets every Transform producer shares
+		access.Write<ComponentChanges<Maths::Transform>>();
+	}
+
+	void B2PhysicsEngine::OnSceneAttach(Scene* scene)
+	{
+		// The group SyncTransforms reads, created up front along with its pools
+		scene->GetRegistry().group<Physics2DComponent>(entt::get<Maths::Transform>, entt::exclude<Physics3DComponent>);
+	}
+
+	u32 B2PhysicsEngine::CreateWorld(const Maths::Vector2& gravity)
+	{
+		for (u32 i = 0; i < m_Worlds.size(); i++)
+		{
+			if (!m_Worlds[i])
+			{
+				m_Worlds[i] = CreateScope<b2World>(b2Vec2(gravity.x, gravity.y));
+				return i;
+			}
+		}
+
+		m_Worlds.push_back(CreateScope<b2World>(b2Vec2(gravity.x, gravity.y)));
+		return static_cast<u32>(m_Worlds.size() - 1);
+	}
+
+	void B2PhysicsEngine::DestroyWorld(u32 world)
+	{
+		if (world == 0 || world >= m_Worlds.size())
+		{
+			Debug::Log::Warning("Can't destroy 2D physics world {0}", world);
+			return;
+		}
+
+		// Bodies still in the world are freed with it, their PhysicsObject2D must be gone first
+		m_Worlds[world].reset();
+	}
+
+	void B2PhysicsEngine::StepWorlds()
+	{
+		LUMOS_PROFILE_FUNC;
+
+		// Keeps Box2D's default ratio of three velocity iterations to one position iteration
+		const u32 velocityIterations = m_Budget.GetSolverIterations();
+		const u32 positionIterations = Maths::Max(velocityIterations / 3, 1u);
+
+		if (m_Worlds.size() == 1)
+		{
+			m_Worlds[0]->Step(m_UpdateTimestep, velocityIterations, positionIterations);
+
+			const b2Profile& profile = m_Worlds[0]->GetProfile();
+			m_Budget.RecordStep(profile.step, profile.solveVelocity + profile.solvePosition, velocityIterations);
+			return;
+		}
+
+		const TimeStamp stepStart = Timer::Now();
+
+		// Worlds share no state, one job each
+		System::JobSystem::Dispatch(static_cast<u32>(m_Worlds.size()), 1, [&](JobDispatchArgs args)
+		{
+			if (m_Worlds[args.jobIndex])
+				m_Worlds[args.jobIndex]->Step(m_UpdateTimestep, velocityIterations, positionIterations);
+		});
+
+		System::JobSystem::Wait();
+
+		const float stepMs = Timer::Duration(stepStart, Timer::Now(), 1000.0f);
+
+		// The budget is spent in wall time, the solver gets the share it took of the summed world steps
+		float worldStepMs = 0.0f;
+		float worldSolverMs = 0.0f;
+		for (auto& world : m_Worlds)
+		{
+			if (!world)
+				continue;
+
+			const b2Profile& profile = world->GetProfile();
+			worldStepMs += profile.step;
+			worldSolverMs += profile.solveVelocity + profile.solvePosition;
+		}
+
+		const float solverMs = worldStepMs > 0.0f ? stepMs * worldSolverMs / worldStepMs : 0.0f;
+		m_Budget.RecordStep(stepMs, solverMs, velocityIterations);
+	}
+
+	void B2PhysicsEngine::SyncTransforms(Scene* scene)
+	{
+		LUMOS_PROFILE_FUNC;
+
+		auto& registry = scene->GetRegistry();
+		auto group = registry.group<Physics2DComponent>(entt::get<Maths::Transform>, entt::exclude<Physics3DComponent>);
+
+#ifdef LUMOS_ENABLE_ASSERTS
+		// A body created in another scene's engine would never move here
+		for (auto entity : group)
+		{
+			const b2Body* body = group.get<Physics2DComponent>(entity).GetPhysicsObject()->GetB2Body();
+			LUMOS_CORE_ASSERT(!body || OwnsWorld(body->GetWorld()), "2D body created without its scene's engine, set PhysicsObjectParamaters::engine");
+		}
+#endif
+
+		// Each job only writes the transform of its own entity
+		const entt::entity* entities = group.data();
+		System::JobSystem::Dispatch(static_cast<u32>(group.size()), 128, [&](JobDispatchArgs args)
+		{
+			const auto &[phys, trans] = group.get<Physics2DComponent, Maths::Transform>(entities[args.jobIndex]);
+
+			trans.SetLocalPosition(Maths::Vector3(phys.GetPhysicsObject()->GetPosition(), 0.0f));
+			trans.SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(0.0f, 0.0f, phys.GetPhysicsObject()->GetAngle() * Maths::M_RADTODEG));
+			trans.SetWorldMatrix(Maths::Matrix4()); // temp
+		});
+
+		System::JobSystem::Wait();
+
+		if (HasChangeListeners<Maths::Transform>(registry))
+		{
+			for (auto entity : group)
+				MarkChanged<Maths::Transform>(registry, entity);
 		}
 	}
 
@@ -84,11 +190,32 @@ namespace Lumos
 		ImGui::Columns(2);
 		ImGui::Separator();
 
+		i32 worldCount = 0;
+		i32 contactCount = 0;
+		i32 bodyCount = 0;
+		for (auto& world : m_Worlds)
+		{
+			if (!world)
+				continue;
+
+			worldCount++;
+			contactCount += world->GetContactCount();
+			bodyCount += world->GetBodyCount();
+		}
+
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Number Of Worlds");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::Text("%5.2i", worldCount);
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
 		ImGui::AlignTextToFramePadding();
 		ImGui::TextUnformatted("Number Of Collision Pairs");
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
-		ImGui::Text("%5.2i", m_B2DWorld->GetContactCount());
+		ImGui::Text("%5.2i", contactCount);
 		ImGui::PopItemWidth();
 		ImGui::NextColumn();
 
@@ -96,7 +223,7 @@ namespace Lumos
 		ImGui::TextUnformatted("Number Of Physics Objects");
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
-		ImGui::Text("%5.2i", m_B2DWorld->GetBodyCount());
+		ImGui::Text("%5.2i", bodyCount);
 		ImGui::PopItemWidth();
 		ImGui::NextColumn();
 
@@ -108,13 +235,21 @@ namespace Lumos
 		ImGui::PopItemWidth();
 		ImGui::NextColumn();
 
+		m_Budget.OnImGui();
+
 		ImGui::AlignTextToFramePadding();
 		ImGui::TextUnformatted("Gravity");
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
-		float grav[2] = { m_B2DWorld->GetGravity().x , m_B2DWorld->GetGravity().y };
+		float grav[2] = { m_Worlds[0]->GetGravity().x , m_Worlds[0]->GetGravity().y };
 		if (ImGui::InputFloat2("##Gravity", grav))
-			m_B2DWorld->SetGravity({ grav[0], grav[1] });
+		{
+			for (auto& world : m_Worlds)
+			{
+				if (world)
+					world->SetGravity({ grav[0], grav[1] });
+			}
+		}
 		ImGui::PopItemWidth();
 		ImGui::NextColumn();
 
@@ -123,9 +258,20 @@ namespace Lumos
 		ImGui::PopStyleVar();
 	}
 
-	b2Body* B2PhysicsEngine::CreateB2Body(b2BodyDef* bodyDef) const
+	b2Body* B2PhysicsEngine::CreateB2Body(b2BodyDef* bodyDef, u32 world) const
+	{
+		return m_Worlds[world]->CreateBody(bodyDef);
+	}
+
+	bool B2PhysicsEngine::OwnsWorld(const b2World* world) const
 	{
-		return m_B2DWorld->CreateBody(bodyDef); 
+		for (auto& ownWorld : m_Worlds)
+		{
+			if (ownWorld.get() == world)
+				return true;
+		}
+
+		return false;
 	}
 
 	void B2PhysicsEngine::CreateFixture(b2Body* body, const b2FixtureDef* fixtureDef)
@@ -2,6 +2,8 @@
 
 #include "Utilities/TSingleton.h"
 #include "ECS/ISystem.h"
+#include "Physics/PhysicsBudget.h"
+#include "Maths/Vector2.h"
 
 class b2World;
 class b2Body;
@@ -22,19 +24,36 @@ namespace Lumos
 		void SetDefaults();
 
 		void OnUpdate(TimeStep* timeStep, Scene* scene) override;
+		void DeclareAccess(SystemAccess& access) const override;
+		void OnSceneAttach(Scene* scene) override;
 		void OnInit() override {};
 		void OnImGui() override;
 
-		b2World* GetB2World() const { return m_B2DWorld.get(); }
-		b2Body* CreateB2Body(b2BodyDef* bodyDef) const;
+		//World 0 always exists and is used by bodies that don't ask for another one.
+		//Worlds are independent simulations (rooms, levels) and are stepped in parallel on the job system,
+		//so contact listeners set on them must only touch their own world.
+		u32 CreateWorld(const Maths::Vector2& gravity);
+		void DestroyWorld(u32 world);
+		u32 GetWorldCount() const { return static_cast<u32>(m_Worlds.size()); }
+
+		b2World* GetB2World(u32 world = 0) const { return m_Worlds[world].get(); }
+		b2Body* CreateB2Body(b2BodyDef* bodyDef, u32 world = 0) const;
+		bool OwnsWorld(const b2World* world) const;
 
 		static void CreateFixture(b2Body* body, const b2FixtureDef* fixtureDef);
 
 		void SetPaused(bool paused) { m_Paused = paused; }
 		bool IsPaused() const { return m_Paused; }
+
+		//Substeps per frame and velocity iterations per step are picked to fit its millisecond budget
+		PhysicsBudget& GetBudget() { return m_Budget; }
+
 	private:
+		void StepWorlds();
+		void SyncTransforms(Scene* scene);
 
-		Scope<b2World> m_B2DWorld;
+		std::vector<Scope<b2World>> m_Worlds;	//!< Destroyed worlds leave an empty slot so indices stay valid
+		PhysicsBudget m_Budget;
 
 		float m_UpdateTimestep, m_UpdateAccum;
 		bool m_Paused = true;
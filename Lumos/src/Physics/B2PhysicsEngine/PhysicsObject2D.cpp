@@ -23,7 +23,7 @@ namespace Lumos
 	PhysicsObject2D::~PhysicsObject2D()
 	{
 		if(m_B2Body)
-			Application::Instance()->GetSystem<B2PhysicsEngine>()->GetB2World()->DestroyBody(m_B2Body);
+			m_B2Body->GetWorld()->DestroyBody(m_B2Body);
 	}
 
 	void PhysicsObject2D::SetLinearVelocity(const Maths::Vector2& v) const
@@ -62,7 +62,8 @@ namespace Lumos
 			bodyDef.type = b2_dynamicBody;
 
 		bodyDef.position.Set(params.position.x, params.position.y);
-		m_B2Body = Application::Instance()->GetSystem<B2PhysicsEngine>()->CreateB2Body(&bodyDef);
+		B2PhysicsEngine* engine = params.engine ? params.engine : Application::Instance()->GetSystem<B2PhysicsEngine>();
+		m_B2Body = engine->CreateB2Body(&bodyDef, params.world);
 
 		if (params.shape == Shape::Circle)
 		{
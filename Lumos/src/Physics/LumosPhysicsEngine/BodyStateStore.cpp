@@ -0,0 +1,337 @@
+#include "lmpch.h"
+#include "BodyStateStore.h"
+#include "PhysicsObject3D.h"
+
+#ifdef Lumos_SSE
+#include <emmintrin.h>
+#endif
+
+namespace Lumos
+{
+	namespace
+	{
+		//Four bodies worth of one channel
+#ifdef Lumos_SSE
+		struct Lane
+		{
+			__m128 v;
+
+			static Lane Load(const float* data) { return { _mm_loadu_ps(data) }; }
+			static Lane Set(float value) { return { _mm_set1_ps(value) }; }
+			void Store(float* data) const { _mm_storeu_ps(data, v); }
+
+			Lane operator+(const Lane& rhs) const { return { _mm_add_ps(v, rhs.v) }; }
+			Lane operator-(const Lane& rhs) const { return { _mm_sub_ps(v, rhs.v) }; }
+			Lane operator*(const Lane& rhs) const { return { _mm_mul_ps(v, rhs.v) }; }
+
+			//1.0 where the lane is positive, 0.0 otherwise
+			Lane Positive() const { return { _mm_and_ps(_mm_cmpgt_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)) }; }
+			Lane InvSqrt() const { return { _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(v)) }; }
+
+			//a where mask is positive, b otherwise
+			static Lane Select(const Lane& mask, const Lane& a, const Lane& b)
+			{
+				const __m128 m = _mm_cmpgt_ps(mask.v, _mm_setzero_ps());
+				return { _mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v)) };
+			}
+		};
+#else
+		struct Lane
+		{
+			float v[BodyStateStore::LaneWidth];
+
+			static Lane Load(const float* data) { return { { data[0], data[1], data[2], data[3] } }; }
+			static Lane Set(float value) { return { { value, value, value, value } }; }
+			void Store(float* data) const { data[0] = v[0]; data[1] = v[1]; data[2] = v[2]; data[3] = v[3]; }
+
+			Lane operator+(const Lane& rhs) const { return { { v[0] + rhs.v[0], v[1] + rhs.v[1], v[2] + rhs.v[2], v[3] + rhs.v[3] } }; }
+			Lane operator-(const Lane& rhs) const { return { { v[0] - rhs.v[0], v[1] - rhs.v[1], v[2] - rhs.v[2], v[3] - rhs.v[3] } }; }
+			Lane operator*(const Lane& rhs) const { return { { v[0] * rhs.v[0], v[1] * rhs.v[1], v[2] * rhs.v[2], v[3] * rhs.v[3] } }; }
+
+			Lane Positive() const { return { { v[0] > 0.0f ? 1.0f : 0.0f, v[1] > 0.0f ? 1.0f : 0.0f, v[2] > 0.0f ? 1.0f : 0.0f, v[3] > 0.0f ? 1.0f : 0.0f } }; }
+			Lane InvSqrt() const { return { { 1.0f / sqrtf(v[0]), 1.0f / sqrtf(v[1]), 1.0f / sqrtf(v[2]), 1.0f / sqrtf(v[3]) } }; }
+
+			static Lane Select(const Lane& mask, const Lane& a, const Lane& b)
+			{
+				return { { mask.v[0] > 0.0f ? a.v[0] : b.v[0], mask.v[1] > 0.0f ? a.v[1] : b.v[1], mask.v[2] > 0.0f ? a.v[2] : b.v[2], mask.v[3] > 0.0f ? a.v[3] : b.v[3] } };
+			}
+		};
+#endif
+
+		struct LaneVector3
+		{
+			Lane x, y, z;
+
+			LaneVector3 operator+(const LaneVector3& rhs) const { return { x + rhs.x, y + rhs.y, z + rhs.z }; }
+			LaneVector3 operator*(const Lane& rhs) const { return { x * rhs, y * rhs, z * rhs }; }
+		};
+
+		struct LaneQuaternion
+		{
+			Lane w, x, y, z;
+		};
+
+		// q = q + (w * dt * 0.5) * q, normalised. Same as the scalar orientation update on PhysicsObject3D
+		_FORCE_INLINE_ void IntegrateOrientation(LaneQuaternion& q, const LaneVector3& angularVelocity, const Lane& halfDt)
+		{
+			const LaneVector3 v = angularVelocity * halfDt;
+
+			const Lane dw = Lane::Set(0.0f) - (q.x * v.x) - (q.y * v.y) - (q.z * v.z);
+			const Lane dx = (q.w * v.x) + (v.y * q.z) - (v.z * q.y);
+			const Lane dy = (q.w * v.y) + (v.z * q.x) - (v.x * q.z);
+			const Lane dz = (q.w * v.z) + (v.x * q.y) - (v.y * q.x);
+
+			q.w = q.w + dw;
+			q.x = q.x + dx;
+			q.y = q.y + dy;
+			q.z = q.z + dz;
+
+			const Lane invLength = (q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z).InvSqrt();
+			q.w = q.w * invLength;
+			q.x = q.x * invLength;
+			q.y = q.y * invLength;
+			q.z = q.z * invLength;
+		}
+	}
+
+	BodyStateStore::~BodyStateStore()
+	{
+		DetachAll();
+	}
+
+	void BodyStateStore::Attach(PhysicsObject3D* obj)
+	{
+		// Entities sharing a body share its slot
+		if (obj->m_State.store == this)
+		{
+			m_References[obj->m_State.index]++;
+			return;
+		}
+
+		LUMOS_ASSERT(obj->m_State.store == nullptr, "Body is already in another engine");
+		if (obj->m_State.store)
+			return;
+
+		const u32 index = GetBodyCount();
+		m_Bodies.push_back(obj);
+		m_References.push_back(1);
+		Resize();
+
+		Write(index, obj->m_State.local);
+		SetActive(index, !obj->GetIsStatic() && obj->IsAwake());
+
+		obj->m_State.store = this;
+		obj->m_State.index = index;
+	}
+
+	void BodyStateStore::Detach(PhysicsObject3D* obj)
+	{
+		LUMOS_ASSERT(obj->m_State.store == this, "Body is not in this store");
+		if (obj->m_State.store != this)
+			return;
+
+		const u32 index = obj->m_State.index;
+		if (--m_References[index] > 0)
+			return;
+
+		Read(index, obj->m_State.local);
+		obj->m_State.store = nullptr;
+
+		const u32 last = GetBodyCount() - 1;
+		if (index != last)
+		{
+			for (auto& channel : m_Channels)
+				channel[index] = channel[last];
+
+			m_Bodies[index] = m_Bodies[last];
+			m_References[index] = m_References[last];
+			m_Bodies[index]->m_State.index = index;
+		}
+
+		m_Bodies.pop_back();
+		m_References.pop_back();
+		ClearSlot(last);
+		Resize();
+	}
+
+	void BodyStateStore::DetachAll()
+	{
+		for (u32 i = 0; i < GetBodyCount(); ++i)
+		{
+			Read(i, m_Bodies[i]->m_State.local);
+			m_Bodies[i]->m_State.store = nullptr;
+		}
+
+		m_Bodies.clear();
+		m_References.clear();
+		for (auto& channel : m_Channels)
+			channel.clear();
+	}
+
+	void BodyStateStore::Resize()
+	{
+		// Pad to a whole number of blocks. Padding lanes hold a zero state with an identity orientation and are never active
+		const u32 oldCount = static_cast<u32>(m_Channels[0].size());
+		const u32 paddedCount = GetBlockCount() * LaneWidth;
+
+		for (auto& channel : m_Channels)
+			channel.resize(paddedCount);
+
+		for (u32 i = oldCount; i < paddedCount; ++i)
+			ClearSlot(i);
+	}
+
+	void BodyStateStore::ClearSlot(u32 index)
+	{
+		if (index >= m_Channels[0].size())
+			return;
+
+		for (auto& channel : m_Channels)
+			channel[index] = 0.0f;
+
+		m_Channels[OrientationW][index] = 1.0f;
+	}
+
+	Maths::Matrix3 BodyStateStore::GetInverseInertia(u32 index) const
+	{
+		float data[9];
+		for (u32 i = 0; i < 9; ++i)
+			data[i] = m_Channels[InvInertia00 + i][index];
+
+		return Maths::Matrix3(data);
+	}
+
+	void BodyStateStore::SetInverseInertia(u32 index, const Maths::Matrix3& m)
+	{
+		const float* data = m.Data();
+		for (u32 i = 0; i < 9; ++i)
+			m_Channels[InvInertia00 + i][index] = data[i];
+	}
+
+	void BodyStateStore::Read(u32 index, RigidBodyState& out_state) const
+	{
+		out_state.position = GetVector3(PositionX, index);
+		out_state.linearVelocity = GetVector3(VelocityX, index);
+		out_state.force = GetVector3(ForceX, index);
+		out_state.invMass = m_Channels[InvMass][index];
+		out_state.orientation = GetOrientation(index);
+		out_state.angularVelocity = GetVector3(AngularVelocityX, index);
+		out_state.torque = GetVector3(TorqueX, index);
+		out_state.invInertia = GetInverseInertia(index);
+	}
+
+	void BodyStateStore::Write(u32 index, const RigidBodyState& state)
+	{
+		SetVector3(PositionX, index, state.position);
+		SetVector3(VelocityX, index, state.linearVelocity);
+		SetVector3(ForceX, index, state.force);
+		m_Channels[InvMass][index] = state.invMass;
+		SetOrientation(index, state.orientation);
+		SetVector3(AngularVelocityX, index, state.angularVelocity);
+		SetVector3(TorqueX, index, state.torque);
+		SetInverseInertia(index, state.invInertia);
+	}
+
+	void BodyStateStore::IntegrateBlock(u32 block, IntegrationType type, const Maths::Vector3& gravity, float damping, float dt)
+	{
+		const u32 begin = block * LaneWidth;
+		const u32 end = Maths::Min(begin + LaneWidth, GetBodyCount());
+
+		const float* active = &m_Channels[Active][begin];
+		if (active[0] == 0.0f && active[1] == 0.0f && active[2] == 0.0f && active[3] == 0.0f)
+			return;
+
+		// Sleeping, static and padding lanes keep their state
+		const Lane activeLanes = Lane::Load(active);
+		auto load = [&](Channel channel) { return Lane::Load(&m_Channels[channel][begin]); };
+		auto store = [&](Channel channel, const Lane& lane) { Lane::Select(activeLanes, lane, load(channel)).Store(&m_Channels[channel][begin]); };
+
+		LaneVector3 position = { load(PositionX), load(PositionY), load(PositionZ) };
+		LaneVector3 velocity = { load(VelocityX), load(VelocityY), load(VelocityZ) };
+		LaneQuaternion orientation = { load(OrientationW), load(OrientationX), load(OrientationY), load(OrientationZ) };
+		LaneVector3 angularVelocity = { load(AngularVelocityX), load(AngularVelocityY), load(AngularVelocityZ) };
+
+		const Lane invMass = load(InvMass);
+		const Lane dtLane = Lane::Set(dt);
+		const Lane halfDt = Lane::Set(dt * 0.5f);
+		const Lane dampingLane = Lane::Set(damping);
+
+		const LaneVector3 acceleration = LaneVector3{ load(ForceX), load(ForceY), load(ForceZ) } * invMass;
+
+		// I^-1 * torque
+		const Lane tx = load(TorqueX), ty = load(TorqueY), tz = load(TorqueZ);
+		const LaneVector3 angularAcceleration =
+		{
+			load(InvInertia00) * tx + load(InvInertia01) * ty + load(InvInertia02) * tz,
+			load(InvInertia10) * tx + load(InvInertia11) * ty + load(InvInertia12) * tz,
+			load(InvInertia20) * tx + load(InvInertia21) * ty + load(InvInertia22) * tz
+		};
+
+		// Apply gravity to bodies with finite mass
+		velocity = velocity + LaneVector3{ Lane::Set(gravity.x), Lane::Set(gravity.y), Lane::Set(gravity.z) } * (invMass.Positive() * dtLane);
+
+		switch (type)
+		{
+		case IntegrationType::EXPLICIT_EULER:
+		{
+			position = position + velocity * dtLane;
+			velocity = (velocity + acceleration * dtLane) * dampingLane;
+
+			IntegrateOrientation(orientation, angularVelocity, halfDt);
+			angularVelocity = (angularVelocity + angularAcceleration * dtLane) * dampingLane;
+			break;
+		}
+
+		default:
+		case IntegrationType::SEMI_IMPLICIT_EULER:
+		{
+			velocity = (velocity + acceleration * dtLane) * dampingLane;
+			position = position + velocity * dtLane;
+
+			angularVelocity = (angularVelocity + angularAcceleration * dtLane) * dampingLane;
+			IntegrateOrientation(orientation, angularVelocity, halfDt);
+			break;
+		}
+
+		// With a constant acceleration over the step RK2/RK4 reduce to closed forms of the averaged derivatives
+		case IntegrationType::RUNGE_KUTTA_2:
+		{
+			position = position + (velocity + acceleration * Lane::Set(dt * 0.25f)) * dtLane;
+			velocity = (velocity + acceleration * dtLane) * dampingLane;
+
+			angularVelocity = (angularVelocity + angularAcceleration * dtLane) * dampingLane;
+			IntegrateOrientation(orientation, angularVelocity, halfDt);
+			break;
+		}
+
+		case IntegrationType::RUNGE_KUTTA_4:
+		{
+			position = position + (velocity + acceleration * halfDt) * dtLane;
+			velocity = (velocity + acceleration * dtLane) * dampingLane;
+
+			angularVelocity = (angularVelocity + angularAcceleration * dtLane) * dampingLane;
+			IntegrateOrientation(orientation, angularVelocity, halfDt);
+			break;
+		}
+		}
+
+		store(PositionX, position.x); store(PositionY, position.y); store(PositionZ, position.z);
+		store(VelocityX, velocity.x); store(VelocityY, velocity.y); store(VelocityZ, velocity.z);
+		store(OrientationW, orientation.w); store(OrientationX, orientation.x); store(OrientationY, orientation.y); store(OrientationZ, orientation.z);
+		store(AngularVelocityX, angularVelocity.x); store(AngularVelocityY, angularVelocity.y); store(AngularVelocityZ, angularVelocity.z);
+
+		for (u32 i = begin; i < end; ++i)
+		{
+			if (active[i - begin] == 0.0f)
+				continue;
+
+			// Mark cached world transform and AABB as invalid
+			PhysicsObject3D* obj = m_Bodies[i];
+			obj->m_wsTransformInvalidated = true;
+			obj->m_wsAabbInvalidated = true;
+			obj->m_PoseChanged = true;
+
+			obj->RestTest();
+		}
+	}
+}
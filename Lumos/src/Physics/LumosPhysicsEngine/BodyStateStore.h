@@ -0,0 +1,112 @@
+#pragma once
+
+#include "lmpch.h"
+#include "Integration.h"
+#include "Maths/Maths.h"
+
+namespace Lumos
+{
+	class PhysicsObject3D;
+
+	//Simulated state of one body, held by the body itself while it isn't in an engine
+	struct LUMOS_EXPORT RigidBodyState
+	{
+		Maths::Vector3	  position = Maths::Vector3(0.0f);
+		Maths::Vector3	  linearVelocity = Maths::Vector3(0.0f);
+		Maths::Vector3	  force = Maths::Vector3(0.0f);
+		float			  invMass = 0.0f;
+		Maths::Quaternion orientation = Maths::Quaternion(1.0f, 0.0f, 0.0f, 0.0f);
+		Maths::Vector3	  angularVelocity = Maths::Vector3(0.0f);
+		Maths::Vector3	  torque = Maths::Vector3(0.0f);
+		Maths::Matrix3	  invInertia = Maths::Matrix3::ZERO;
+	};
+
+	//Structure of arrays holding the state of every body in an engine (position, velocity, orientation,
+	//inverse mass/inertia). Bodies are attached when they are added to the engine, from then on their
+	//getters and setters read and write their slot, and the store integrates the awake dynamic bodies four at a time.
+	class LUMOS_EXPORT BodyStateStore
+	{
+	public:
+		static const u32 LaneWidth = 4;
+
+		enum Channel : u32
+		{
+			PositionX, PositionY, PositionZ,
+			VelocityX, VelocityY, VelocityZ,
+			ForceX, ForceY, ForceZ,
+			OrientationW, OrientationX, OrientationY, OrientationZ,
+			AngularVelocityX, AngularVelocityY, AngularVelocityZ,
+			TorqueX, TorqueY, TorqueZ,
+			InvMass,
+			InvInertia00, InvInertia01, InvInertia02,
+			InvInertia10, InvInertia11, InvInertia12,
+			InvInertia20, InvInertia21, InvInertia22,
+			Active,		//1 for awake, non static bodies
+			ChannelCount
+		};
+
+		BodyStateStore() = default;
+		~BodyStateStore();
+
+		//Moves the body's state into a new slot, the body reads and writes the store until it is detached.
+		//Attaching a body again only counts the extra reference.
+		void Attach(PhysicsObject3D* obj);
+		//Copies the slot back into the body once its last reference is detached. The last body moves into the freed slot.
+		void Detach(PhysicsObject3D* obj);
+		void DetachAll();
+
+		u32 GetBodyCount() const { return static_cast<u32>(m_Bodies.size()); }
+		u32 GetBlockCount() const { return (GetBodyCount() + LaneWidth - 1) / LaneWidth; }
+
+		//Integrates the active bodies of one block of LaneWidth slots in place.
+		//Blocks share no data so they can be processed on any thread.
+		void IntegrateBlock(u32 block, IntegrationType type, const Maths::Vector3& gravity, float damping, float dt);
+
+		const float* GetChannel(Channel channel) const { return m_Channels[channel].data(); }
+
+		//Per slot access, vectors are read from three consecutive channels starting at x
+		float Get(Channel channel, u32 index) const { return m_Channels[channel][index]; }
+		void  Set(Channel channel, u32 index, float value) { m_Channels[channel][index] = value; }
+
+		Maths::Vector3 GetVector3(Channel x, u32 index) const
+		{
+			return Maths::Vector3(m_Channels[x][index], m_Channels[x + 1][index], m_Channels[x + 2][index]);
+		}
+
+		void SetVector3(Channel x, u32 index, const Maths::Vector3& v)
+		{
+			m_Channels[x][index] = v.x;
+			m_Channels[x + 1][index] = v.y;
+			m_Channels[x + 2][index] = v.z;
+		}
+
+		Maths::Quaternion GetOrientation(u32 index) const
+		{
+			return Maths::Quaternion(m_Channels[OrientationW][index], m_Channels[OrientationX][index], m_Channels[OrientationY][index], m_Channels[OrientationZ][index]);
+		}
+
+		void SetOrientation(u32 index, const Maths::Quaternion& q)
+		{
+			m_Channels[OrientationW][index] = q.w;
+			m_Channels[OrientationX][index] = q.x;
+			m_Channels[OrientationY][index] = q.y;
+			m_Channels[OrientationZ][index] = q.z;
+		}
+
+		Maths::Matrix3 GetInverseInertia(u32 index) const;
+		void SetInverseInertia(u32 index, const Maths::Matrix3& m);
+
+		void SetActive(u32 index, bool active) { m_Channels[Active][index] = active ? 1.0f : 0.0f; }
+
+		void Read(u32 index, RigidBodyState& out_state) const;
+		void Write(u32 index, const RigidBodyState& state);
+
+	private:
+		void Resize();
+		void ClearSlot(u32 index);
+
+		std::vector<PhysicsObject3D*> m_Bodies;		// Body in each slot
+		std::vector<u32>			  m_References;	// Times each body was attached
+		std::vector<float>			  m_Channels[ChannelCount];
+	};
+}
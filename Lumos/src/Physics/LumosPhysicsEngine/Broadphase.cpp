@@ -0,0 +1,43 @@
+#include "lmpch.h"
+#include "Broadphase.h"
+#include "CollisionDetection.h"
+
+namespace Lumos
+{
+	void Broadphase::FindObjectsInAABB(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects) const
+	{
+		for (const auto& obj : objects)
+		{
+			if (obj->GetCollisionShape() && box.IsInsideFast(obj->GetWorldSpaceAABB()) != Maths::OUTSIDE)
+				out_objects.push_back(obj.get());
+		}
+	}
+
+	void Broadphase::FindObjectsOnRay(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects) const
+	{
+		TestRayAgainstObjects(objects.data(), objects.size(), ray, maxDistance, out_objects);
+	}
+
+	void Broadphase::TestRayAgainstObjects(const Ref<PhysicsObject3D>* objects, size_t count, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects)
+	{
+		Maths::BoundingBox boxes[4];
+		const Maths::BoundingBox* boxPointers[4] = { &boxes[0], &boxes[1], &boxes[2], &boxes[3] };
+
+		for (size_t i = 0; i < count; i += 4)
+		{
+			const size_t blockCount = Maths::Min(count - i, size_t(4));
+
+			// Short blocks repeat the last box, the extra bits are masked off below
+			for (size_t j = 0; j < 4; ++j)
+				boxes[j] = objects[i + Maths::Min(j, blockCount - 1)]->GetWorldSpaceAABB();
+
+			u32 hits = CollisionDetection::CheckRayAABB4(ray, maxDistance, boxPointers) & ((1u << blockCount) - 1u);
+
+			for (size_t j = 0; hits; ++j, hits >>= 1)
+			{
+				if ((hits & 1u) && objects[i + j]->GetCollisionShape())
+					out_objects.push_back(objects[i + j].get());
+			}
+		}
+	}
+}
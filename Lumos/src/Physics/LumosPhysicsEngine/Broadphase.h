@@ -2,6 +2,7 @@
 
 #include "lmpch.h"
 #include "PhysicsObject3D.h"
+#include "Maths/Ray.h"
 
 namespace Lumos
 {
@@ -18,5 +19,21 @@ namespace Lumos
 		virtual ~Broadphase() = default;
 		virtual void FindPotentialCollisionPairs(std::vector<Ref<PhysicsObject3D>>& objects, std::vector<CollisionPair> &collisionPairs) = 0;
 		virtual void DebugDraw() = 0;
+
+		// Length of the step the next FindPotentialCollisionPairs call searches for, set by the engine
+		void SetTimestep(float timestep) { m_Timestep = timestep; }
+
+		//<----- SCENE QUERIES ----->
+		// Append the objects whose world space AABB overlaps the box / is hit by the ray within maxDistance.
+		// Uses whatever structure the last FindPotentialCollisionPairs call built, the default is a linear scan.
+		// Only reads cached object state, so queries can run on several threads at once.
+		virtual void FindObjectsInAABB(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects) const;
+		virtual void FindObjectsOnRay(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects) const;
+
+	protected:
+		// Tests the objects' AABBs against the ray four at a time
+		static void TestRayAgainstObjects(const Ref<PhysicsObject3D>* objects, size_t count, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects);
+
+		float m_Timestep = 1.0f / 60.0f;
 	};
 }
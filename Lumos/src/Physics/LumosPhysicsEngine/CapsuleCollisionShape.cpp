@@ -40,16 +40,6 @@ namespace Lumos
         return inertia;
 	}
 
-	void CapsuleCollisionShape::GetCollisionAxes(const PhysicsObject3D* currentObject, std::vector<Maths::Vector3>* out_axes) const
-	{
-		/* There is infinite edges so handle seperately */
-	}
-
-	void CapsuleCollisionShape::GetEdges(const PhysicsObject3D* currentObject, std::vector<CollisionEdge>* out_edges) const
-	{
-		/* There is infinite edges on a sphere so handle seperately */
-	}
-
 	void CapsuleCollisionShape::GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const
 	{
 		Maths::Matrix4 transform;
@@ -60,19 +50,28 @@ namespace Lumos
 			transform = currentObject->GetWorldSpaceTransform() * m_LocalTransform;
 
 		Maths::Vector3 pos = transform.Translation();
+		Maths::Vector3 halfSegment = GetHalfSegment(currentObject);
+
+		// Support point is the end of the inner segment furthest along the axis, pushed out by the radius
+		if (Maths::Vector3::Dot(halfSegment, axis) < 0.0f)
+			halfSegment = -halfSegment;
 
 		if (out_min)
-			*out_min = pos - axis * m_Radius;
+			*out_min = pos - halfSegment - axis * m_Radius;
 
 		if (out_max)
-			*out_max = pos + axis * m_Radius;
+			*out_max = pos + halfSegment + axis * m_Radius;
 	}
 
 	void CapsuleCollisionShape::GetIncidentReferencePolygon(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, std::list<Maths::Vector3>* out_face, Maths::Vector3* out_normal, std::vector<Maths::Plane>* out_adjacent_planes) const
 	{
 		if (out_face)
 		{
-			out_face->push_back(currentObject->GetPosition() + axis * m_Radius);
+			Maths::Vector3 halfSegment = GetHalfSegment(currentObject);
+			if (Maths::Vector3::Dot(halfSegment, axis) < 0.0f)
+				halfSegment = -halfSegment;
+
+			out_face->push_back(currentObject->GetPosition() + halfSegment + axis * m_Radius);
 		}
 
 		if (out_normal)
@@ -81,6 +80,17 @@ namespace Lumos
 		}
 	}
 
+	Maths::Vector3 CapsuleCollisionShape::GetHalfSegment(const PhysicsObject3D* currentObject) const
+	{
+		// Capsule meshes are built along the local z axis
+		const Maths::Vector3 halfSegment(0.0f, 0.0f, m_Height * 0.5f);
+
+		if (currentObject == nullptr)
+			return halfSegment;
+
+		return currentObject->GetOrientation() * halfSegment;
+	}
+
 	void CapsuleCollisionShape::DebugDraw(const PhysicsObject3D* currentObject) const
 	{
 	}
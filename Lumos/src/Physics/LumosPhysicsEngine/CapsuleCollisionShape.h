@@ -15,8 +15,6 @@ namespace Lumos
 		//Collision Shape Functionality
 		virtual Maths::Matrix3 BuildInverseInertia(float invMass) const override;
 
-		virtual void GetCollisionAxes(const PhysicsObject3D* currentObject, std::vector<Maths::Vector3>* out_axes) const override;
-		virtual void GetEdges(const PhysicsObject3D* currentObject, std::vector<CollisionEdge>* out_edges) const override;
 
 		virtual void GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const override;
 		virtual void GetIncidentReferencePolygon(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, std::list<Maths::Vector3>* out_face, Maths::Vector3* out_normal, std::vector<Maths::Plane>* out_adjacent_planes) const override;
@@ -29,6 +27,12 @@ namespace Lumos
 
 		float GetSize() const override { return m_Radius; }
 
+		void SetHeight(float height) { m_Height = height; }
+		float GetHeight() const { return m_Height; }
+
+		//Half of the inner line segment in world space
+		Maths::Vector3 GetHalfSegment(const PhysicsObject3D* currentObject) const;
+
 	protected:
 
 		float m_Radius;
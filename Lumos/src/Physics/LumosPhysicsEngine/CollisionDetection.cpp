@@ -2,6 +2,13 @@
 #include "CollisionDetection.h"
 
 #include "SphereCollisionShape.h"
+#include "CapsuleCollisionShape.h"
+#include "TriangleMeshCollisionShape.h"
+#include "GJK.h"
+
+#ifdef Lumos_SSE
+#include <emmintrin.h>
+#endif
 
 namespace Lumos
 {
@@ -16,6 +23,13 @@ namespace Lumos
 		m_CollisionCheckFunctions[CollisionSphere] = &CollisionDetection::CheckSphereCollision;
 		m_CollisionCheckFunctions[CollisionCuboid] = &CollisionDetection::CheckPolyhedronCollision;
 		m_CollisionCheckFunctions[CollisionSphere | CollisionCuboid] = &CollisionDetection::CheckPolyhedronSphereCollision;
+		m_CollisionCheckFunctions[CollisionHull] = &CollisionDetection::CheckPolyhedronCollision;
+		m_CollisionCheckFunctions[CollisionHull | CollisionCuboid] = &CollisionDetection::CheckPolyhedronCollision;
+		m_CollisionCheckFunctions[CollisionHull | CollisionPyramid] = &CollisionDetection::CheckPolyhedronCollision;
+		m_CollisionCheckFunctions[CollisionHull | CollisionSphere] = &CollisionDetection::CheckPolyhedronSphereCollision;
+
+		for (unsigned int type : { CollisionCuboid, CollisionSphere, CollisionPyramid, CollisionCapsule, CollisionHull, CollisionTriangleMesh })
+			m_CollisionCheckFunctions[CollisionTriangleMesh | type] = &CollisionDetection::CheckTriangleMeshCollision;
 	}
 
 
@@ -39,41 +53,66 @@ namespace Lumos
 		return true;
 	}
 
-	void AddPossibleCollisionAxis(Maths::Vector3& axis, std::vector<Maths::Vector3>* possible_collision_axes)
+	bool CollisionDetection::CheckConvexCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata) const
 	{
-		const float epsilon = 0.0001f;
+		if (shape1->GetType() == CollisionSphere && shape2->GetType() == CollisionSphere)
+			return CheckSphereCollision(obj1, obj2, shape1, shape2, out_coldata);
 
-		if (axis.LengthSquared() < epsilon)
-			return;
+		if ((shape1->GetType() | shape2->GetType()) & CollisionTriangleMesh)
+			return CheckTriangleMeshCollision(obj1, obj2, shape1, shape2, out_coldata);
 
-		axis.Normalize();
+		return GJK::Intersect(obj1, obj2, shape1, shape2, out_coldata);
+	}
 
-		for (const Maths::Vector3& p_axis : *possible_collision_axes)
+	namespace
+	{
+		//Fixed capacity set of the axes already tested for one pair, lives on the stack.
+		//Box/box needs 15 axes, if a shape produces more than the capacity the extra axes
+		//are still tested, they just are not used to reject later duplicates.
+		struct CollisionAxisSet
 		{
-			if (abs(Maths::Vector3::Dot(axis,p_axis)) >= (1.0f - epsilon))
-				return;
-		}
+			static const u32 Capacity = 64;
 
-		possible_collision_axes->push_back(axis);
-	}
+			Maths::Vector3 axes[Capacity];
+			u32 count = 0;
+
+			//Normalises the axis and returns false if it is degenerate or parallel to an axis already in the set
+			bool Add(Maths::Vector3& axis)
+			{
+				const float epsilon = 0.0001f;
+
+				if (axis.LengthSquared() < epsilon)
+					return false;
+
+				axis.Normalize();
+
+				for (u32 i = 0; i < count; ++i)
+				{
+					if (abs(Maths::Vector3::Dot(axis, axes[i])) >= (1.0f - epsilon))
+						return false;
+				}
 
+				if (count < Capacity)
+					axes[count++] = axis;
+
+				return true;
+			}
+		};
+	}
 
 	bool CollisionDetection::CheckPolyhedronSphereCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata) const 
 	{
-		const CollisionShape* complexShape;
 		const PhysicsObject3D* complexObj;
 		const PhysicsObject3D* sphereObj;
 
 		if (obj1->GetCollisionShape()->GetType() == CollisionShapeType::CollisionSphere)
 		{
 			sphereObj = obj1;
-			complexShape = shape2;
 			complexObj = obj2;
 		}
 		else 
 		{
 			sphereObj = obj2;
-			complexShape = shape1;
 			complexObj = obj1;
 		}
 
@@ -81,28 +120,33 @@ namespace Lumos
 		CollisionData best_colData;
 		best_colData.penetration = -FLT_MAX;
 
-		std::vector<Maths::Vector3> possibleCollisionAxes;
-		complexShape->GetCollisionAxes(complexObj, &possibleCollisionAxes);
-
-		std::vector<CollisionEdge> complex_shape_edges;
+		CollisionAxisSet testedAxes;
 
-		complexShape->GetEdges(complexObj, &complex_shape_edges);
-
-		Maths::Vector3 p = GetClosestPointOnEdges(sphereObj->GetPosition(), complex_shape_edges);
-		//NCLDebug::DrawPoint(p, 0.1f);
-		Maths::Vector3 p_t = sphereObj->GetPosition() - p;
-		p_t.Normalize();
-		AddPossibleCollisionAxis(p_t, &possibleCollisionAxes);
-
-		for (const Maths::Vector3& axis : possibleCollisionAxes)
+		auto testAxis = [&](Maths::Vector3 axis)
 		{
+			if (!testedAxes.Add(axis))
+				return true;
+
 			if (!CheckCollisionAxis(axis, obj1, obj2, shape1, shape2, &cur_colData))
 				return false;
 
 			if (cur_colData.penetration > best_colData.penetration)
 				best_colData = cur_colData;
+
+			return true;
+		};
+
+		for (const Maths::Vector3& axis : complexObj->GetWorldSpaceCollisionAxes())
+		{
+			if (!testAxis(axis))
+				return false;
 		}
 
+		Maths::Vector3 p = GetClosestPointOnEdges(sphereObj->GetPosition(), complexObj->GetWorldSpaceEdges());
+		//NCLDebug::DrawPoint(p, 0.1f);
+		if (!testAxis(sphereObj->GetPosition() - p))
+			return false;
+
 		if (out_coldata)
 			*out_coldata = best_colData;
 
@@ -115,48 +159,722 @@ namespace Lumos
 		CollisionData best_colData;
 		best_colData.penetration = -FLT_MAX;
 
-		std::vector<Maths::Vector3> possibleCollisionAxes;
-		std::vector<Maths::Vector3> tempPossibleCollisionAxes;
-		shape1->GetCollisionAxes(obj1, &possibleCollisionAxes);
-		shape2->GetCollisionAxes(obj2, &tempPossibleCollisionAxes);
-		for (Maths::Vector3& temp : tempPossibleCollisionAxes)
-			AddPossibleCollisionAxis(temp, &possibleCollisionAxes);
+		CollisionAxisSet testedAxes;
+
+		//Axes are tested as they are generated so a separating face axis skips the edge pairs entirely
+		auto testAxis = [&](Maths::Vector3 axis)
+		{
+			if (!testedAxes.Add(axis))
+				return true;
+
+			if (!CheckCollisionAxis(axis, obj1, obj2, shape1, shape2, &cur_colData))
+				return false;
 
-		std::vector<CollisionEdge> shape1_edges;
-		std::vector<CollisionEdge> shape2_edges;
+			if (cur_colData.penetration >= best_colData.penetration)
+				best_colData = cur_colData;
 
-		shape1->GetEdges(obj1, &shape1_edges);
-		shape2->GetEdges(obj2, &shape2_edges);
+			return true;
+		};
 
-		for (const CollisionEdge& edge1 : shape1_edges) 
+		for (const Maths::Vector3& axis : obj1->GetWorldSpaceCollisionAxes())
 		{
-			for (const CollisionEdge& edge2 : shape2_edges) 
+			if (!testAxis(axis))
+				return false;
+		}
+
+		for (const Maths::Vector3& axis : obj2->GetWorldSpaceCollisionAxes())
+		{
+			if (!testAxis(axis))
+				return false;
+		}
+
+		//Parallel edges give the same axis, so only the unique edge directions are crossed
+		for (const Maths::Vector3& e1 : obj1->GetWorldSpaceEdgeDirections())
+		{
+			for (const Maths::Vector3& e2 : obj2->GetWorldSpaceEdgeDirections())
 			{
-				Maths::Vector3 e1 = edge1.posB - edge1.posA;
-				Maths::Vector3 e2 = edge2.posB - edge2.posA;
-				e1.Normalize();
-				e2.Normalize();
+				if (!testAxis(e1.CrossProduct(e2)))
+					return false;
+			}
+		}
+
+		if (out_coldata)
+			*out_coldata = best_colData;
+
+		return true;
+	}
+
+	namespace
+	{
+		Maths::Vector3 GetClosestPointOnTriangle(const Maths::Vector3& p, const Maths::Vector3& a, const Maths::Vector3& b, const Maths::Vector3& c)
+		{
+			// Voronoi regions of the vertices and edges, then the face
+			const Maths::Vector3 ab = b - a;
+			const Maths::Vector3 ac = c - a;
+			const Maths::Vector3 ap = p - a;
+			const float d1 = ab.DotProduct(ap);
+			const float d2 = ac.DotProduct(ap);
+			if (d1 <= 0.0f && d2 <= 0.0f)
+				return a;
+
+			const Maths::Vector3 bp = p - b;
+			const float d3 = ab.DotProduct(bp);
+			const float d4 = ac.DotProduct(bp);
+			if (d3 >= 0.0f && d4 <= d3)
+				return b;
+
+			const float vc = d1 * d4 - d3 * d2;
+			if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+				return a + ab * (d1 / (d1 - d3));
+
+			const Maths::Vector3 cp = p - c;
+			const float d5 = ab.DotProduct(cp);
+			const float d6 = ac.DotProduct(cp);
+			if (d6 >= 0.0f && d5 <= d6)
+				return c;
+
+			const float vb = d5 * d2 - d1 * d6;
+			if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+				return a + ac * (d2 / (d2 - d6));
+
+			const float va = d3 * d6 - d5 * d4;
+			if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+				return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+			const float denom = 1.0f / (va + vb + vc);
+			return a + ab * (vb * denom) + ac * (vc * denom);
+		}
 
-				Maths::Vector3 temp = e1.CrossProduct(e2);
-				AddPossibleCollisionAxis(temp, &possibleCollisionAxes);
+		void GetClosestPointsOnSegments(const Maths::Vector3& p1, const Maths::Vector3& q1, const Maths::Vector3& p2, const Maths::Vector3& q2, Maths::Vector3* out_c1, Maths::Vector3* out_c2)
+		{
+			const Maths::Vector3 d1 = q1 - p1;
+			const Maths::Vector3 d2 = q2 - p2;
+			const Maths::Vector3 r = p1 - p2;
+			const float a = d1.DotProduct(d1);
+			const float e = d2.DotProduct(d2);
+			const float f = d2.DotProduct(r);
+
+			float s = 0.0f, t = 0.0f;
+			if (a <= Maths::M_EPSILON && e <= Maths::M_EPSILON)
+			{
 			}
+			else if (a <= Maths::M_EPSILON)
+			{
+				t = Maths::Clamp(f / e, 0.0f, 1.0f);
+			}
+			else
+			{
+				const float c = d1.DotProduct(r);
+				if (e <= Maths::M_EPSILON)
+				{
+					s = Maths::Clamp(-c / a, 0.0f, 1.0f);
+				}
+				else
+				{
+					const float b = d1.DotProduct(d2);
+					const float denom = a * e - b * b;
+					s = denom != 0.0f ? Maths::Clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+					t = (b * s + f) / e;
+
+					if (t < 0.0f)
+					{
+						t = 0.0f;
+						s = Maths::Clamp(-c / a, 0.0f, 1.0f);
+					}
+					else if (t > 1.0f)
+					{
+						t = 1.0f;
+						s = Maths::Clamp((b - c) / a, 0.0f, 1.0f);
+					}
+				}
+			}
+
+			*out_c1 = p1 + d1 * s;
+			*out_c2 = p2 + d2 * t;
 		}
 
-		for (const Maths::Vector3& axis : possibleCollisionAxes)
+		//SAT between a world space triangle and a convex body. The normal points from the triangle to the body.
+		bool CheckTriangleConvexCollision(const Maths::Vector3* triangle, const Maths::Vector3& triangleNormal, const PhysicsObject3D* obj, const CollisionShape* shape, CollisionData* out_coldata)
 		{
-			if (!CheckCollisionAxis(axis, obj1, obj2, shape1, shape2, &cur_colData))
+			const Maths::Vector3 toObject = obj->GetPosition() - (triangle[0] + triangle[1] + triangle[2]) / 3.0f;
+
+			CollisionData faceColData;
+			CollisionData best_colData;
+			best_colData.penetration = -FLT_MAX;
+
+			CollisionAxisSet testedAxes;
+			Maths::Vector3 min, max;
+
+			auto testAxis = [&](Maths::Vector3 axis)
+			{
+				if (!testedAxes.Add(axis))
+					return true;
+
+				if (axis.DotProduct(toObject) < 0.0f)
+					axis = -axis;
+
+				float triangleMin = FLT_MAX, triangleMax = -FLT_MAX;
+				for (int i = 0; i < 3; ++i)
+				{
+					const float correlation = axis.DotProduct(triangle[i]);
+					triangleMin = Maths::Min(triangleMin, correlation);
+					triangleMax = Maths::Max(triangleMax, correlation);
+				}
+
+				shape->GetMinMaxVertexOnAxis(obj, axis, &min, &max);
+				const float minCorrelation = axis.DotProduct(min);
+				if (minCorrelation > triangleMax || axis.DotProduct(max) < triangleMin)
+					return false;
+
+				const float penetration = minCorrelation - triangleMax;
+				if (penetration > best_colData.penetration)
+				{
+					best_colData.normal = axis;
+					best_colData.penetration = penetration;
+					best_colData.pointOnPlane = min - axis * penetration;
+				}
+
+				return true;
+			};
+
+			if (!testAxis(triangleNormal))
 				return false;
 
-			if (cur_colData.penetration >= best_colData.penetration)
-				best_colData = cur_colData;
+			faceColData = best_colData;
+
+			for (const Maths::Vector3& axis : obj->GetWorldSpaceCollisionAxes())
+			{
+				if (!testAxis(axis))
+					return false;
+			}
+
+			const Maths::Vector3 triangleEdges[3] = { triangle[1] - triangle[0], triangle[2] - triangle[1], triangle[0] - triangle[2] };
+			for (const Maths::Vector3& e1 : obj->GetWorldSpaceEdgeDirections())
+			{
+				for (const Maths::Vector3& e2 : triangleEdges)
+				{
+					if (!testAxis(e1.CrossProduct(e2)))
+						return false;
+				}
+			}
+
+			// Bodies sliding over the shared edges of flat triangles would catch on the edge axes,
+			// so the triangle normal is kept unless another axis is clearly shallower
+			if (best_colData.penetration <= 0.98f * faceColData.penetration + 0.001f)
+				best_colData = faceColData;
+
+			if (out_coldata)
+				*out_coldata = best_colData;
+
+			return true;
 		}
+	}
 
-		if (out_coldata)
-			*out_coldata = best_colData;
+	bool CollisionDetection::CheckTriangleMeshCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata) const
+	{
+		return CollideTriangleMesh(obj1, obj2, shape1, shape2, out_coldata, nullptr);
+	}
+
+	bool CollisionDetection::CollideTriangleMesh(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata, Manifold* manifold) const
+	{
+		const bool meshIsA = shape1->GetType() == CollisionTriangleMesh;
+		const PhysicsObject3D* meshObj = meshIsA ? obj1 : obj2;
+		const PhysicsObject3D* otherObj = meshIsA ? obj2 : obj1;
+		const TriangleMeshCollisionShape* mesh = static_cast<const TriangleMeshCollisionShape*>(meshIsA ? shape1 : shape2);
+		const CollisionShape* other = meshIsA ? shape2 : shape1;
+
+		// Meshes are static, they never need to collide with each other
+		if (other->GetType() == CollisionTriangleMesh)
+			return false;
+
+		// World bounds of the other body moved into mesh space pick the candidate triangles
+		Maths::BoundingBox otherBounds;
+		otherBounds.Clear();
+
+		Maths::Vector3 min, max;
+		for (const Maths::Vector3& axis : { Maths::Vector3(1.0f, 0.0f, 0.0f), Maths::Vector3(0.0f, 1.0f, 0.0f), Maths::Vector3(0.0f, 0.0f, 1.0f) })
+		{
+			other->GetMinMaxVertexOnAxis(otherObj, axis, &min, &max);
+			otherBounds.Merge(min);
+			otherBounds.Merge(max);
+		}
+
+		const Maths::Matrix4 meshTransform = mesh->GetMeshTransform(meshObj);
+
+		std::vector<u32> triangles;
+		mesh->QueryAABB(otherBounds.Transformed(meshTransform.Inverse()), triangles);
+
+		if (triangles.empty())
+			return false;
+
+		const Maths::Vector3 otherCentre = otherObj->GetPosition();
+		float radius = 0.0f;
+		Maths::Vector3 halfSegment;
+
+		if (other->GetType() == CollisionSphere)
+			radius = static_cast<const SphereCollisionShape*>(other)->GetRadius();
+		else if (other->GetType() == CollisionCapsule)
+		{
+			radius = static_cast<const CapsuleCollisionShape*>(other)->GetRadius();
+			halfSegment = static_cast<const CapsuleCollisionShape*>(other)->GetHalfSegment(otherObj);
+		}
+
+		bool colliding = false;
+		CollisionData deepest;
+		deepest.penetration = FLT_MAX;
+
+		// Contacts are found with the normal pointing from the mesh to the other body,
+		// manifolds and the returned data want it from obj1 to obj2
+		auto addDeepest = [&](const CollisionData& coldata)
+		{
+			colliding = true;
+			if (coldata.penetration < deepest.penetration)
+			{
+				deepest = coldata;
+				if (!meshIsA)
+					deepest.normal = -deepest.normal;
+			}
+		};
+
+		auto addContact = [&](const Maths::Vector3& onMesh, const Maths::Vector3& onOther, const Maths::Vector3& normal, float penetration)
+		{
+			addDeepest({ penetration, normal, onMesh });
+
+			if (!manifold)
+				return;
+
+			if (meshIsA)
+				manifold->AddContact(onMesh, onOther, normal, penetration);
+			else
+				manifold->AddContact(onOther, onMesh, -normal, penetration);
+		};
+
+		Maths::Vector3 triangle[3];
+		for (u32 index : triangles)
+		{
+			mesh->GetTriangle(index, triangle);
+			for (Maths::Vector3& vertex : triangle)
+				vertex = meshTransform * vertex;
+
+			Maths::Vector3 normal = (triangle[1] - triangle[0]).CrossProduct(triangle[2] - triangle[0]);
+			const float area = normal.Length();
+			if (area < Maths::M_EPSILON)
+				continue;
+
+			normal = normal / area;
+
+			// Triangles are one sided, bodies behind them fall through rather than being pushed out the front
+			if (normal.DotProduct(otherCentre - triangle[0]) < 0.0f)
+				continue;
+
+			switch (other->GetType())
+			{
+			case CollisionSphere:
+			{
+				const Maths::Vector3 closest = GetClosestPointOnTriangle(otherCentre, triangle[0], triangle[1], triangle[2]);
+				const Maths::Vector3 offset = otherCentre - closest;
+				const float distanceSq = offset.LengthSquared();
+				if (distanceSq >= radius * radius)
+					break;
+
+				const float distance = sqrtf(distanceSq);
+				const Maths::Vector3 contactNormal = distance > Maths::M_EPSILON ? offset / distance : normal;
+				addContact(closest, otherCentre - contactNormal * radius, contactNormal, distance - radius);
+				break;
+			}
+
+			case CollisionCapsule:
+			{
+				const Maths::Vector3 a = otherCentre - halfSegment;
+				const Maths::Vector3 b = otherCentre + halfSegment;
+				const float heightA = normal.DotProduct(a - triangle[0]);
+				const float heightB = normal.DotProduct(b - triangle[0]);
+
+				// Segment passes through the triangle, push the lower end back out along the face
+				if (heightA * heightB < 0.0f)
+				{
+					const Maths::Vector3 crossing = a + (b - a) * (heightA / (heightA - heightB));
+					if ((GetClosestPointOnTriangle(crossing, triangle[0], triangle[1], triangle[2]) - crossing).LengthSquared() < Maths::M_EPSILON)
+					{
+						const Maths::Vector3& lower = heightA < heightB ? a : b;
+						const float height = Maths::Min(heightA, heightB);
+						addContact(lower - normal * height, lower - normal * radius, normal, height - radius);
+						break;
+					}
+				}
+
+				// Each end gets its own contact so a capsule lying on the mesh stays level
+				bool touching = false;
+				for (const Maths::Vector3& end : { a, b })
+				{
+					const Maths::Vector3 closest = GetClosestPointOnTriangle(end, triangle[0], triangle[1], triangle[2]);
+					const Maths::Vector3 offset = end - closest;
+					const float distanceSq = offset.LengthSquared();
+					if (distanceSq >= radius * radius)
+						continue;
+
+					const float distance = sqrtf(distanceSq);
+					const Maths::Vector3 contactNormal = distance > Maths::M_EPSILON ? offset / distance : normal;
+					addContact(closest, end - contactNormal * radius, contactNormal, distance - radius);
+					touching = true;
+				}
+
+				if (touching)
+					break;
+
+				// Middle of the segment crossing over a triangle edge
+				float closestDistanceSq = radius * radius;
+				Maths::Vector3 onSegment, onTriangle, c1, c2;
+				for (int i = 0; i < 3; ++i)
+				{
+					GetClosestPointsOnSegments(a, b, triangle[i], triangle[(i + 1) % 3], &c1, &c2);
+					const float distanceSq = (c1 - c2).LengthSquared();
+					if (distanceSq < closestDistanceSq)
+					{
+						closestDistanceSq = distanceSq;
+						onSegment = c1;
+						onTriangle = c2;
+					}
+				}
+
+				if (closestDistanceSq < radius * radius)
+				{
+					const float distance = sqrtf(closestDistanceSq);
+					const Maths::Vector3 contactNormal = distance > Maths::M_EPSILON ? (onSegment - onTriangle) / distance : normal;
+					addContact(onTriangle, onSegment - contactNormal * radius, contactNormal, distance - radius);
+				}
+				break;
+			}
+
+			default:
+			{
+				CollisionData coldata;
+				if (!CheckTriangleConvexCollision(triangle, normal, otherObj, other, &coldata))
+					break;
+
+				addDeepest(coldata);
+
+				if (!manifold)
+					break;
+
+				// The triangle is its own reference face, clipped by the inward planes through its edges
+				std::list<Maths::Vector3> trianglePolygon(triangle, triangle + 3);
+				std::vector<Maths::Plane> trianglePlanes;
+				for (int i = 0; i < 3; ++i)
+				{
+					const Maths::Vector3 inward = normal.CrossProduct(triangle[(i + 1) % 3] - triangle[i]).Normalized();
+					trianglePlanes.emplace_back(inward, -inward.DotProduct(triangle[i]));
+				}
+
+				std::list<Maths::Vector3> otherPolygon;
+				Maths::Vector3 otherNormal;
+				std::vector<Maths::Plane> otherPlanes;
+				other->GetIncidentReferencePolygon(otherObj, -coldata.normal, &otherPolygon, &otherNormal, &otherPlanes);
+
+				if (otherPolygon.empty())
+					break;
+
+				if (meshIsA)
+					AddClippedContacts(trianglePolygon, normal, trianglePlanes, otherPolygon, otherNormal, otherPlanes, coldata, manifold);
+				else
+				{
+					coldata.normal = -coldata.normal;
+					AddClippedContacts(otherPolygon, otherNormal, otherPlanes, trianglePolygon, normal, trianglePlanes, coldata, manifold);
+				}
+				break;
+			}
+			}
+		}
+
+		if (colliding && out_coldata)
+			*out_coldata = deepest;
+
+		return colliding;
+	}
+
+	namespace
+	{
+		//Lower bound on the distance from a sphere to a convex object, from the separation along the
+		//object's face axes and the direction to its centre. Exact for spheres and face regions.
+		float GetSeparationLowerBound(const Maths::Vector3& point, float radius, const PhysicsObject3D* obj, const CollisionShape* shape)
+		{
+			float separation = -FLT_MAX;
+			Maths::Vector3 min, max;
+
+			auto testAxis = [&](const Maths::Vector3& axis)
+			{
+				shape->GetMinMaxVertexOnAxis(obj, axis, &min, &max);
+				const float projection = Maths::Vector3::Dot(axis, point);
+				separation = Maths::Max(separation, projection - Maths::Vector3::Dot(axis, max));
+				separation = Maths::Max(separation, Maths::Vector3::Dot(axis, min) - projection);
+			};
+
+			for (const Maths::Vector3& axis : obj->GetWorldSpaceCollisionAxes())
+				testAxis(axis);
+
+			Maths::Vector3 toCentre = point - obj->GetPosition();
+			if (toCentre.LengthSquared() > 0.0001f)
+				testAxis(toCentre.Normalized());
+
+			return separation - radius;
+		}
+	}
+
+	bool CollisionDetection::SweptSphereTimeOfImpact(const Maths::Vector3& start, float radius, const Maths::Vector3& motion, const PhysicsObject3D* obj, const CollisionShape* shape, float slop, float* out_toi)
+	{
+		const int maxIterations = 16;
+
+		const float distance = motion.Length();
+		if (distance < 0.0001f)
+			return false;
+
+		// Only the path of the centre is traced against meshes, grazing hits are left to the discrete test
+		if (shape->GetType() == CollisionTriangleMesh)
+		{
+			const Maths::Vector3 direction = motion / distance;
+			float hitDistance;
+			Maths::Vector3 normal;
+			if (!static_cast<const TriangleMeshCollisionShape*>(shape)->Raycast(obj, Maths::Ray(start, direction), distance + radius, &hitDistance, &normal))
+				return false;
+
+			// Distance travelled when the sphere touches the plane of the hit triangle
+			const float cosine = -direction.DotProduct(normal);
+			const float touch = cosine > Maths::M_EPSILON ? hitDistance - radius / cosine : 0.0f;
+			if (touch < slop || touch >= distance)
+				return false;
+
+			if (out_toi)
+				*out_toi = Maths::Min((touch + slop) / distance, 1.0f);
+
+			return true;
+		}
+
+		float separation = GetSeparationLowerBound(start, radius, obj, shape);
+		if (separation < slop)
+			return false;
+
+		// The sphere can't reach the surface before it has moved 'separation' along its motion
+		float t = 0.0f;
+		for (int i = 0; i < maxIterations; ++i)
+		{
+			t += separation / distance;
+			if (t >= 1.0f)
+				return false;
+
+			separation = GetSeparationLowerBound(start + motion * t, radius, obj, shape);
+			if (separation < slop)
+				break;
+		}
+
+		// Advance by the slop as well so the discrete test picks up the contact next step
+		if (out_toi)
+			*out_toi = Maths::Min(t + slop / distance, 1.0f);
 
 		return true;
 	}
 
+	namespace
+	{
+		bool CheckRaySphere(const Maths::Ray& ray, const Maths::Vector3& centre, float radius, float* out_distance)
+		{
+			const float distance = ray.HitDistance(Maths::Sphere(centre, radius));
+			if (distance == Maths::M_INFINITY)
+				return false;
+
+			*out_distance = distance;
+			return true;
+		}
+
+		bool CheckRayCapsule(const Maths::Ray& ray, const Maths::Vector3& a, const Maths::Vector3& b, float radius, float* out_distance, Maths::Vector3* out_normal)
+		{
+			const Maths::Vector3 d = b - a;
+			const Maths::Vector3 m = ray.origin_ - a;
+			const Maths::Vector3& n = ray.direction_;
+
+			const float dd = d.DotProduct(d);
+			const float md = m.DotProduct(d);
+			const float nd = n.DotProduct(d);
+
+			float best = Maths::M_INFINITY;
+
+			// Infinite cylinder around the segment, only hits between the end caps count
+			const float qa = dd - nd * nd;
+			if (qa > Maths::M_EPSILON)
+			{
+				const float qb = dd * m.DotProduct(n) - nd * md;
+				const float qc = dd * (m.DotProduct(m) - radius * radius) - md * md;
+				const float discriminant = qb * qb - qa * qc;
+
+				if (discriminant >= 0.0f)
+				{
+					const float t = (-qb - sqrtf(discriminant)) / qa;
+					const float s = md + t * nd;
+					if (t >= 0.0f && s >= 0.0f && s <= dd)
+						best = t;
+				}
+			}
+
+			float t;
+			if (CheckRaySphere(ray, a, radius, &t)) best = Maths::Min(best, t);
+			if (CheckRaySphere(ray, b, radius, &t)) best = Maths::Min(best, t);
+
+			if (best == Maths::M_INFINITY)
+				return false;
+
+			*out_distance = best;
+
+			if (out_normal)
+			{
+				const Maths::Vector3 point = ray.origin_ + n * best;
+				const float s = dd > Maths::M_EPSILON ? Maths::Clamp((point - a).DotProduct(d) / dd, 0.0f, 1.0f) : 0.0f;
+				*out_normal = (point - (a + d * s)).Normalized();
+			}
+
+			return true;
+		}
+	}
+
+	bool CollisionDetection::CheckRayCollision(const Maths::Ray& ray, float maxDistance, const PhysicsObject3D* obj, const CollisionShape* shape, float* out_distance, Maths::Vector3* out_normal)
+	{
+		float distance = 0.0f;
+		Maths::Vector3 normal = -ray.direction_;
+
+		switch (shape->GetType())
+		{
+		case CollisionSphere:
+		{
+			const Maths::Vector3 centre = obj->GetPosition();
+			if (!CheckRaySphere(ray, centre, static_cast<const SphereCollisionShape*>(shape)->GetRadius(), &distance))
+				return false;
+
+			if (distance > 0.0f)
+				normal = (ray.origin_ + ray.direction_ * distance - centre).Normalized();
+			break;
+		}
+
+		case CollisionCapsule:
+		{
+			const CapsuleCollisionShape* capsule = static_cast<const CapsuleCollisionShape*>(shape);
+			const Maths::Vector3 halfSegment = capsule->GetHalfSegment(obj);
+			if (!CheckRayCapsule(ray, obj->GetPosition() - halfSegment, obj->GetPosition() + halfSegment, capsule->GetRadius(), &distance, &normal))
+				return false;
+			break;
+		}
+
+		case CollisionTriangleMesh:
+		{
+			if (!static_cast<const TriangleMeshCollisionShape*>(shape)->Raycast(obj, ray, maxDistance, &distance, &normal))
+				return false;
+			break;
+		}
+
+		default:
+		{
+			// Convex polyhedra are the intersection of the slabs between their min/max along each face axis
+			const std::vector<Maths::Vector3>& axes = obj->GetWorldSpaceCollisionAxes();
+			if (axes.empty())
+				return false;
+
+			float tEnter = 0.0f;
+			float tExit = maxDistance;
+			Maths::Vector3 min, max;
+
+			for (const Maths::Vector3& axis : axes)
+			{
+				shape->GetMinMaxVertexOnAxis(obj, axis, &min, &max);
+
+				const float lower = axis.DotProduct(min);
+				const float upper = axis.DotProduct(max);
+				const float origin = axis.DotProduct(ray.origin_);
+				const float denom = axis.DotProduct(ray.direction_);
+
+				if (abs(denom) < Maths::M_EPSILON)
+				{
+					if (origin < lower || origin > upper)
+						return false;
+					continue;
+				}
+
+				float t0 = (lower - origin) / denom;
+				float t1 = (upper - origin) / denom;
+				Maths::Vector3 faceNormal = -axis;
+				if (t0 > t1)
+				{
+					std::swap(t0, t1);
+					faceNormal = axis;
+				}
+
+				if (t0 > tEnter)
+				{
+					tEnter = t0;
+					normal = faceNormal;
+				}
+
+				tExit = Maths::Min(tExit, t1);
+				if (tEnter > tExit)
+					return false;
+			}
+
+			distance = tEnter;
+			break;
+		}
+		}
+
+		if (distance > maxDistance)
+			return false;
+
+		if (out_distance) *out_distance = distance;
+		if (out_normal) *out_normal = normal;
+
+		return true;
+	}
+
+	u32 CollisionDetection::CheckRayAABB4(const Maths::Ray& ray, float maxDistance, const Maths::BoundingBox* const* boxes)
+	{
+		// Zero direction components give infinite slabs, which the min/max below handle
+		const float invDirection[3] = { 1.0f / ray.direction_.x, 1.0f / ray.direction_.y, 1.0f / ray.direction_.z };
+
+#ifdef Lumos_SSE
+		__m128 tMin = _mm_setzero_ps();
+		__m128 tMax = _mm_set1_ps(maxDistance);
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const __m128 boxMin = _mm_setr_ps(boxes[0]->min_[axis], boxes[1]->min_[axis], boxes[2]->min_[axis], boxes[3]->min_[axis]);
+			const __m128 boxMax = _mm_setr_ps(boxes[0]->max_[axis], boxes[1]->max_[axis], boxes[2]->max_[axis], boxes[3]->max_[axis]);
+			const __m128 origin = _mm_set1_ps(ray.origin_[axis]);
+			const __m128 inv = _mm_set1_ps(invDirection[axis]);
+
+			const __m128 t0 = _mm_mul_ps(_mm_sub_ps(boxMin, origin), inv);
+			const __m128 t1 = _mm_mul_ps(_mm_sub_ps(boxMax, origin), inv);
+
+			tMin = _mm_max_ps(tMin, _mm_min_ps(t0, t1));
+			tMax = _mm_min_ps(tMax, _mm_max_ps(t0, t1));
+		}
+
+		return static_cast<u32>(_mm_movemask_ps(_mm_cmple_ps(tMin, tMax)));
+#else
+		u32 hits = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			float tMin = 0.0f;
+			float tMax = maxDistance;
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const float t0 = (boxes[i]->min_[axis] - ray.origin_[axis]) * invDirection[axis];
+				const float t1 = (boxes[i]->max_[axis] - ray.origin_[axis]) * invDirection[axis];
+				tMin = Maths::Max(tMin, Maths::Min(t0, t1));
+				tMax = Maths::Min(tMax, Maths::Max(t0, t1));
+			}
+
+			if (tMin <= tMax)
+				hits |= 1u << i;
+		}
+		return hits;
+#endif
+	}
+
 	bool CollisionDetection::CheckCollisionAxis(const Maths::Vector3& axis, const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata)
 	{
 		Maths::Vector3 min1, min2, max1, max2;
@@ -200,6 +918,10 @@ namespace Lumos
 		if (!manifold)
 			return false;
 
+		// Meshes add the contacts of every triangle touching the other body
+		if ((shape1->GetType() | shape2->GetType()) & CollisionTriangleMesh)
+			return CollideTriangleMesh(obj1, obj2, shape1, shape2, nullptr, manifold);
+
 		std::list<Maths::Vector3> polygon1, polygon2;
 		Maths::Vector3 normal1, normal2;
 		std::vector<Maths::Plane> adjPlanes1, adjPlanes2;
@@ -209,7 +931,14 @@ namespace Lumos
 
 		if (polygon1.empty() || polygon2.empty())
 			return false;
-		else if (polygon1.size() == 1)
+
+		AddClippedContacts(polygon1, normal1, adjPlanes1, polygon2, normal2, adjPlanes2, coldata, manifold);
+		return true;
+	}
+
+	void CollisionDetection::AddClippedContacts(std::list<Maths::Vector3>& polygon1, const Maths::Vector3& normal1, std::vector<Maths::Plane>& adjPlanes1, std::list<Maths::Vector3>& polygon2, const Maths::Vector3& normal2, std::vector<Maths::Plane>& adjPlanes2, const CollisionData& coldata, Manifold* manifold) const
+	{
+		if (polygon1.size() == 1)
 			manifold->AddContact(polygon1.front(), polygon1.front() - coldata.normal * coldata.penetration, coldata.normal, coldata.penetration);
 		else if (polygon2.size() == 1)
 			manifold->AddContact(polygon2.front() + coldata.normal * coldata.penetration, polygon2.front(), coldata.normal, coldata.penetration);
@@ -270,7 +999,6 @@ namespace Lumos
 				manifold->AddContact(globalOnA, globalOnB, coldata.normal, contact_penetration);
 			}
 		}
-		return true;
 	}
 
 	Maths::Vector3 CollisionDetection::GetClosestPointOnEdges(const Maths::Vector3& target, const std::vector<CollisionEdge>& edges)
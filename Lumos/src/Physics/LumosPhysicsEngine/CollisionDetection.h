@@ -4,11 +4,18 @@
 #include "CollisionShape.h"
 #include "Manifold.h"
 #include "Utilities/TSingleton.h"
+#include "Maths/Ray.h"
 
 #define CALL_MEMBER_FN(instance, ptrToMemberFn)  ((instance).*(ptrToMemberFn))
 
 namespace Lumos
 {
+	enum class LUMOS_EXPORT NarrowphaseType
+	{
+		SAT = 0,	//Separating axis test over face normals and edge pair cross products
+		GJK_EPA		//Support point based GJK intersection with EPA penetration depth
+	};
+
 	struct LUMOS_EXPORT CollisionData
 	{
 		float penetration;
@@ -36,6 +43,28 @@ namespace Lumos
 			return CALL_MEMBER_FN(*this, m_CollisionCheckFunctions[shape1->GetType() | shape2->GetType()])(obj1, obj2, shape1, shape2, out_coldata);
 		}
 
+		//Generic convex test using GJK/EPA, sphere pairs keep the analytic test
+		bool CheckConvexCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr) const;
+
+		_FORCE_INLINE_ bool CheckCollision(NarrowphaseType type, const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr) const
+		{
+			if (type == NarrowphaseType::GJK_EPA)
+				return CheckConvexCollision(obj1, obj2, shape1, shape2, out_coldata);
+
+			return CheckCollision(obj1, obj2, shape1, shape2, out_coldata);
+		}
+
+		//Conservative advancement of a sphere moving by 'motion' against a (stationary) object.
+		//Returns true if it reaches the object, out_toi is the fraction of motion at which it is within 'slop' of the surface.
+		//Spheres already within 'slop' at the start are left to the discrete test.
+		static bool SweptSphereTimeOfImpact(const Maths::Vector3& start, float radius, const Maths::Vector3& motion, const PhysicsObject3D* obj, const CollisionShape* shape, float slop, float* out_toi);
+
+		//Exact ray test against an object's collision shape. Rays starting inside report a distance of zero.
+		static bool CheckRayCollision(const Maths::Ray& ray, float maxDistance, const PhysicsObject3D* obj, const CollisionShape* shape, float* out_distance, Maths::Vector3* out_normal = nullptr);
+
+		//Slab test of one ray against four boxes at once (SSE when available). Returns one bit per box hit within maxDistance.
+		static u32 CheckRayAABB4(const Maths::Ray& ray, float maxDistance, const Maths::BoundingBox* const* boxes);
+
 		bool BuildCollisionManifold(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, const CollisionData& coldata, Manifold* out_manifold) const;
 
 
@@ -108,9 +137,17 @@ namespace Lumos
 		bool CheckPolyhedronCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr) const;
 		bool CheckPolyhedronSphereCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr) const;
 		bool CheckSphereCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr) const ;
+		bool CheckTriangleMeshCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr) const;
 		bool InvalidCheckCollision(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr) const;
 		static bool CheckCollisionAxis(const Maths::Vector3& axis, const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata);
 
+		//Tests the other body against the mesh triangles near it, returning the deepest contact.
+		//With a manifold every touching triangle adds its contacts.
+		bool CollideTriangleMesh(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata, Manifold* manifold) const;
+
+		//Clips the incident polygon against the reference face (whichever is closer to the collision normal) and adds what is left
+		void AddClippedContacts(std::list<Maths::Vector3>& polygon1, const Maths::Vector3& normal1, std::vector<Maths::Plane>& adjPlanes1, std::list<Maths::Vector3>& polygon2, const Maths::Vector3& normal2, std::vector<Maths::Plane>& adjPlanes2, const CollisionData& coldata, Manifold* manifold) const;
+
 		static Maths::Vector3 GetClosestPointOnEdges(const Maths::Vector3& target, const std::vector<CollisionEdge>& edges);
 		Maths::Vector3 PlaneEdgeIntersection(const Maths::Plane& plane, const Maths::Vector3& start, const Maths::Vector3& end) const;
 		void	SutherlandHodgesonClipping(const std::list<Maths::Vector3>& input_polygon, int num_clip_planes, const Maths::Plane* clip_planes, std::list<Maths::Vector3>* out_polygon, bool removePoints) const;
@@ -0,0 +1,38 @@
+#include "lmpch.h"
+#include "CollisionShape.h"
+#include "Hull.h"
+
+namespace Lumos
+{
+	void CollisionShape::BuildLocalEdges(Hull& hull)
+	{
+		const float epsilon = 0.0001f;
+
+		m_LocalEdges.clear();
+		m_LocalEdgeDirections.clear();
+
+		for (size_t i = 0; i < hull.GetNumEdges(); ++i)
+		{
+			const HullEdge& edge = hull.GetEdge(static_cast<int>(i));
+			const Maths::Vector3 A = m_LocalTransform * hull.GetVertex(edge.vStart).pos;
+			const Maths::Vector3 B = m_LocalTransform * hull.GetVertex(edge.vEnd).pos;
+
+			m_LocalEdges.emplace_back(A, B);
+
+			const Maths::Vector3 direction = (B - A).Normalized();
+
+			bool unique = true;
+			for (const Maths::Vector3& existing : m_LocalEdgeDirections)
+			{
+				if (abs(Maths::Vector3::Dot(direction, existing)) >= (1.0f - epsilon))
+				{
+					unique = false;
+					break;
+				}
+			}
+
+			if (unique)
+				m_LocalEdgeDirections.push_back(direction);
+		}
+	}
+}
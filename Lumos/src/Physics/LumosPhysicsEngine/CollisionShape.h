@@ -5,6 +5,7 @@
 namespace Lumos
 {
 	class PhysicsObject3D;
+	class Hull;
 
 	struct LUMOS_EXPORT CollisionEdge
 	{
@@ -21,6 +22,8 @@ namespace Lumos
 		CollisionSphere = 2,
 		CollisionPyramid = 3,
         CollisionCapsule = 4,
+		CollisionHull = 8,		// Pair checks are indexed by OR-ing the two types
+		CollisionTriangleMesh = 16,
 		CollisionShapeTypeMax
 	};
 
@@ -39,18 +42,18 @@ namespace Lumos
 		virtual void DebugDraw(const PhysicsObject3D* currentObject) const = 0;
 
 		//<----- USED BY COLLISION DETECTION ----->
-		// Get all possible collision axes
+		// Local space collision axes
 		//	- This is a list of all the face normals ignoring any duplicates and parallel vectors.
-		virtual void GetCollisionAxes(
-			const PhysicsObject3D* currentObject,
-			std::vector<Maths::Vector3>* out_axes) const = 0;
+		//	  Built once with the shape, PhysicsObject3D caches the world space copy.
+		const std::vector<Maths::Vector3>& GetLocalCollisionAxes() const { return m_LocalCollisionAxes; }
 
-		// Get all shape Edges
-		//	- Returns a list of all edges AB that form the convex hull of the collision shape. These are
-		//    used to check edge/edge collisions aswell as finding the closest point to a sphere. */
-		virtual void GetEdges(
-			const PhysicsObject3D* currentObject,
-			std::vector<CollisionEdge>* out_edges) const = 0;
+		// Local space shape edges
+		//	- All edges AB that form the convex hull of the collision shape. These are
+		//    used to check edge/edge collisions aswell as finding the closest point to a sphere.
+		const std::vector<CollisionEdge>& GetLocalEdges() const { return m_LocalEdges; }
+
+		// Unique (non parallel) directions of the local edges, used for the edge/edge axes
+		const std::vector<Maths::Vector3>& GetLocalEdgeDirections() const { return m_LocalEdgeDirections; }
 
 		// Get the min/max vertices along a given axis
 		virtual void GetMinMaxVertexOnAxis(
@@ -73,7 +76,14 @@ namespace Lumos
 		_FORCE_INLINE_ CollisionShapeType GetType() const { return m_Type; }
 
 	protected:
+		// Fills the local edges and edge directions from a hull transformed by m_LocalTransform
+		void BuildLocalEdges(Hull& hull);
+
 		CollisionShapeType m_Type;
 		Maths::Matrix4 m_LocalTransform;
+
+		std::vector<Maths::Vector3> m_LocalCollisionAxes;
+		std::vector<CollisionEdge>	m_LocalEdges;
+		std::vector<Maths::Vector3> m_LocalEdgeDirections;
 	};
 }
@@ -3,6 +3,7 @@
 
 namespace Lumos
 {
+	class PhysicsObject3D;
 
 	class LUMOS_EXPORT Constraint
 	{
@@ -22,5 +23,9 @@ namespace Lumos
 		virtual void DebugDraw() const
 		{
 		}
+
+		//Objects linked by this constraint, used to group bodies into simulation islands
+		virtual PhysicsObject3D* GetObjectA() const { return nullptr; }
+		virtual PhysicsObject3D* GetObjectB() const { return nullptr; }
 	};
 }
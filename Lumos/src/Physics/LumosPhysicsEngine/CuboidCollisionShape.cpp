@@ -18,6 +18,8 @@ namespace Lumos
 		{
 			ConstructCubeHull();
 		}
+
+		BuildCollisionData();
 	}
 
 	CuboidCollisionShape::CuboidCollisionShape(const Maths::Vector3& halfdims)
@@ -31,6 +33,8 @@ namespace Lumos
 		{
 			ConstructCubeHull();
 		}
+
+		BuildCollisionData();
 	}
 
 	CuboidCollisionShape::~CuboidCollisionShape()
@@ -51,31 +55,14 @@ namespace Lumos
 		return inertia;
 	}
 
-	void CuboidCollisionShape::GetCollisionAxes(const PhysicsObject3D* currentObject, std::vector<Maths::Vector3>* out_axes) const
+	void CuboidCollisionShape::BuildCollisionData()
 	{
-		if (out_axes)
-		{
-			Maths::Matrix3 objOrientation = currentObject->GetOrientation().RotationMatrix();
-			out_axes->push_back(objOrientation * Maths::Vector3(1.0f, 0.0f, 0.0f)); //X - Axis
-			out_axes->push_back(objOrientation * Maths::Vector3(0.0f, 1.0f, 0.0f)); //Y - Axis
-			out_axes->push_back(objOrientation * Maths::Vector3(0.0f, 0.0f, 1.0f)); //Z - Axis
-		}
-	}
+		m_LocalCollisionAxes.clear();
+		m_LocalCollisionAxes.emplace_back(1.0f, 0.0f, 0.0f); //X - Axis
+		m_LocalCollisionAxes.emplace_back(0.0f, 1.0f, 0.0f); //Y - Axis
+		m_LocalCollisionAxes.emplace_back(0.0f, 0.0f, 1.0f); //Z - Axis
 
-	void CuboidCollisionShape::GetEdges(const PhysicsObject3D* currentObject, std::vector<CollisionEdge>* out_edges) const
-	{
-		if (out_edges)
-		{
-			Maths::Matrix4 transform =  currentObject->GetWorldSpaceTransform() * m_LocalTransform;
-			for (unsigned int i = 0; i < m_CubeHull->GetNumEdges(); ++i)
-			{
-				const HullEdge& edge = m_CubeHull->GetEdge(i);
-				Maths::Vector3 A = transform * m_CubeHull->GetVertex(edge.vStart).pos;
-				Maths::Vector3 B = transform * m_CubeHull->GetVertex(edge.vEnd).pos;
-
-				out_edges->emplace_back(A, B);
-			}
-		}
+		BuildLocalEdges(*m_CubeHull);
 	}
 
 	void CuboidCollisionShape::GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const
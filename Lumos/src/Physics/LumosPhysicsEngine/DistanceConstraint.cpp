@@ -45,16 +45,23 @@ namespace Lumos
 		{
 			float distanceOffset = ab.Length() - m_Distance;
 			float baumgarteScalar = 0.1f;
-            b = -(baumgarteScalar / LumosPhysicsEngine::GetDeltaTime()) * distanceOffset;
+            b = -(baumgarteScalar / m_DeltaTime) * distanceOffset;
 		}
 
 		float jn = -(Maths::Vector3::Dot(v0 - v1, abn) + b) / constraintMass;
 
-		m_pObj1->SetLinearVelocity(m_pObj1->GetLinearVelocity() + abn * (jn * m_pObj1->GetInverseMass()));
-		m_pObj2->SetLinearVelocity(m_pObj2->GetLinearVelocity() - abn * (jn * m_pObj2->GetInverseMass()));
+		// Static and infinite mass ends may be shared with islands solved on other jobs, so they are only read
+		if (m_pObj1->GetIsSolverDynamic())
+		{
+			m_pObj1->SetLinearVelocity(m_pObj1->GetLinearVelocity() + abn * (jn * m_pObj1->GetInverseMass()));
+			m_pObj1->SetAngularVelocity(m_pObj1->GetAngularVelocity() + m_pObj1->GetInverseInertia() * Maths::Vector3::Cross(r1, abn * jn));
+		}
 
-		m_pObj1->SetAngularVelocity(m_pObj1->GetAngularVelocity() + m_pObj1->GetInverseInertia() * Maths::Vector3::Cross(r1, abn * jn));
-		m_pObj2->SetAngularVelocity(m_pObj2->GetAngularVelocity() - m_pObj2->GetInverseInertia() * Maths::Vector3::Cross(r2, abn * jn));
+		if (m_pObj2->GetIsSolverDynamic())
+		{
+			m_pObj2->SetLinearVelocity(m_pObj2->GetLinearVelocity() - abn * (jn * m_pObj2->GetInverseMass()));
+			m_pObj2->SetAngularVelocity(m_pObj2->GetAngularVelocity() - m_pObj2->GetInverseInertia() * Maths::Vector3::Cross(r2, abn * jn));
+		}
 	}
 
 	void DistanceConstraint::DebugDraw() const
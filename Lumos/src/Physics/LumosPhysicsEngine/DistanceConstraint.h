@@ -16,13 +16,18 @@ namespace Lumos
 		DistanceConstraint(PhysicsObject3D *obj1, PhysicsObject3D *obj2, const Maths::Vector3 &globalOnA, const Maths::Vector3 &globalOnB);
 
 		virtual void ApplyImpulse() override;
+		virtual void PreSolverStep(float dt) override { m_DeltaTime = dt; }
 		virtual void DebugDraw() const override;
 
+		PhysicsObject3D* GetObjectA() const override { return m_pObj1; }
+		PhysicsObject3D* GetObjectB() const override { return m_pObj2; }
+
 	protected:
 		PhysicsObject3D *m_pObj1;
 		PhysicsObject3D *m_pObj2;
 
 		float m_Distance;
+		float m_DeltaTime = 1.0f / 60.0f;	//Length of the step being solved
 
 		Maths::Vector3 m_LocalOnA;
 		Maths::Vector3 m_LocalOnB;
@@ -0,0 +1,381 @@
+#include "lmpch.h"
+#include "GJK.h"
+#include "CollisionDetection.h"
+
+namespace Lumos
+{
+	namespace
+	{
+		const float GJK_EPSILON = 1e-6f;
+		const float EPA_TOLERANCE = 1e-4f;
+
+		_FORCE_INLINE_ bool SameDirection(const Maths::Vector3& a, const Maths::Vector3& b)
+		{
+			return Maths::Vector3::Dot(a, b) > 0.0f;
+		}
+
+		struct PolytopeFace
+		{
+			u32 a, b, c;
+			Maths::Vector3 normal;
+			float distance;
+		};
+
+		struct PolytopeEdge
+		{
+			u32 a, b;
+		};
+	}
+
+	GJK::SupportPoint GJK::Support(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, const Maths::Vector3& direction)
+	{
+		Maths::Vector3 axis = direction;
+		axis.Normalize();
+
+		SupportPoint support;
+		shape1->GetMinMaxVertexOnAxis(obj1, axis, nullptr, &support.onA);
+		shape2->GetMinMaxVertexOnAxis(obj2, axis, &support.onB, nullptr);
+		support.point = support.onA - support.onB;
+
+		return support;
+	}
+
+	bool GJK::Intersect(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata)
+	{
+		// Simplex is stored newest point first
+		SupportPoint simplex[4];
+		u32 count = 0;
+
+		Maths::Vector3 direction = obj2->GetPosition() - obj1->GetPosition();
+		if (direction.LengthSquared() < GJK_EPSILON)
+			direction = Maths::Vector3(1.0f, 0.0f, 0.0f);
+
+		simplex[count++] = Support(obj1, obj2, shape1, shape2, direction);
+		direction = -simplex[0].point;
+
+		bool enclosed = false;
+		for (u32 i = 0; i < MaxIterations; ++i)
+		{
+			// Origin lies on the current simplex, the shapes are touching
+			if (direction.LengthSquared() < GJK_EPSILON)
+			{
+				enclosed = true;
+				break;
+			}
+
+			const SupportPoint support = Support(obj1, obj2, shape1, shape2, direction);
+
+			// The furthest point in the search direction doesn't pass the origin, so the origin can't be enclosed
+			if (Maths::Vector3::Dot(support.point, direction) < 0.0f)
+				return false;
+
+			for (u32 j = count; j > 0; --j)
+				simplex[j] = simplex[j - 1];
+			simplex[0] = support;
+			count++;
+
+			if (UpdateSimplex(simplex, count, direction))
+			{
+				enclosed = true;
+				break;
+			}
+		}
+
+		if (!enclosed)
+			return false;
+
+		if (!out_coldata)
+			return true;
+
+		// Touching contacts can end with a degenerate simplex, grow it into a tetrahedron for EPA
+		static const Maths::Vector3 SEARCH_AXES[6] =
+		{
+			Maths::Vector3(1.0f, 0.0f, 0.0f), Maths::Vector3(-1.0f, 0.0f, 0.0f),
+			Maths::Vector3(0.0f, 1.0f, 0.0f), Maths::Vector3(0.0f, -1.0f, 0.0f),
+			Maths::Vector3(0.0f, 0.0f, 1.0f), Maths::Vector3(0.0f, 0.0f, -1.0f)
+		};
+
+		while (count < 4)
+		{
+			bool added = false;
+			for (u32 i = 0; i < 6 && !added; ++i)
+			{
+				Maths::Vector3 searchDir = SEARCH_AXES[i];
+				if (count == 2)
+					searchDir = Maths::Vector3::Cross(simplex[0].point - simplex[1].point, SEARCH_AXES[i]);
+				else if (count == 3)
+					searchDir = Maths::Vector3::Cross(simplex[1].point - simplex[0].point, simplex[2].point - simplex[0].point) * ((i & 1) ? -1.0f : 1.0f);
+
+				if (searchDir.LengthSquared() < GJK_EPSILON)
+					continue;
+
+				const SupportPoint support = Support(obj1, obj2, shape1, shape2, searchDir);
+
+				// Only accept points that increase the dimension of the simplex
+				float extent;
+				if (count == 1)
+					extent = (support.point - simplex[0].point).LengthSquared();
+				else if (count == 2)
+					extent = Maths::Vector3::Cross(simplex[0].point - simplex[1].point, support.point - simplex[1].point).LengthSquared();
+				else
+				{
+					const Maths::Vector3 n = Maths::Vector3::Cross(simplex[1].point - simplex[0].point, simplex[2].point - simplex[0].point);
+					extent = Maths::Squared(Maths::Vector3::Dot(n, support.point - simplex[0].point));
+				}
+
+				if (extent > GJK_EPSILON)
+				{
+					simplex[count++] = support;
+					added = true;
+				}
+			}
+
+			if (!added)
+			{
+				// Flat contact with no volume to expand, report as resting contact along the centre offset
+				Maths::Vector3 normal = obj2->GetPosition() - obj1->GetPosition();
+				normal.Normalize();
+
+				out_coldata->normal = normal;
+				out_coldata->penetration = 0.0f;
+				out_coldata->pointOnPlane = simplex[0].onA;
+				return true;
+			}
+		}
+
+		return ExpandPolytope(obj1, obj2, shape1, shape2, simplex, out_coldata);
+	}
+
+	bool GJK::UpdateSimplex(SupportPoint* simplex, u32& count, Maths::Vector3& direction)
+	{
+		const Maths::Vector3 a = simplex[0].point;
+		const Maths::Vector3 ao = -a;
+
+		switch (count)
+		{
+		case 2:
+		{
+			const Maths::Vector3 ab = simplex[1].point - a;
+
+			if (SameDirection(ab, ao))
+				direction = Maths::Vector3::Cross(Maths::Vector3::Cross(ab, ao), ab);
+			else
+			{
+				count = 1;
+				direction = ao;
+			}
+
+			return false;
+		}
+
+		case 3:
+		{
+			const Maths::Vector3 ab = simplex[1].point - a;
+			const Maths::Vector3 ac = simplex[2].point - a;
+			const Maths::Vector3 abc = Maths::Vector3::Cross(ab, ac);
+
+			if (SameDirection(Maths::Vector3::Cross(abc, ac), ao))
+			{
+				if (SameDirection(ac, ao))
+				{
+					simplex[1] = simplex[2];
+					count = 2;
+					direction = Maths::Vector3::Cross(Maths::Vector3::Cross(ac, ao), ac);
+					return false;
+				}
+
+				count = 2;
+				return UpdateSimplex(simplex, count, direction);
+			}
+
+			if (SameDirection(Maths::Vector3::Cross(ab, abc), ao))
+			{
+				count = 2;
+				return UpdateSimplex(simplex, count, direction);
+			}
+
+			if (SameDirection(abc, ao))
+				direction = abc;
+			else
+			{
+				std::swap(simplex[1], simplex[2]);
+				direction = -abc;
+			}
+
+			return false;
+		}
+
+		case 4:
+		{
+			const Maths::Vector3 ab = simplex[1].point - a;
+			const Maths::Vector3 ac = simplex[2].point - a;
+			const Maths::Vector3 ad = simplex[3].point - a;
+
+			const Maths::Vector3 abc = Maths::Vector3::Cross(ab, ac);
+			const Maths::Vector3 acd = Maths::Vector3::Cross(ac, ad);
+			const Maths::Vector3 adb = Maths::Vector3::Cross(ad, ab);
+
+			if (SameDirection(abc, ao))
+			{
+				count = 3;
+				return UpdateSimplex(simplex, count, direction);
+			}
+
+			if (SameDirection(acd, ao))
+			{
+				simplex[1] = simplex[2];
+				simplex[2] = simplex[3];
+				count = 3;
+				return UpdateSimplex(simplex, count, direction);
+			}
+
+			if (SameDirection(adb, ao))
+			{
+				const SupportPoint b = simplex[1];
+				simplex[1] = simplex[3];
+				simplex[2] = b;
+				count = 3;
+				return UpdateSimplex(simplex, count, direction);
+			}
+
+			return true;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	bool GJK::ExpandPolytope(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, const SupportPoint* simplex, CollisionData* out_coldata)
+	{
+		// Fixed capacity storage, EPA runs for every colliding pair so avoid any heap traffic
+		SupportPoint vertices[MaxPolytopeVertices];
+		PolytopeFace faces[MaxPolytopeFaces];
+		PolytopeEdge edges[MaxPolytopeFaces * 3];
+		u32 vertexCount = 0, faceCount = 0;
+
+		Maths::Vector3 centroid(0.0f);
+		for (u32 i = 0; i < 4; ++i)
+		{
+			vertices[vertexCount++] = simplex[i];
+			centroid += simplex[i].point * 0.25f;
+		}
+
+		// The polytope only grows, so its first centroid stays inside and gives the outward direction of every face
+		auto addFace = [&](u32 a, u32 b, u32 c)
+		{
+			if (faceCount >= MaxPolytopeFaces)
+				return;
+
+			Maths::Vector3 normal = Maths::Vector3::Cross(vertices[b].point - vertices[a].point, vertices[c].point - vertices[a].point);
+			const float length = normal.Length();
+			if (length < GJK_EPSILON)
+				return;
+
+			normal = normal * (1.0f / length);
+			if (Maths::Vector3::Dot(normal, vertices[a].point - centroid) < 0.0f)
+			{
+				std::swap(b, c);
+				normal = -normal;
+			}
+
+			faces[faceCount++] = { a, b, c, normal, Maths::Vector3::Dot(normal, vertices[a].point) };
+		};
+
+		addFace(0, 1, 2);
+		addFace(0, 3, 1);
+		addFace(0, 2, 3);
+		addFace(1, 3, 2);
+
+		if (faceCount == 0)
+			return false;
+
+		u32 closest = 0;
+		for (u32 iteration = 0; iteration < MaxIterations; ++iteration)
+		{
+			closest = 0;
+			for (u32 i = 1; i < faceCount; ++i)
+			{
+				if (faces[i].distance < faces[closest].distance)
+					closest = i;
+			}
+
+			const PolytopeFace face = faces[closest];
+			const SupportPoint support = Support(obj1, obj2, shape1, shape2, face.normal);
+
+			// Converged, the closest face is on the boundary of the minkowski difference
+			if (Maths::Vector3::Dot(support.point, face.normal) - face.distance < EPA_TOLERANCE || vertexCount >= MaxPolytopeVertices)
+				break;
+
+			const u32 newIndex = vertexCount;
+			vertices[vertexCount++] = support;
+
+			// Remove every face visible from the new point, keeping the horizon edges
+			u32 edgeCount = 0;
+			auto addEdge = [&](u32 a, u32 b)
+			{
+				for (u32 i = 0; i < edgeCount; ++i)
+				{
+					if (edges[i].a == b && edges[i].b == a)
+					{
+						edges[i] = edges[--edgeCount];
+						return;
+					}
+				}
+
+				edges[edgeCount++] = { a, b };
+			};
+
+			for (u32 i = 0; i < faceCount;)
+			{
+				if (Maths::Vector3::Dot(faces[i].normal, support.point - vertices[faces[i].a].point) > 0.0f)
+				{
+					addEdge(faces[i].a, faces[i].b);
+					addEdge(faces[i].b, faces[i].c);
+					addEdge(faces[i].c, faces[i].a);
+
+					faces[i] = faces[--faceCount];
+				}
+				else
+					++i;
+			}
+
+			for (u32 i = 0; i < edgeCount; ++i)
+				addFace(edges[i].a, edges[i].b, newIndex);
+
+			if (faceCount == 0)
+				return false;
+		}
+
+		const PolytopeFace& face = faces[closest];
+
+		// Project the origin onto the closest face and interpolate the witness point on A
+		const Maths::Vector3 p = face.normal * face.distance;
+		const Maths::Vector3 v0 = vertices[face.b].point - vertices[face.a].point;
+		const Maths::Vector3 v1 = vertices[face.c].point - vertices[face.a].point;
+		const Maths::Vector3 v2 = p - vertices[face.a].point;
+
+		const float d00 = Maths::Vector3::Dot(v0, v0);
+		const float d01 = Maths::Vector3::Dot(v0, v1);
+		const float d11 = Maths::Vector3::Dot(v1, v1);
+		const float d20 = Maths::Vector3::Dot(v2, v0);
+		const float d21 = Maths::Vector3::Dot(v2, v1);
+		const float denom = d00 * d11 - d01 * d01;
+
+		float v = 0.0f, w = 0.0f;
+		if (fabs(denom) > GJK_EPSILON)
+		{
+			v = (d11 * d20 - d01 * d21) / denom;
+			w = (d00 * d21 - d01 * d20) / denom;
+		}
+		const float u = 1.0f - v - w;
+
+		const Maths::Vector3 onA = vertices[face.a].onA * u + vertices[face.b].onA * v + vertices[face.c].onA * w;
+
+		out_coldata->normal = face.normal;
+		out_coldata->penetration = -face.distance;
+		out_coldata->pointOnPlane = onA + face.normal * out_coldata->penetration;
+
+		return true;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "lmpch.h"
+#include "Maths/Maths.h"
+
+namespace Lumos
+{
+	class PhysicsObject3D;
+	class CollisionShape;
+	struct CollisionData;
+
+	//Gilbert-Johnson-Keerthi intersection test with Expanding Polytope penetration depth.
+	//Works on any convex shape through CollisionShape::GetMinMaxVertexOnAxis, so it only needs
+	//one support query per shape per iteration instead of the face/edge axes used by SAT.
+	class LUMOS_EXPORT GJK
+	{
+	public:
+		struct SupportPoint
+		{
+			Maths::Vector3 point; //Point on the minkowski difference A - B
+			Maths::Vector3 onA;
+			Maths::Vector3 onB;
+		};
+
+		static const u32 MaxIterations = 64;
+		static const u32 MaxPolytopeVertices = 64;
+		static const u32 MaxPolytopeFaces = 128;
+
+		//Returns true if the two shapes overlap. When out_coldata is set the penetration is resolved
+		//with EPA and written using the same conventions as the SAT path (normal from obj1 to obj2, negative penetration).
+		static bool Intersect(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, CollisionData* out_coldata = nullptr);
+
+		static SupportPoint Support(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, const Maths::Vector3& direction);
+
+	private:
+		static bool UpdateSimplex(SupportPoint* simplex, u32& count, Maths::Vector3& direction);
+		static bool ExpandPolytope(const PhysicsObject3D* obj1, const PhysicsObject3D* obj2, const CollisionShape* shape1, const CollisionShape* shape2, const SupportPoint* simplex, CollisionData* out_coldata);
+	};
+}
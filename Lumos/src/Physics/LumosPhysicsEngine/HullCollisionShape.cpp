@@ -0,0 +1,691 @@
+#include "lmpch.h"
+#include "HullCollisionShape.h"
+#include "PhysicsObject3D.h"
+#include "Graphics/Mesh.h"
+
+namespace Lumos
+{
+	namespace
+	{
+		struct QuickHullFace
+		{
+			int v[3];
+			Maths::Vector3 normal;
+			float distance;
+			std::vector<int> outside;	// Points in front of this face that are not yet on the hull
+			bool removed = false;
+		};
+
+		u64 EdgeKey(int a, int b)
+		{
+			return (u64(u32(a)) << 32) | u64(u32(b));
+		}
+
+		//Triangulated convex hull of the points. Returns false if they are (nearly) flat.
+		bool BuildQuickHull(const std::vector<Maths::Vector3>& points, std::vector<QuickHullFace>& out_faces)
+		{
+			const int count = static_cast<int>(points.size());
+			if (count < 4)
+				return false;
+
+			// Initial simplex: the most distant pair of axis extremes, the point furthest from their line, then from their plane
+			int extremes[6] = { 0, 0, 0, 0, 0, 0 };
+			for (int i = 1; i < count; ++i)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (points[i][axis] < points[extremes[axis * 2]][axis]) extremes[axis * 2] = i;
+					if (points[i][axis] > points[extremes[axis * 2 + 1]][axis]) extremes[axis * 2 + 1] = i;
+				}
+			}
+
+			int i0 = 0, i1 = 0;
+			float best = 0.0f;
+			for (int a = 0; a < 6; ++a)
+			{
+				for (int b = a + 1; b < 6; ++b)
+				{
+					const float distance = (points[extremes[a]] - points[extremes[b]]).LengthSquared();
+					if (distance > best)
+					{
+						best = distance;
+						i0 = extremes[a];
+						i1 = extremes[b];
+					}
+				}
+			}
+
+			const float epsilon = Maths::Max(1e-5f * sqrtf(best), Maths::M_EPSILON);
+			if (sqrtf(best) < epsilon * 10.0f)
+				return false;
+
+			int i2 = -1;
+			best = epsilon;
+			const Maths::Vector3 lineDirection = (points[i1] - points[i0]).Normalized();
+			for (int i = 0; i < count; ++i)
+			{
+				const Maths::Vector3 offset = points[i] - points[i0];
+				const float distance = (offset - lineDirection * offset.DotProduct(lineDirection)).Length();
+				if (distance > best)
+				{
+					best = distance;
+					i2 = i;
+				}
+			}
+
+			if (i2 < 0)
+				return false;
+
+			int i3 = -1;
+			best = epsilon;
+			const Maths::Vector3 planeNormal = Maths::Vector3::Cross(points[i1] - points[i0], points[i2] - points[i0]).Normalized();
+			for (int i = 0; i < count; ++i)
+			{
+				const float distance = abs(planeNormal.DotProduct(points[i] - points[i0]));
+				if (distance > best)
+				{
+					best = distance;
+					i3 = i;
+				}
+			}
+
+			if (i3 < 0)
+				return false;
+
+			// Stays inside the hull as it grows, used to orient every new face outwards
+			const Maths::Vector3 interior = (points[i0] + points[i1] + points[i2] + points[i3]) * 0.25f;
+
+			std::vector<QuickHullFace>& faces = out_faces;
+			std::unordered_map<u64, int> edges;	// Directed edge -> face
+			faces.clear();
+
+			auto addFace = [&](int a, int b, int c) -> int
+			{
+				QuickHullFace face;
+				face.normal = Maths::Vector3::Cross(points[b] - points[a], points[c] - points[a]);
+				if (face.normal.DotProduct(interior - points[a]) > 0.0f)
+				{
+					std::swap(b, c);
+					face.normal = -face.normal;
+				}
+
+				face.normal.Normalize();
+				face.distance = face.normal.DotProduct(points[a]);
+				face.v[0] = a;
+				face.v[1] = b;
+				face.v[2] = c;
+
+				const int index = static_cast<int>(faces.size());
+				edges[EdgeKey(a, b)] = index;
+				edges[EdgeKey(b, c)] = index;
+				edges[EdgeKey(c, a)] = index;
+				faces.push_back(std::move(face));
+				return index;
+			};
+
+			auto assignPoint = [&](int point, const std::vector<int>& candidates)
+			{
+				int bestFace = -1;
+				float bestDistance = epsilon;
+				for (int f : candidates)
+				{
+					const float distance = faces[f].normal.DotProduct(points[point]) - faces[f].distance;
+					if (distance > bestDistance)
+					{
+						bestDistance = distance;
+						bestFace = f;
+					}
+				}
+
+				// Points behind every candidate face are inside the hull and dropped
+				if (bestFace >= 0)
+					faces[bestFace].outside.push_back(point);
+			};
+
+			std::vector<int> newFaces = { addFace(i0, i1, i2), addFace(i0, i3, i1), addFace(i1, i3, i2), addFace(i2, i3, i0) };
+			for (int i = 0; i < count; ++i)
+			{
+				if (i != i0 && i != i1 && i != i2 && i != i3)
+					assignPoint(i, newFaces);
+			}
+
+			std::vector<int> visible;
+			std::vector<u32> visibleStamp;
+			std::vector<std::pair<int, int>> horizon;
+			std::vector<int> orphans;
+
+			// New faces are appended, so one pass visits every face that ever gets outside points
+			for (size_t f = 0; f < faces.size(); ++f)
+			{
+				if (faces[f].removed || faces[f].outside.empty())
+					continue;
+
+				int eye = faces[f].outside[0];
+				float eyeDistance = -Maths::M_INFINITY;
+				for (int point : faces[f].outside)
+				{
+					const float distance = faces[f].normal.DotProduct(points[point]) - faces[f].distance;
+					if (distance > eyeDistance)
+					{
+						eyeDistance = distance;
+						eye = point;
+					}
+				}
+
+				const u32 stamp = static_cast<u32>(f) + 1;
+				visibleStamp.resize(faces.size(), 0);
+				visible.clear();
+				for (size_t j = 0; j < faces.size(); ++j)
+				{
+					if (!faces[j].removed && faces[j].normal.DotProduct(points[eye]) - faces[j].distance > epsilon)
+					{
+						visible.push_back(static_cast<int>(j));
+						visibleStamp[j] = stamp;
+					}
+				}
+
+				// Edges of the visible region whose neighbour is not visible
+				horizon.clear();
+				for (int j : visible)
+				{
+					for (int e = 0; e < 3; ++e)
+					{
+						const int a = faces[j].v[e];
+						const int b = faces[j].v[(e + 1) % 3];
+						auto twin = edges.find(EdgeKey(b, a));
+						if (twin == edges.end() || visibleStamp[twin->second] != stamp)
+							horizon.emplace_back(a, b);
+					}
+				}
+
+				orphans.clear();
+				for (int j : visible)
+				{
+					QuickHullFace& face = faces[j];
+					face.removed = true;
+
+					for (int e = 0; e < 3; ++e)
+					{
+						auto it = edges.find(EdgeKey(face.v[e], face.v[(e + 1) % 3]));
+						if (it != edges.end() && it->second == j)
+							edges.erase(it);
+					}
+
+					for (int point : face.outside)
+					{
+						if (point != eye)
+							orphans.push_back(point);
+					}
+
+					std::vector<int>().swap(face.outside);
+				}
+
+				newFaces.clear();
+				for (const auto& edge : horizon)
+					newFaces.push_back(addFace(edge.first, edge.second, eye));
+
+				for (int point : orphans)
+					assignPoint(point, newFaces);
+			}
+
+			faces.erase(std::remove_if(faces.begin(), faces.end(), [](const QuickHullFace& face) { return face.removed; }), faces.end());
+			return true;
+		}
+
+		//Merges neighbouring triangles that are (nearly) coplanar with a seed triangle into polygons
+		//and compacts the vertex list down to the vertices used by the hull
+		void BuildPolygons(const std::vector<Maths::Vector3>& points, const std::vector<QuickHullFace>& triangles, std::vector<Maths::Vector3>& out_vertices, std::vector<std::vector<int>>& out_faces)
+		{
+			const float coplanarCosine = 0.9995f;
+			const int triangleCount = static_cast<int>(triangles.size());
+
+			std::unordered_map<u64, int> edges;
+			for (int t = 0; t < triangleCount; ++t)
+			{
+				for (int e = 0; e < 3; ++e)
+					edges[EdgeKey(triangles[t].v[e], triangles[t].v[(e + 1) % 3])] = t;
+			}
+
+			std::vector<int> group(triangleCount, -1);
+			std::vector<int> members;
+			std::vector<int> stack;
+			std::unordered_map<int, int> next;
+			std::unordered_map<int, int> remap;
+
+			auto addVertex = [&](int point) -> int
+			{
+				auto it = remap.find(point);
+				if (it != remap.end())
+					return it->second;
+
+				const int index = static_cast<int>(out_vertices.size());
+				remap[point] = index;
+				out_vertices.push_back(points[point]);
+				return index;
+			};
+
+			out_vertices.clear();
+			out_faces.clear();
+
+			for (int seed = 0; seed < triangleCount; ++seed)
+			{
+				if (group[seed] >= 0)
+					continue;
+
+				// Flood fill comparing against the seed normal, so curved surfaces don't merge into one face
+				members.clear();
+				stack.assign(1, seed);
+				group[seed] = seed;
+
+				while (!stack.empty())
+				{
+					const int t = stack.back();
+					stack.pop_back();
+					members.push_back(t);
+
+					for (int e = 0; e < 3; ++e)
+					{
+						auto twin = edges.find(EdgeKey(triangles[t].v[(e + 1) % 3], triangles[t].v[e]));
+						if (twin != edges.end() && group[twin->second] < 0 && triangles[twin->second].normal.DotProduct(triangles[seed].normal) > coplanarCosine)
+						{
+							group[twin->second] = seed;
+							stack.push_back(twin->second);
+						}
+					}
+				}
+
+				// Boundary edges of the group chain into the polygon outline
+				next.clear();
+				for (int t : members)
+				{
+					for (int e = 0; e < 3; ++e)
+					{
+						const int a = triangles[t].v[e];
+						const int b = triangles[t].v[(e + 1) % 3];
+						auto twin = edges.find(EdgeKey(b, a));
+						if (twin == edges.end() || group[twin->second] != seed)
+							next[a] = b;
+					}
+				}
+
+				std::vector<int> polygon;
+				int vertex = next.begin()->first;
+				do
+				{
+					polygon.push_back(vertex);
+					auto it = next.find(vertex);
+					vertex = it != next.end() ? it->second : -1;
+				} while (vertex != polygon[0] && vertex >= 0 && polygon.size() <= next.size());
+
+				if (vertex == polygon[0] && polygon.size() == next.size())
+				{
+					for (int& v : polygon)
+						v = addVertex(v);
+					out_faces.push_back(std::move(polygon));
+				}
+				else
+				{
+					// Outline is not a single loop, keep the triangles
+					for (int t : members)
+						out_faces.push_back({ addVertex(triangles[t].v[0]), addVertex(triangles[t].v[1]), addVertex(triangles[t].v[2]) });
+				}
+			}
+		}
+
+		// Newell's method, robust for polygons with (nearly) collinear vertices
+		Maths::Vector3 PolygonNormal(const std::vector<Maths::Vector3>& vertices, const std::vector<int>& face)
+		{
+			Maths::Vector3 normal(0.0f);
+			for (size_t i = 0; i < face.size(); ++i)
+			{
+				const Maths::Vector3& a = vertices[face[i]];
+				const Maths::Vector3& b = vertices[face[(i + 1) % face.size()]];
+				normal.x += (a.y - b.y) * (a.z + b.z);
+				normal.y += (a.z - b.z) * (a.x + b.x);
+				normal.z += (a.x - b.x) * (a.y + b.y);
+			}
+
+			return normal.Normalized();
+		}
+	}
+
+	HullCollisionShape::HullCollisionShape()
+		: m_Hull(CreateRef<Hull>())
+		, m_HalfExtents(0.0f)
+		, m_Radius(0.0f)
+	{
+		m_Type = CollisionShapeType::CollisionHull;
+	}
+
+	HullCollisionShape::HullCollisionShape(const std::vector<Maths::Vector3>& points, u32 maxVertices)
+		: HullCollisionShape()
+	{
+		Build(points, maxVertices);
+	}
+
+	HullCollisionShape::~HullCollisionShape()
+	{
+	}
+
+	Ref<HullCollisionShape> HullCollisionShape::CreateFromMesh(const Graphics::Vertex* vertices, u32 vertexCount, u32 maxVertices)
+	{
+		std::vector<Maths::Vector3> points(vertexCount);
+		for (u32 i = 0; i < vertexCount; ++i)
+			points[i] = vertices[i].Position;
+
+		return CreateRef<HullCollisionShape>(points, maxVertices);
+	}
+
+	void HullCollisionShape::Build(const std::vector<Maths::Vector3>& points, u32 maxVertices)
+	{
+		std::vector<QuickHullFace> triangles;
+		std::vector<Maths::Vector3> vertices;
+		std::vector<std::vector<int>> faces;
+
+		if (!BuildQuickHull(points, triangles))
+		{
+			// Flat or degenerate input, use its bounds with a minimum thickness instead
+			Maths::BoundingBox bounds;
+			for (const Maths::Vector3& point : points)
+				bounds.Merge(point);
+
+			if (points.empty())
+				bounds.Define(Maths::Vector3(0.0f));
+
+			const Maths::Vector3 size = bounds.Size();
+			const float thickness = Maths::Max(0.01f, Maths::Max(size.x, Maths::Max(size.y, size.z)) * 0.01f);
+			const Maths::Vector3 halfSize = Maths::Vector3(Maths::Max(size.x, thickness), Maths::Max(size.y, thickness), Maths::Max(size.z, thickness)) * 0.5f;
+			const Maths::Vector3 centre = bounds.Center();
+
+			Debug::Log::Warning("Hull collision shape built from flat or degenerate points, using their bounds");
+
+			std::vector<Maths::Vector3> corners;
+			for (int i = 0; i < 8; ++i)
+				corners.push_back(centre + Maths::Vector3((i & 1) ? halfSize.x : -halfSize.x, (i & 2) ? halfSize.y : -halfSize.y, (i & 4) ? halfSize.z : -halfSize.z));
+
+			BuildQuickHull(corners, triangles);
+			BuildPolygons(corners, triangles, vertices, faces);
+			SetHull(vertices, faces);
+			return;
+		}
+
+		BuildPolygons(points, triangles, vertices, faces);
+
+		maxVertices = Maths::Max(maxVertices, 4u);
+		if (vertices.size() > maxVertices)
+		{
+			// Keep the support vertex along each of maxVertices evenly spread (fibonacci sphere) directions
+			const float goldenAngle = Maths::M_PI * (3.0f - sqrtf(5.0f));
+			std::vector<bool> keep(vertices.size(), false);
+			std::vector<Maths::Vector3> simplified;
+
+			for (u32 i = 0; i < maxVertices; ++i)
+			{
+				const float y = 1.0f - 2.0f * (float(i) + 0.5f) / float(maxVertices);
+				const float r = sqrtf(Maths::Max(0.0f, 1.0f - y * y));
+				const Maths::Vector3 direction(cosf(goldenAngle * float(i)) * r, y, sinf(goldenAngle * float(i)) * r);
+
+				size_t support = 0;
+				float best = -Maths::M_INFINITY;
+				for (size_t v = 0; v < vertices.size(); ++v)
+				{
+					const float distance = direction.DotProduct(vertices[v]);
+					if (distance > best)
+					{
+						best = distance;
+						support = v;
+					}
+				}
+
+				if (!keep[support])
+				{
+					keep[support] = true;
+					simplified.push_back(vertices[support]);
+				}
+			}
+
+			std::vector<Maths::Vector3> simplifiedVertices;
+			std::vector<std::vector<int>> simplifiedFaces;
+			if (BuildQuickHull(simplified, triangles))
+			{
+				BuildPolygons(simplified, triangles, simplifiedVertices, simplifiedFaces);
+				vertices.swap(simplifiedVertices);
+				faces.swap(simplifiedFaces);
+			}
+		}
+
+		SetHull(vertices, faces);
+	}
+
+	void HullCollisionShape::SetHull(const std::vector<Maths::Vector3>& vertices, const std::vector<std::vector<int>>& faces)
+	{
+		m_Vertices = vertices;
+		m_Faces = faces;
+
+		m_Hull = CreateRef<Hull>();
+		for (const Maths::Vector3& vertex : m_Vertices)
+			m_Hull->AddVertex(vertex);
+
+		m_LocalCollisionAxes.clear();
+		for (const std::vector<int>& face : m_Faces)
+		{
+			const Maths::Vector3 normal = PolygonNormal(m_Vertices, face);
+			m_Hull->AddFace(normal, face);
+
+			// Opposite faces share an axis
+			const bool unique = std::none_of(m_LocalCollisionAxes.begin(), m_LocalCollisionAxes.end(), [&](const Maths::Vector3& axis)
+			{
+				return abs(Maths::Vector3::Dot(axis, normal)) >= (1.0f - 0.0001f);
+			});
+
+			if (unique)
+				m_LocalCollisionAxes.push_back(normal);
+		}
+
+		BuildLocalEdges(*m_Hull);
+
+		// Vertex adjacency in one flat array for the support queries
+		m_NeighbourOffsets.assign(m_Vertices.size() + 1, 0);
+		m_Neighbours.clear();
+		for (size_t i = 0; i < m_Vertices.size(); ++i)
+		{
+			m_NeighbourOffsets[i] = static_cast<u32>(m_Neighbours.size());
+			for (int edgeIdx : m_Hull->GetVertex(static_cast<int>(i)).enclosing_edges)
+			{
+				const HullEdge& edge = m_Hull->GetEdge(edgeIdx);
+				m_Neighbours.push_back(static_cast<u32>(edge.vStart == static_cast<int>(i) ? edge.vEnd : edge.vStart));
+			}
+		}
+		m_NeighbourOffsets[m_Vertices.size()] = static_cast<u32>(m_Neighbours.size());
+
+		Maths::BoundingBox bounds;
+		m_Radius = 0.0f;
+		for (const Maths::Vector3& vertex : m_Vertices)
+		{
+			bounds.Merge(vertex);
+			m_Radius = Maths::Max(m_Radius, vertex.Length());
+		}
+
+		m_HalfExtents = m_Vertices.empty() ? Maths::Vector3(0.0f) : bounds.HalfSize();
+	}
+
+	int HullCollisionShape::FindSupportVertex(const Maths::Vector3& localAxis) const
+	{
+		// The vertex graph of a convex hull has no local maxima, so walking to a better neighbour always reaches the support vertex
+		u32 current = 0;
+		float best = localAxis.DotProduct(m_Vertices[0]);
+
+		bool improved = true;
+		while (improved)
+		{
+			improved = false;
+			for (u32 i = m_NeighbourOffsets[current]; i < m_NeighbourOffsets[current + 1]; ++i)
+			{
+				const u32 neighbour = m_Neighbours[i];
+				const float distance = localAxis.DotProduct(m_Vertices[neighbour]);
+				if (distance > best)
+				{
+					best = distance;
+					current = neighbour;
+					improved = true;
+				}
+			}
+		}
+
+		return static_cast<int>(current);
+	}
+
+	Maths::Matrix3 HullCollisionShape::BuildInverseInertia(float invMass) const
+	{
+		// Approximated by the solid box of the hull bounds
+		Maths::Matrix3 inertia;
+
+		Maths::Vector3 dimsSq = (m_HalfExtents + m_HalfExtents);
+		dimsSq = dimsSq * dimsSq;
+
+		inertia.m00_ = 12.f * invMass * 1.f / (dimsSq.y + dimsSq.z);
+		inertia.m11_ = 12.f * invMass * 1.f / (dimsSq.x + dimsSq.z);
+		inertia.m22_ = 12.f * invMass * 1.f / (dimsSq.x + dimsSq.y);
+
+		return inertia;
+	}
+
+	void HullCollisionShape::GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const
+	{
+		Maths::Matrix4 wsTransform;
+
+		if (currentObject == nullptr)
+			wsTransform = m_LocalTransform;
+		else
+			wsTransform = currentObject->GetWorldSpaceTransform() * m_LocalTransform;
+
+		if (m_Vertices.empty())
+		{
+			if (out_min) *out_min = wsTransform.Translation();
+			if (out_max) *out_max = wsTransform.Translation();
+			return;
+		}
+
+		const Maths::Matrix3 invNormalMatrix = wsTransform.ToMatrix3().Transpose();
+		const Maths::Vector3 local_axis = invNormalMatrix * axis;
+
+		if (out_min) *out_min = wsTransform * m_Vertices[FindSupportVertex(-local_axis)];
+		if (out_max) *out_max = wsTransform * m_Vertices[FindSupportVertex(local_axis)];
+	}
+
+	void HullCollisionShape::GetIncidentReferencePolygon(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, std::list<Maths::Vector3>* out_face, Maths::Vector3* out_normal, std::vector<Maths::Plane>* out_adjacent_planes) const
+	{
+		if (m_Vertices.empty())
+			return;
+
+		Maths::Matrix4 wsTransform;
+
+		if (currentObject == nullptr)
+			wsTransform = m_LocalTransform;
+		else
+			wsTransform = currentObject->GetWorldSpaceTransform() * m_LocalTransform;
+
+		const Maths::Matrix3 invNormalMatrix = wsTransform.ToMatrix3().Inverse();
+		const Maths::Matrix3 normalMatrix = invNormalMatrix.Transpose();
+
+		const Maths::Vector3 local_axis = invNormalMatrix * axis;
+
+		const HullVertex& vert = m_Hull->GetVertex(FindSupportVertex(local_axis));
+
+		const HullFace* best_face = nullptr;
+		float best_correlation = -FLT_MAX;
+		for (int faceIdx : vert.enclosing_faces)
+		{
+			const HullFace* face = &m_Hull->GetFace(faceIdx);
+			const float temp_correlation = Maths::Vector3::Dot(local_axis, face->normal);
+			if (temp_correlation > best_correlation)
+			{
+				best_correlation = temp_correlation;
+				best_face = face;
+			}
+		}
+
+		if (out_normal)
+		{
+			if (best_face)
+				*out_normal = normalMatrix * best_face->normal;
+			(*out_normal).Normalize();
+		}
+
+		if (out_face && best_face)
+		{
+			for (int vertIdx : best_face->vert_ids)
+				out_face->push_back(wsTransform * m_Vertices[vertIdx]);
+		}
+
+		if (out_adjacent_planes && best_face != nullptr)
+		{
+			//Add the reference face itself to the list of adjacent planes
+			Maths::Vector3 wsPointOnPlane = wsTransform * m_Vertices[m_Hull->GetEdge(best_face->edge_ids[0]).vStart];
+			Maths::Vector3 planeNrml = -(normalMatrix * best_face->normal);
+			planeNrml.Normalize();
+			float planeDist = -Maths::Vector3::Dot(planeNrml, wsPointOnPlane);
+
+			out_adjacent_planes->emplace_back(planeNrml, planeDist);
+
+			for (int edgeIdx : best_face->edge_ids)
+			{
+				const HullEdge& edge = m_Hull->GetEdge(edgeIdx);
+
+				wsPointOnPlane = wsTransform * m_Vertices[edge.vStart];
+
+				for (int adjFaceIdx : edge.enclosing_faces)
+				{
+					if (adjFaceIdx != best_face->idx)
+					{
+						const HullFace& adjFace = m_Hull->GetFace(adjFaceIdx);
+
+						planeNrml = -(normalMatrix * adjFace.normal);
+						planeNrml.Normalize();
+						planeDist = -Maths::Vector3::Dot(planeNrml, wsPointOnPlane);
+
+						out_adjacent_planes->emplace_back(planeNrml, planeDist);
+					}
+				}
+			}
+		}
+	}
+
+	void HullCollisionShape::DebugDraw(const PhysicsObject3D* currentObject) const
+	{
+		const Maths::Matrix4 transform = currentObject->GetWorldSpaceTransform() * m_LocalTransform;
+
+		m_Hull->DebugDraw(transform);
+	}
+
+	nlohmann::json HullCollisionShape::Serialise()
+	{
+		nlohmann::json output;
+		output["typeID"] = LUMOS_TYPENAME(HullCollisionShape);
+
+		std::vector<float> vertices;
+		vertices.reserve(m_Vertices.size() * 3);
+		for (const Maths::Vector3& vertex : m_Vertices)
+		{
+			vertices.push_back(vertex.x);
+			vertices.push_back(vertex.y);
+			vertices.push_back(vertex.z);
+		}
+
+		output["vertices"] = vertices;
+		output["faces"] = m_Faces;
+
+		return output;
+	}
+
+	void HullCollisionShape::Deserialise(nlohmann::json& data)
+	{
+		const std::vector<float> flatVertices = data["vertices"].get<std::vector<float>>();
+
+		std::vector<Maths::Vector3> vertices(flatVertices.size() / 3);
+		for (size_t i = 0; i < vertices.size(); ++i)
+			vertices[i] = Maths::Vector3(flatVertices[i * 3], flatVertices[i * 3 + 1], flatVertices[i * 3 + 2]);
+
+		SetHull(vertices, data["faces"].get<std::vector<std::vector<int>>>());
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "lmpch.h"
+#include "CollisionShape.h"
+#include "Hull.h"
+#include "Core/Serialisable.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		struct Vertex;
+	}
+
+	//Convex hull of an arbitrary point cloud (usually mesh vertices) built with quickhull.
+	//Hulls with more vertices than requested are simplified to the support points along evenly
+	//spread directions. Building is meant to happen once at import time, Serialise stores the
+	//finished hull so loading only rebuilds the adjacency.
+	class LUMOS_EXPORT HullCollisionShape : public CollisionShape, public Serialisable
+	{
+	public:
+		static const u32 DefaultMaxVertices = 32;
+
+		HullCollisionShape();
+		explicit HullCollisionShape(const std::vector<Maths::Vector3>& points, u32 maxVertices = DefaultMaxVertices);
+		~HullCollisionShape();
+
+		static Ref<HullCollisionShape> CreateFromMesh(const Graphics::Vertex* vertices, u32 vertexCount, u32 maxVertices = DefaultMaxVertices);
+
+		//Collision Shape Functionality
+		virtual Maths::Matrix3 BuildInverseInertia(float invMass) const override;
+		virtual float GetSize() const override { return m_Radius; }
+
+		virtual void GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const override;
+		virtual void GetIncidentReferencePolygon(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, std::list<Maths::Vector3>* out_face, Maths::Vector3* out_normal, std::vector<Maths::Plane>* out_adjacent_planes) const override;
+
+		virtual void DebugDraw(const PhysicsObject3D* currentObject) const override;
+
+		u32 GetNumVertices() const { return static_cast<u32>(m_Vertices.size()); }
+		u32 GetNumFaces() const { return static_cast<u32>(m_Faces.size()); }
+		const std::vector<Maths::Vector3>& GetVertices() const { return m_Vertices; }
+
+		nlohmann::json Serialise() override;
+		void Deserialise(nlohmann::json& data) override;
+
+	protected:
+		void Build(const std::vector<Maths::Vector3>& points, u32 maxVertices);
+
+		//Sets the hull from its vertices and faces (counter clockwise vertex ids) and caches everything derived from them
+		void SetHull(const std::vector<Maths::Vector3>& vertices, const std::vector<std::vector<int>>& faces);
+
+		//Hill climbs the vertex adjacency towards the furthest vertex along the axis
+		int FindSupportVertex(const Maths::Vector3& localAxis) const;
+
+	protected:
+		Ref<Hull> m_Hull;
+
+		std::vector<Maths::Vector3>	  m_Vertices;			//!< Hull vertices, same order as in m_Hull
+		std::vector<std::vector<int>> m_Faces;
+		std::vector<u32>			  m_NeighbourOffsets;	//!< Neighbours of vertex i are m_Neighbours[m_NeighbourOffsets[i] .. m_NeighbourOffsets[i + 1]]
+		std::vector<u32>			  m_Neighbours;
+
+		Maths::Vector3 m_HalfExtents;
+		float		   m_Radius;
+	};
+}
@@ -5,6 +5,13 @@
 
 namespace Lumos
 {
+	enum class LUMOS_EXPORT IntegrationType
+	{
+		EXPLICIT_EULER = 0,
+		SEMI_IMPLICIT_EULER,
+		RUNGE_KUTTA_2,
+		RUNGE_KUTTA_4
+	};
 
 	class LUMOS_EXPORT Integration
 	{
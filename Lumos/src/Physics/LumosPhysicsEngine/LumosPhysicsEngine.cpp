@@ -2,6 +2,8 @@
 #include "LumosPhysicsEngine.h"
 #include "CollisionDetection.h"
 #include "PhysicsObject3D.h"
+#include "SphereCollisionShape.h"
+#include "CuboidCollisionShape.h"
 #include "Core/OS/Window.h"
 
 #include "Integration.h"
@@ -9,17 +11,44 @@
 #include "Utilities/TimeStep.h"
 #include "Core/JobSystem.h"
 #include "Core/Profiler.h"
+#include "Utilities/Timer.h"
 
 #include "ECS/Component/Physics3DComponent.h"
+#include "ECS/DirtySet.h"
 #include "Maths/Transform.h"
 
 #include <imgui/imgui.h>
 
 namespace Lumos
 {
+	namespace
+	{
+		const u32 StateMagic = 0x5350484C; // "LHPS"
+		const u32 StateVersion = 1;
+
+		struct StateHeader
+		{
+			u32 magic;
+			u32 version;
+			u32 bodyCount;
+			u32 padding;
+			u64 stepCount;
+		};
+
+		//Everything a step reads from a body that is not configuration (mass, shape, material)
+		struct BodyState
+		{
+			Maths::Vector3	  position;
+			Maths::Quaternion orientation;
+			Maths::Vector3	  linearVelocity;
+			Maths::Vector3	  angularVelocity;
+			Maths::Vector3	  force;
+			Maths::Vector3	  torque;
+			float			  averageSummedVelocity;
+			u32				  atRest;
+		};
+	}
 
-    float LumosPhysicsEngine::s_UpdateTimestep = 1.0f/60.0f;
-    
 	LumosPhysicsEngine::LumosPhysicsEngine()
 		: m_IsPaused(true)
 		, m_UpdateAccum(0.0f)
@@ -27,6 +56,9 @@ namespace Lumos
 		, m_DampingFactor(0.999f)
 		, m_BroadphaseDetection(nullptr)
 		, m_IntegrationType(IntegrationType::RUNGE_KUTTA_4)
+		, m_NarrowphaseType(NarrowphaseType::SAT)
+		, m_Budget(10, 50)
+		, m_SolverIterations(50)
 	{
         m_DebugName = "Lumos3DPhysicsEngine";
 		m_PhysicsObjects.reserve(100);
@@ -35,16 +67,19 @@ namespace Lumos
 	void LumosPhysicsEngine::SetDefaults()
 	{
 		m_IsPaused = true;
-		s_UpdateTimestep = 1.0f / 60.f;
+		m_UpdateTimestep = 1.0f / 60.f;
 		m_UpdateAccum = 0.0f;
 		m_Gravity = Maths::Vector3(0.0f, -9.81f, 0.0f);
 		m_DampingFactor = 0.999f;
 		m_IntegrationType = IntegrationType::RUNGE_KUTTA_4;
+		m_NarrowphaseType = NarrowphaseType::SAT;
+		m_Deterministic = false;
+		m_StepCount = 0;
 	}
 
 	LumosPhysicsEngine::~LumosPhysicsEngine()
 	{
-        m_PhysicsObjects.clear();
+        DisconnectRegistry();
         
         for (Constraint* c : m_Constraints)
             delete c;
@@ -53,8 +88,6 @@ namespace Lumos
         for (Manifold* m : m_Manifolds)
             delete m;
         m_Manifolds.clear();
-        
-		CollisionDetection::Release();
 	}
 
 	void LumosPhysicsEngine::OnUpdate(TimeStep* timeStep, Scene* scene)
@@ -62,213 +95,315 @@ namespace Lumos
         LUMOS_PROFILE_BLOCK("LumosPhysicsEngine::OnUpdate");
 		if (!m_IsPaused)
 		{
-            m_PhysicsObjects.clear();
-            
             auto& registry = scene->GetRegistry();
-            
-            auto group = registry.group<Physics3DComponent>(entt::get<Maths::Transform>);
 
-            if (group.empty())
+            LUMOS_CORE_ASSERT(m_Registry == &registry, "Updated without attaching to the scene");
+            if (m_Registry != &registry)
+                return;
+
+            SyncBodyList();
+
+            if (m_PhysicsObjects.empty())
                 return;
             
-            for(auto entity : group)
-            {
-                const auto &phys = group.get<Physics3DComponent>(entity);
-
-                auto& physicsObj = phys.GetPhysicsObject();
-                               
-                if(physicsObj)
-                    m_PhysicsObjects.emplace_back(physicsObj);
-            };
-            
-			if (m_MultipleUpdates)
+			if (m_MultipleUpdates || m_Deterministic)
 			{
-				const int max_updates_per_frame = 5;
-
 				m_UpdateAccum += timeStep->GetMillis();
-				for (int i = 0; (m_UpdateAccum >= s_UpdateTimestep) && i < max_updates_per_frame; ++i)
-				{
-					m_UpdateAccum -= s_UpdateTimestep;
-					UpdatePhysics(scene);
-				}
 
-				if (m_UpdateAccum >= s_UpdateTimestep)
-				{
-					Debug::Log::Error("Physics too slow to run in real time!");
-					//Drop Time in the hope that it can continue to run in real-time
-					m_UpdateAccum = 0.0f;
-				}
+				// Deterministic mode keeps the remaining time for the next frame, dropping it would desync peers
+				const u32 steps = m_Budget.BeginFrame(m_UpdateAccum, m_UpdateTimestep, m_Deterministic);
+				for (u32 i = 0; i < steps; ++i)
+					UpdatePhysics(scene);
 			}
 			else
 			{
-				s_UpdateTimestep = timeStep->GetMillis();
+				m_UpdateTimestep = timeStep->GetMillis();
 				UpdatePhysics(scene);
 			}
             
-            for(auto entity : group)
-            {
-                const auto &[phys,trans] = group.get<Physics3DComponent, Maths::Transform>(entity);
-
-                trans.SetLocalPosition(phys.GetPhysicsObject()->GetPosition());
-                trans.SetLocalOrientation(phys.GetPhysicsObject()->GetOrientation());
-            };
+            WriteBackTransforms(registry);
 		}
 	}
 
-	void LumosPhysicsEngine::UpdatePhysics(Scene* scene)
+	void LumosPhysicsEngine::DeclareAccess(SystemAccess& access) const
 	{
-        
-		for (Manifold* m : m_Manifolds)
+		access.Write<Physics3DComponent>();
+		access.Write<Maths::Transform, Physics3DComponent>();
+		// Marking the transforms changed edits the dirty sets every Transform producer shares
+		access.Write<ComponentChanges<Maths::Transform>>();
+	}
+
+	void LumosPhysicsEngine::OnSceneAttach(Scene* scene)
+	{
+		auto& registry = scene->GetRegistry();
+		if (m_Registry != &registry)
+			ConnectRegistry(registry);
+
+		// Creates the pool written back to, if no entity has a transform yet
+		registry.view<Maths::Transform>();
+	}
+
+	void LumosPhysicsEngine::OnSceneDetach(Scene* scene)
+	{
+		DisconnectRegistry();
+	}
+
+	void LumosPhysicsEngine::ConnectRegistry(entt::registry& registry)
+	{
+		DisconnectRegistry();
+
+		m_Registry = &registry;
+		registry.on_construct<Physics3DComponent>().connect<&LumosPhysicsEngine::OnBodyConstruct>(*this);
+		registry.on_replace<Physics3DComponent>().connect<&LumosPhysicsEngine::OnBodyReplace>(*this);
+		registry.on_destroy<Physics3DComponent>().connect<&LumosPhysicsEngine::OnBodyDestroy>(*this);
+
+		// Pick up the components created before the engine was connected
+		auto view = registry.view<Physics3DComponent>();
+		for (auto entity : view)
+			AddBody(entity, view.get(entity).GetPhysicsObject());
+	}
+
+	void LumosPhysicsEngine::DisconnectRegistry()
+	{
+		if (m_Registry)
 		{
-			delete m;
+			m_Registry->on_construct<Physics3DComponent>().disconnect<&LumosPhysicsEngine::OnBodyConstruct>(*this);
+			m_Registry->on_replace<Physics3DComponent>().disconnect<&LumosPhysicsEngine::OnBodyReplace>(*this);
+			m_Registry->on_destroy<Physics3DComponent>().disconnect<&LumosPhysicsEngine::OnBodyDestroy>(*this);
+			m_Registry = nullptr;
 		}
+
+		// Nothing from the last step may point at the bodies once they are released
+		for (Manifold* m : m_Manifolds)
+			delete m;
 		m_Manifolds.clear();
+		m_BroadphaseCollisionPairs.clear();
+		m_Islands.clear();
+		m_Bullets.clear();
+
+		m_BodyStates.DetachAll();
+		m_PhysicsObjects.clear();
+		m_OrderedObjects.clear();
+		m_BodyEntities.clear();
+		m_BodyLookup.clear();
+		m_BodyListChanged = false;
+	}
 
-		//Check for collisions
-		BroadPhaseCollisions();
-		NarrowPhaseCollisions();
-		
-		//Solve collision constraints
-		SolveConstraints();
-		
-		//Update movement
-		UpdatePhysicsObjects();
+	void LumosPhysicsEngine::OnBodyConstruct(entt::entity entity, entt::registry& registry, Physics3DComponent& component)
+	{
+		AddBody(entity, component.GetPhysicsObject());
 	}
 
-	void LumosPhysicsEngine::UpdatePhysicsObjects()
+	void LumosPhysicsEngine::OnBodyReplace(entt::entity entity, entt::registry& registry, Physics3DComponent& component)
 	{
-        System::JobSystem::Dispatch(static_cast<u32>(m_PhysicsObjects.size()), 4, [&](JobDispatchArgs args)
-        {
-            UpdatePhysicsObject(m_PhysicsObjects[args.jobIndex]);
-        });
-        
-        System::JobSystem::Wait();
+		RemoveBody(entity);
+		AddBody(entity, component.GetPhysicsObject());
 	}
 
-	void LumosPhysicsEngine::UpdatePhysicsObject(const Ref<PhysicsObject3D>& obj) const
+	void LumosPhysicsEngine::OnBodyDestroy(entt::entity entity, entt::registry& registry)
 	{
-		if (!obj->GetIsStatic() && obj->IsAwake())
-		{
-			const float damping = m_DampingFactor;
+		RemoveBody(entity);
+	}
 
-			// Apply gravity
-			if (obj->m_InvMass > 0.0f)
-				obj->m_LinearVelocity += m_Gravity * s_UpdateTimestep;
+	void LumosPhysicsEngine::AddBody(entt::entity entity, const Ref<PhysicsObject3D>& object)
+	{
+		if (!object)
+			return;
 
-			switch (m_IntegrationType)
-			{
-			case IntegrationType::EXPLICIT_EULER:
-			{
-				// Update position
-				obj->m_Position += obj->m_LinearVelocity * s_UpdateTimestep;
+		m_BodyStates.Attach(object.get());
 
-				// Update linear velocity (v = u + at)
-				obj->m_LinearVelocity += obj->m_Force * obj->m_InvMass * s_UpdateTimestep;
+		m_BodyLookup[entity] = static_cast<u32>(m_OrderedObjects.size());
+		m_OrderedObjects.push_back(object);
+		m_BodyEntities.push_back(entity);
+		m_BodyListChanged = true;
+	}
 
-				// Linear velocity damping
-				obj->m_LinearVelocity = obj->m_LinearVelocity * damping;
+	void LumosPhysicsEngine::RemoveBody(entt::entity entity)
+	{
+		auto it = m_BodyLookup.find(entity);
+		if (it == m_BodyLookup.end())
+			return;
 
-				// Update orientation
-				obj->m_Orientation = obj->m_Orientation + ((obj->m_AngularVelocity * s_UpdateTimestep * 0.5f) * obj->m_Orientation);
-				obj->m_Orientation.Normalize();
+		// Swap with the last body, SyncBodyList restores entity order in deterministic mode
+		const u32 index = it->second;
+		m_BodyStates.Detach(m_OrderedObjects[index].get());
 
-				// Update angular velocity
-				obj->m_AngularVelocity += obj->m_InvInertia * obj->m_Torque * s_UpdateTimestep;
+		const u32 last = static_cast<u32>(m_OrderedObjects.size()) - 1;
+		if (index != last)
+		{
+			m_OrderedObjects[index] = std::move(m_OrderedObjects[last]);
+			m_BodyEntities[index] = m_BodyEntities[last];
+			m_BodyLookup[m_BodyEntities[index]] = index;
+		}
 
-				// Angular velocity damping
-				obj->m_AngularVelocity = obj->m_AngularVelocity * damping;
+		m_OrderedObjects.pop_back();
+		m_BodyEntities.pop_back();
+		m_BodyLookup.erase(it);
+		m_BodyListChanged = true;
+	}
 
-				break;
-			}
+	void LumosPhysicsEngine::SyncBodyList()
+	{
+		if (!m_BodyListChanged)
+			return;
 
-			default:
-			case IntegrationType::SEMI_IMPLICIT_EULER:
-			{
-				// Update linear velocity (v = u + at)
-				obj->m_LinearVelocity += obj->m_LinearVelocity * obj->m_InvMass * s_UpdateTimestep;
+		m_BodyListChanged = false;
 
-				// Linear velocity damping
-				obj->m_LinearVelocity = obj->m_LinearVelocity * damping;
+		if (m_Deterministic)
+		{
+			// Signal order depends on the order components were added and removed, entity order is the same on every peer
+			std::vector<u32> order(m_OrderedObjects.size());
+			std::iota(order.begin(), order.end(), 0u);
+			std::sort(order.begin(), order.end(), [&](u32 a, u32 b) { return m_BodyEntities[a] < m_BodyEntities[b]; });
 
-				// Update position
-				obj->m_Position += obj->m_LinearVelocity * s_UpdateTimestep;
+			std::vector<Ref<PhysicsObject3D>> objects;
+			std::vector<entt::entity> entities;
+			objects.reserve(order.size());
+			entities.reserve(order.size());
 
-				// Update angular velocity
-				obj->m_AngularVelocity += obj->m_InvInertia * obj->m_Torque * s_UpdateTimestep;
+			for (u32 index : order)
+			{
+				m_BodyLookup[m_BodyEntities[index]] = static_cast<u32>(objects.size());
+				objects.push_back(std::move(m_OrderedObjects[index]));
+				entities.push_back(m_BodyEntities[index]);
+			}
 
-				// Angular velocity damping
-				obj->m_AngularVelocity = obj->m_AngularVelocity * damping;
+			m_OrderedObjects.swap(objects);
+			m_BodyEntities.swap(entities);
+		}
 
-				// Update orientation
-				obj->m_Orientation = obj->m_Orientation + ((obj->m_AngularVelocity * s_UpdateTimestep * 0.5f) * obj->m_Orientation);
-				obj->m_Orientation.Normalize();
+		// Only refreshed when bodies come and go, so the broadphase keeps its order between frames otherwise
+		m_PhysicsObjects = m_OrderedObjects;
+	}
 
-				break;
-			}
+	void LumosPhysicsEngine::WriteBackTransforms(entt::registry& registry)
+	{
+		auto transforms = registry.view<Maths::Transform>();
 
-			case IntegrationType::RUNGE_KUTTA_2:
-			{
-				// RK2 integration for linear motion
-				Integration::State state = { obj->m_Position, obj->m_LinearVelocity, obj->m_Force * obj->m_InvMass };
-                Integration::RK2(state,0.0f, s_UpdateTimestep);
+		// Dirty sets aren't thread safe, jobs only flag their body and the changes are reported after the wait
+		const bool reportChanges = HasChangeListeners<Maths::Transform>(registry);
+		if (reportChanges)
+			m_Moved.assign(m_OrderedObjects.size(), 0);
 
-				obj->m_Position = state.position;
-				obj->m_LinearVelocity = state.velocity;
+		// Sleeping bodies never move, so only bodies integrated or moved by hand since the last write back are copied
+		System::JobSystem::Dispatch(static_cast<u32>(m_OrderedObjects.size()), 256, [&](JobDispatchArgs args)
+		{
+			PhysicsObject3D* obj = m_OrderedObjects[args.jobIndex].get();
+			const entt::entity entity = m_BodyEntities[args.jobIndex];
 
-				// Linear velocity damping
-				obj->m_LinearVelocity = obj->m_LinearVelocity * damping;
+			if (!obj->m_PoseChanged || !transforms.contains(entity))
+				return;
 
-				// Update angular velocity
-				obj->m_AngularVelocity += obj->m_InvInertia * obj->m_Torque * s_UpdateTimestep;
+			auto& transform = transforms.get(entity);
+			transform.SetLocalPosition(obj->GetPosition());
+			transform.SetLocalOrientation(obj->GetOrientation());
+			obj->m_PoseChanged = false;
 
-				// Angular velocity damping
-				obj->m_AngularVelocity = obj->m_AngularVelocity * damping;
+			if (reportChanges)
+				m_Moved[args.jobIndex] = 1;
+		});
 
-				// Update orientation
-				obj->m_Orientation = obj->m_Orientation + ((obj->m_AngularVelocity * s_UpdateTimestep * 0.5f) * obj->m_Orientation);
-				obj->m_Orientation.Normalize();
+		System::JobSystem::Wait();
 
-				break;
+		if (reportChanges)
+		{
+			for (size_t i = 0; i < m_Moved.size(); i++)
+			{
+				if (m_Moved[i])
+					MarkChanged<Maths::Transform>(registry, m_BodyEntities[i]);
 			}
+		}
+	}
 
-			case IntegrationType::RUNGE_KUTTA_4:
-			{
-				// RK4 integration for linear motion
-				Integration::State state = { obj->m_Position, obj->m_LinearVelocity, obj->m_Force * obj->m_InvMass };
-				Integration::RK4(state, 0.0f, s_UpdateTimestep);
-				obj->m_Position = state.position;
-				obj->m_LinearVelocity = state.velocity;
+	void LumosPhysicsEngine::UpdatePhysics(Scene* scene)
+	{
+		// Start every step from the same body order, the broadphase may have sorted m_PhysicsObjects last step
+		if (m_Deterministic)
+			m_PhysicsObjects = m_OrderedObjects;
 
-				// Linear velocity damping
-				obj->m_LinearVelocity = obj->m_LinearVelocity * damping;
+		++m_StepCount;
 
-				// Update angular velocity
-				obj->m_AngularVelocity += obj->m_InvInertia * obj->m_Torque * s_UpdateTimestep;
+		// The iteration count changes the result, so deterministic steps never take it from the budget
+		m_SolverIterations = m_Deterministic ? m_Budget.GetMaxIterations() : m_Budget.GetSolverIterations();
+		const TimeStamp stepStart = Timer::Now();
 
-				// Angular velocity damping
-				obj->m_AngularVelocity = obj->m_AngularVelocity * damping;
+		for (Manifold* m : m_Manifolds)
+		{
+			delete m;
+		}
+		m_Manifolds.clear();
 
-				// Update orientation
-				obj->m_Orientation = obj->m_Orientation + ((obj->m_AngularVelocity * s_UpdateTimestep * 0.5f) * obj->m_Orientation);
-				obj->m_Orientation.Normalize();
+		//Check for collisions
+		const TimeStamp broadphaseStart = Timer::Now();
+		BroadPhaseCollisions();
+		const TimeStamp narrowphaseStart = Timer::Now();
+		NarrowPhaseCollisions();
+		const TimeStamp islandStart = Timer::Now();
 
-				break;
-			}
-			}
+		//Group connected bodies so they can be solved and put to sleep independently
+		BuildIslands();
+		
+		//Solve collision constraints
+		const TimeStamp solveStart = Timer::Now();
+		SolveConstraints();
+		const TimeStamp sweepStart = Timer::Now();
 
-			// Mark cached world transform and AABB as invalid
-			obj->m_wsTransformInvalidated = true;
-			obj->m_wsAabbInvalidated = true;
+		//Find when bullets first hit something along their post solve velocity
+		ComputeTimeOfImpacts();
+		
+		//Update movement
+		const TimeStamp integrateStart = Timer::Now();
+		UpdatePhysicsObjects();
 
-			obj->RestTest();
-		}
+		const TimeStamp clampStart = Timer::Now();
+		ClampBulletMotion();
+
+		const TimeStamp sleepStart = Timer::Now();
+		UpdateIslandSleeping();
+
+		const TimeStamp stepEnd = Timer::Now();
+		m_StepTimings.broadphase = Timer::Duration(broadphaseStart, narrowphaseStart, 1000.0f);
+		m_StepTimings.narrowphase = Timer::Duration(narrowphaseStart, islandStart, 1000.0f);
+		m_StepTimings.islands = Timer::Duration(islandStart, solveStart, 1000.0f);
+		m_StepTimings.solve = Timer::Duration(solveStart, sweepStart, 1000.0f);
+		m_StepTimings.ccd = Timer::Duration(sweepStart, integrateStart, 1000.0f) + Timer::Duration(clampStart, sleepStart, 1000.0f);
+		m_StepTimings.integrate = Timer::Duration(integrateStart, clampStart, 1000.0f);
+		m_StepTimings.sleep = Timer::Duration(sleepStart, stepEnd, 1000.0f);
+		m_StepTimings.total = Timer::Duration(stepStart, stepEnd, 1000.0f);
+
+		m_Budget.RecordStep(m_StepTimings.total, m_StepTimings.solve, m_SolverIterations);
+	}
+
+	void LumosPhysicsEngine::UpdatePhysicsObjects()
+	{
+		const IntegrationType type = m_IntegrationType;
+		const Maths::Vector3 gravity = m_Gravity;
+		const float damping = m_DampingFactor;
+		const float dt = m_UpdateTimestep;
+
+		// Integrated in place in the body store. Each job integrates 16 blocks of BodyStateStore::LaneWidth bodies,
+		// blocks share no data so the result does not depend on how the jobs are scheduled
+        System::JobSystem::Dispatch(m_BodyStates.GetBlockCount(), 16, [&](JobDispatchArgs args)
+        {
+			m_BodyStates.IntegrateBlock(args.jobIndex, type, gravity, damping, dt);
+        });
+        
+        System::JobSystem::Wait();
 	}
 
 	void LumosPhysicsEngine::BroadPhaseCollisions()
 	{
 		m_BroadphaseCollisionPairs.clear();
+
+		// Bullet bounds are swept over the step, the octree widens its queries by how far bodies move in it
+		for (const auto& obj : m_PhysicsObjects)
+			obj->m_SweepTime = m_UpdateTimestep;
+
 		if (m_BroadphaseDetection)
+		{
+			m_BroadphaseDetection->SetTimestep(m_UpdateTimestep);
 			m_BroadphaseDetection->FindPotentialCollisionPairs(m_PhysicsObjects, m_BroadphaseCollisionPairs);
+		}
 	}
 
 	void LumosPhysicsEngine::NarrowPhaseCollisions()
@@ -287,8 +422,8 @@ namespace Lumos
 
 				if (shapeA && shapeB)
 				{
-					// Detects if the objects are colliding - Seperating Axis Theorem
-					if (CollisionDetection::Instance()->CheckCollision(cp.pObjectA, cp.pObjectB, shapeA.get(), shapeB.get(), &colData))
+					// Detects if the objects are colliding - Seperating Axis Theorem or GJK/EPA
+					if (CollisionDetection::Instance()->CheckCollision(m_NarrowphaseType, cp.pObjectA, cp.pObjectB, shapeA.get(), shapeB.get(), &colData))
 					{
 						// Check to see if any of the objects have collision callbacks that dont
 						// want the objects to physically collide
@@ -325,25 +460,421 @@ namespace Lumos
 		}
 	}
 
+	u32 LumosPhysicsEngine::FindIslandRoot(u32 index)
+	{
+		while (m_IslandParents[index] != index)
+		{
+			// Path halving
+			m_IslandParents[index] = m_IslandParents[m_IslandParents[index]];
+			index = m_IslandParents[index];
+		}
+
+		return index;
+	}
+
+	void LumosPhysicsEngine::UnionIslands(PhysicsObject3D* a, PhysicsObject3D* b)
+	{
+		// Static and infinite mass bodies don't propagate impulses, so they never join islands together
+		if (!IsIslandBody(a) || !IsIslandBody(b))
+			return;
+
+		const u32 rootA = FindIslandRoot(a->m_IslandIndex);
+		const u32 rootB = FindIslandRoot(b->m_IslandIndex);
+
+		// Always keep the lowest index as root so island order only depends on body order
+		if (rootA < rootB)
+			m_IslandParents[rootB] = rootA;
+		else if (rootB < rootA)
+			m_IslandParents[rootA] = rootB;
+	}
+
+	bool LumosPhysicsEngine::IsIslandBody(const PhysicsObject3D* obj) const
+	{
+		return obj
+			&& obj->GetIsSolverDynamic()
+			&& obj->m_IslandIndex < m_PhysicsObjects.size()
+			&& m_PhysicsObjects[obj->m_IslandIndex].get() == obj;
+	}
+
+	void LumosPhysicsEngine::BuildIslands()
+	{
+		const u32 count = static_cast<u32>(m_PhysicsObjects.size());
+
+		m_IslandParents.resize(count);
+		for (u32 i = 0; i < count; ++i)
+		{
+			m_IslandParents[i] = i;
+			m_PhysicsObjects[i]->m_IslandIndex = i;
+		}
+
+		for (Manifold* m : m_Manifolds)
+			UnionIslands(m->NodeA(), m->NodeB());
+
+		for (Constraint* c : m_Constraints)
+			UnionIslands(c->GetObjectA(), c->GetObjectB());
+
+		// Island storage is reused between steps to avoid reallocating the per island lists
+		u32 islandCount = 0;
+		m_IslandLookup.assign(count + 1, ~0u);
+
+		auto getIsland = [&](u32 key) -> PhysicsIsland&
+		{
+			u32& lookup = m_IslandLookup[key];
+			if (lookup == ~0u)
+			{
+				lookup = islandCount++;
+				if (lookup >= m_Islands.size())
+					m_Islands.emplace_back();
+
+				PhysicsIsland& island = m_Islands[lookup];
+				island.bodies.clear();
+				island.manifolds.clear();
+				island.constraints.clear();
+			}
+
+			return m_Islands[lookup];
+		};
+
+		// Pairs without any dynamic body are gathered in one extra island keyed past the last body
+		auto getIslandKey = [&](PhysicsObject3D* a, PhysicsObject3D* b) -> u32
+		{
+			if (IsIslandBody(a))
+				return FindIslandRoot(a->m_IslandIndex);
+			if (IsIslandBody(b))
+				return FindIslandRoot(b->m_IslandIndex);
+			return count;
+		};
+
+		for (u32 i = 0; i < count; ++i)
+		{
+			PhysicsObject3D* obj = m_PhysicsObjects[i].get();
+			if (IsIslandBody(obj))
+				getIsland(FindIslandRoot(i)).bodies.push_back(obj);
+		}
+
+		for (Manifold* m : m_Manifolds)
+			getIsland(getIslandKey(m->NodeA(), m->NodeB())).manifolds.push_back(m);
+
+		for (Constraint* c : m_Constraints)
+			getIsland(getIslandKey(c->GetObjectA(), c->GetObjectB())).constraints.push_back(c);
+
+		m_Islands.resize(islandCount);
+	}
+
 	void LumosPhysicsEngine::SolveConstraints()
 	{
-		for (Manifold* m : m_Manifolds) m->PreSolverStep(s_UpdateTimestep);
-		for (Constraint* c : m_Constraints)	c->PreSolverStep(s_UpdateTimestep);
+		// Deterministic mode solves the islands in order on this thread so nothing depends on job scheduling
+		if (m_Islands.size() == 1 || m_Deterministic)
+		{
+			for (PhysicsIsland& island : m_Islands)
+				SolveIsland(island);
+			return;
+		}
+
+		// Islands share no dynamic bodies and only read the static ones they touch, so each one can be solved on its own job
+		System::JobSystem::Dispatch(static_cast<u32>(m_Islands.size()), 1, [&](JobDispatchArgs args)
+		{
+			SolveIsland(m_Islands[args.jobIndex]);
+		});
+
+		System::JobSystem::Wait();
+	}
+
+	void LumosPhysicsEngine::SolveIsland(PhysicsIsland& island) const
+	{
+		if (island.manifolds.empty() && island.constraints.empty())
+			return;
 
-		for (size_t i = 0; i < SOLVER_ITERATIONS; ++i)
+		for (Manifold* m : island.manifolds) m->PreSolverStep(m_UpdateTimestep);
+		for (Constraint* c : island.constraints) c->PreSolverStep(m_UpdateTimestep);
+
+		for (u32 i = 0; i < m_SolverIterations; ++i)
 		{
-			for (Manifold* m : m_Manifolds)
+			for (Manifold* m : island.manifolds)
 			{
 				m->ApplyImpulse();
 			}
 
-			for (Constraint* c : m_Constraints)
+			for (Constraint* c : island.constraints)
 			{
 				c->ApplyImpulse();
 			}
 		}
 	}
 
+	void LumosPhysicsEngine::UpdateIslandSleeping()
+	{
+		for (PhysicsIsland& island : m_Islands)
+		{
+			if (island.bodies.empty())
+				continue;
+
+			const bool islandAtRest = std::all_of(island.bodies.begin(), island.bodies.end(), [](const PhysicsObject3D* obj)
+			{
+				return obj->GetIsAtRest();
+			});
+
+			// Only sleep once every body in the island has settled, otherwise keep the whole island awake
+			if (!islandAtRest)
+			{
+				for (PhysicsObject3D* obj : island.bodies)
+				{
+					if (obj->GetIsAtRest())
+						obj->WakeUp();
+				}
+			}
+		}
+	}
+
+	void LumosPhysicsEngine::ComputeTimeOfImpacts()
+	{
+		// Keeps the bullet within this distance of the surface it hits
+		const float slop = 0.01f;
+
+		const u32 count = static_cast<u32>(m_PhysicsObjects.size());
+
+		m_Bullets.clear();
+		m_BulletLookup.assign(count, ~0u);
+
+		// m_IslandIndex holds the body index for this step (set in BuildIslands)
+		for (u32 i = 0; i < count; ++i)
+		{
+			PhysicsObject3D* obj = m_PhysicsObjects[i].get();
+			if (obj->GetIsBullet() && IsIslandBody(obj) && obj->IsAwake() && obj->GetCollisionShape())
+			{
+				m_BulletLookup[i] = static_cast<u32>(m_Bullets.size());
+				m_Bullets.push_back({ obj, obj->GetPosition(), 1.0f });
+			}
+		}
+
+		if (m_Bullets.empty())
+			return;
+
+		auto sweep = [&](PhysicsObject3D* bullet, PhysicsObject3D* other)
+		{
+			if (!IsIslandBody(bullet) || m_BulletLookup[bullet->m_IslandIndex] == ~0u || !other->GetCollisionShape())
+				return;
+
+			BulletMotion& motion = m_Bullets[m_BulletLookup[bullet->m_IslandIndex]];
+
+			// Swept as the largest sphere inside its local bounds, relative to the other body's motion
+			const Maths::Vector3 halfSize = bullet->GetLocalBoundingBox().HalfSize();
+			const float radius = Maths::Min(halfSize.x, Maths::Min(halfSize.y, halfSize.z));
+			const Maths::Vector3 relativeMotion = (bullet->GetLinearVelocity() - other->GetLinearVelocity()) * m_UpdateTimestep;
+
+			float toi;
+			if (CollisionDetection::SweptSphereTimeOfImpact(bullet->GetPosition(), radius, relativeMotion, other, other->GetCollisionShape().get(), slop, &toi))
+				motion.timeOfImpact = Maths::Min(motion.timeOfImpact, toi);
+		};
+
+		// The broadphase used the swept bounds, so every body a bullet can reach this step is already paired with it
+		for (const CollisionPair& cp : m_BroadphaseCollisionPairs)
+		{
+			sweep(cp.pObjectA, cp.pObjectB);
+			sweep(cp.pObjectB, cp.pObjectA);
+		}
+	}
+
+	void LumosPhysicsEngine::ClampBulletMotion()
+	{
+		for (const BulletMotion& motion : m_Bullets)
+		{
+			if (motion.timeOfImpact >= 1.0f)
+				continue;
+
+			// Velocity is kept so the contact generated next step can respond to it
+			const Maths::Vector3 displacement = motion.body->GetPosition() - motion.start;
+			motion.body->SetPosition(motion.start + displacement * motion.timeOfImpact);
+		}
+	}
+
+	void LumosPhysicsEngine::PrepareSceneQueries()
+	{
+		for (const auto& obj : m_PhysicsObjects)
+		{
+			obj->GetWorldSpaceAABB();
+			obj->GetWorldSpaceCollisionAxes();
+		}
+	}
+
+	bool LumosPhysicsEngine::RaycastCandidates(const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& candidates, RaycastHit* out_hit) const
+	{
+		candidates.clear();
+		m_BroadphaseDetection->FindObjectsOnRay(m_PhysicsObjects, ray, maxDistance, candidates);
+
+		RaycastHit closest;
+		closest.distance = maxDistance;
+
+		for (PhysicsObject3D* obj : candidates)
+		{
+			float distance;
+			Maths::Vector3 normal;
+			if (CollisionDetection::CheckRayCollision(ray, closest.distance, obj, obj->GetCollisionShape().get(), &distance, &normal) && (!closest.body || distance < closest.distance))
+			{
+				closest.body = obj;
+				closest.distance = distance;
+				closest.normal = normal;
+			}
+		}
+
+		if (!closest.body)
+			return false;
+
+		if (out_hit)
+		{
+			closest.point = ray.origin_ + ray.direction_ * closest.distance;
+			*out_hit = closest;
+		}
+
+		return true;
+	}
+
+	bool LumosPhysicsEngine::Raycast(const Maths::Ray& ray, float maxDistance, RaycastHit* out_hit)
+	{
+		if (!m_BroadphaseDetection)
+			return false;
+
+		std::vector<PhysicsObject3D*> candidates;
+		return RaycastCandidates(ray, maxDistance, candidates, out_hit);
+	}
+
+	void LumosPhysicsEngine::RaycastBatch(const std::vector<Maths::Ray>& rays, float maxDistance, std::vector<RaycastHit>& out_hits)
+	{
+		out_hits.assign(rays.size(), RaycastHit());
+
+		if (!m_BroadphaseDetection || rays.empty())
+			return;
+
+		PrepareSceneQueries();
+
+		// One candidate list per job group, reused for every ray in the group
+		const u32 groupSize = 32;
+		const u32 rayCount = static_cast<u32>(rays.size());
+		std::vector<std::vector<PhysicsObject3D*>> candidates((rayCount + groupSize - 1) / groupSize);
+
+		System::JobSystem::Dispatch(rayCount, groupSize, [&](JobDispatchArgs args)
+		{
+			RaycastCandidates(rays[args.jobIndex], maxDistance, candidates[args.groupIndex], &out_hits[args.jobIndex]);
+		});
+
+		System::JobSystem::Wait();
+	}
+
+	void LumosPhysicsEngine::OverlapShape(const Maths::BoundingBox& bounds, const PhysicsObject3D* probe, const CollisionShape* probeShape, std::vector<PhysicsObject3D*>& out_objects)
+	{
+		if (!m_BroadphaseDetection)
+			return;
+
+		const size_t first = out_objects.size();
+		m_BroadphaseDetection->FindObjectsInAABB(m_PhysicsObjects, bounds, out_objects);
+
+		// Keep the candidates whose shape really overlaps the probe
+		auto end = std::remove_if(out_objects.begin() + first, out_objects.end(), [&](const PhysicsObject3D* obj)
+		{
+			return !CollisionDetection::Instance()->CheckConvexCollision(probe, obj, probeShape, obj->GetCollisionShape().get());
+		});
+		out_objects.erase(end, out_objects.end());
+	}
+
+	void LumosPhysicsEngine::OverlapSphere(const Maths::Vector3& centre, float radius, std::vector<PhysicsObject3D*>& out_objects)
+	{
+		SphereCollisionShape sphere(radius);
+		PhysicsObject3D probe;
+		probe.SetPosition(centre);
+
+		OverlapShape(Maths::BoundingBox(centre - Maths::Vector3(radius), centre + Maths::Vector3(radius)), &probe, &sphere, out_objects);
+	}
+
+	void LumosPhysicsEngine::OverlapAABB(const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects)
+	{
+		CuboidCollisionShape cuboid(box.HalfSize());
+		PhysicsObject3D probe;
+		probe.SetPosition(box.Center());
+
+		OverlapShape(box, &probe, &cuboid, out_objects);
+	}
+
+	void LumosPhysicsEngine::Simulate(u32 stepCount)
+	{
+		LUMOS_PROFILE_BLOCK("LumosPhysicsEngine::Simulate");
+
+		SyncBodyList();
+
+		for (u32 i = 0; i < stepCount; ++i)
+			UpdatePhysics(nullptr);
+	}
+
+	void LumosPhysicsEngine::SaveState(std::vector<u8>& out_state)
+	{
+		SyncBodyList();
+
+		const u32 bodyCount = static_cast<u32>(m_OrderedObjects.size());
+
+		out_state.resize(sizeof(StateHeader) + bodyCount * sizeof(BodyState));
+
+		StateHeader header = { StateMagic, StateVersion, bodyCount, 0, m_StepCount };
+		memcpy(out_state.data(), &header, sizeof(StateHeader));
+
+		BodyState* states = reinterpret_cast<BodyState*>(out_state.data() + sizeof(StateHeader));
+		for (u32 i = 0; i < bodyCount; ++i)
+		{
+			const PhysicsObject3D* obj = m_OrderedObjects[i].get();
+			BodyState& state = states[i];
+
+			state.position = obj->GetPosition();
+			state.orientation = obj->GetOrientation();
+			state.linearVelocity = obj->GetLinearVelocity();
+			state.angularVelocity = obj->GetAngularVelocity();
+			state.force = obj->GetForce();
+			state.torque = obj->GetTorque();
+			state.averageSummedVelocity = obj->m_AverageSummedVelocity;
+			state.atRest = obj->GetIsAtRest() ? 1 : 0;
+		}
+	}
+
+	bool LumosPhysicsEngine::RestoreState(const std::vector<u8>& state)
+	{
+		SyncBodyList();
+
+		if (state.size() < sizeof(StateHeader))
+			return false;
+
+		StateHeader header;
+		memcpy(&header, state.data(), sizeof(StateHeader));
+
+		if (header.magic != StateMagic || header.version != StateVersion || header.bodyCount != m_OrderedObjects.size()
+			|| state.size() != sizeof(StateHeader) + header.bodyCount * sizeof(BodyState))
+		{
+			Debug::Log::Warning("Physics state does not match the current bodies");
+			return false;
+		}
+
+		const BodyState* states = reinterpret_cast<const BodyState*>(state.data() + sizeof(StateHeader));
+		for (u32 i = 0; i < header.bodyCount; ++i)
+		{
+			PhysicsObject3D* obj = m_OrderedObjects[i].get();
+			const BodyState& bodyState = states[i];
+			const u32 slot = obj->m_State.index;
+
+			// Written to the store directly, the body setters skip velocities of static bodies
+			m_BodyStates.SetVector3(BodyStateStore::PositionX, slot, bodyState.position);
+			m_BodyStates.SetOrientation(slot, bodyState.orientation);
+			m_BodyStates.SetVector3(BodyStateStore::VelocityX, slot, bodyState.linearVelocity);
+			m_BodyStates.SetVector3(BodyStateStore::AngularVelocityX, slot, bodyState.angularVelocity);
+			m_BodyStates.SetVector3(BodyStateStore::ForceX, slot, bodyState.force);
+			m_BodyStates.SetVector3(BodyStateStore::TorqueX, slot, bodyState.torque);
+			obj->m_AverageSummedVelocity = bodyState.averageSummedVelocity;
+			obj->SetIsAtRest(bodyState.atRest != 0);
+
+			obj->m_wsTransformInvalidated = true;
+			obj->m_wsAabbInvalidated = true;
+			obj->m_PoseChanged = true;
+		}
+
+		m_StepCount = header.stepCount;
+		return true;
+	}
+
     void LumosPhysicsEngine::ClearConstraints()
     {
         for (Constraint* c : m_Constraints)
@@ -363,6 +894,16 @@ namespace Lumos
 		}
 	}
 
+	String NarrowphaseTypeToString(NarrowphaseType type)
+	{
+		switch (type)
+		{
+		case  NarrowphaseType::SAT : return "SAT";
+		case  NarrowphaseType::GJK_EPA : return "GJK EPA";
+		default : return "";
+		}
+	}
+
 	void LumosPhysicsEngine::OnImGui()
 	{
 		ImGui::TextUnformatted("3D Physics Engine");
@@ -387,6 +928,22 @@ namespace Lumos
 		ImGui::PopItemWidth();
 		ImGui::NextColumn();
 
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Number Of Islands");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::Text("%5.2i", GetNumberIslands());
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Number Of Bullets");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::Text("%5.2i", GetNumberBullets());
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
 		ImGui::AlignTextToFramePadding();
 		ImGui::TextUnformatted("Number Of Constraints");
 		ImGui::NextColumn();
@@ -403,6 +960,18 @@ namespace Lumos
 		ImGui::PopItemWidth();
 		ImGui::NextColumn();
 
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Deterministic");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		bool deterministic = m_Deterministic;
+		if (ImGui::Checkbox("##Deterministic", &deterministic))
+			SetDeterministic(deterministic);
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
+		m_Budget.OnImGui();
+
 		ImGui::AlignTextToFramePadding();
 		ImGui::TextUnformatted("Gravity");
 		ImGui::NextColumn();
@@ -435,6 +1004,20 @@ namespace Lumos
 		ImGui::PopItemWidth();
 		ImGui::NextColumn();
 
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Narrowphase");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		if (ImGui::BeginMenu(NarrowphaseTypeToString(m_NarrowphaseType).c_str()))
+		{
+			if (ImGui::MenuItem("SAT", "", m_NarrowphaseType == NarrowphaseType::SAT, true)) { m_NarrowphaseType = NarrowphaseType::SAT; }
+			if (ImGui::MenuItem("GJK EPA", "", m_NarrowphaseType == NarrowphaseType::GJK_EPA, true)) { m_NarrowphaseType = NarrowphaseType::GJK_EPA; }
+			ImGui::EndMenu();
+		}
+
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
 		ImGui::Columns(1);
 		ImGui::Separator();
 		ImGui::PopStyleVar();
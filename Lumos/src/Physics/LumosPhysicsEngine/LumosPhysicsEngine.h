@@ -5,24 +5,54 @@
 #include "PhysicsObject3D.h"
 #include "Manifold.h"
 #include "Broadphase.h"
+#include "BodyStateStore.h"
+#include "CollisionDetection.h"
 #include "ECS/ISystem.h"
 #include "App/Scene.h"
+#include "Physics/PhysicsBudget.h"
 
 namespace Lumos
 {
+	class Constraint;
+	class TimeStep;
+	class Physics3DComponent;
 
-#define SOLVER_ITERATIONS 50
+	//Group of bodies connected through contacts or constraints that can be solved independently
+	struct LUMOS_EXPORT PhysicsIsland
+	{
+		std::vector<PhysicsObject3D*> bodies;
+		std::vector<Manifold*>		  manifolds;
+		std::vector<Constraint*>	  constraints;
+	};
 
-	enum class LUMOS_EXPORT IntegrationType
+	//Motion of a bullet body over the current step, clamped to its earliest time of impact
+	struct LUMOS_EXPORT BulletMotion
 	{
-		EXPLICIT_EULER = 0,
-		SEMI_IMPLICIT_EULER,
-		RUNGE_KUTTA_2,
-		RUNGE_KUTTA_4
+		PhysicsObject3D* body;
+		Maths::Vector3	 start;
+		float			 timeOfImpact;
 	};
 
-	class Constraint;
-	class TimeStep;
+	struct LUMOS_EXPORT RaycastHit
+	{
+		PhysicsObject3D* body = nullptr;	//Null if nothing was hit
+		Maths::Vector3	 point;
+		Maths::Vector3	 normal;
+		float			 distance = 0.0f;
+	};
+
+	//Wall time of each stage of a physics step, in milliseconds
+	struct LUMOS_EXPORT PhysicsStepTimings
+	{
+		float broadphase = 0.0f;
+		float narrowphase = 0.0f;
+		float islands = 0.0f;
+		float solve = 0.0f;
+		float ccd = 0.0f;			//Bullet sweeps before integration and clamping after it
+		float integrate = 0.0f;
+		float sleep = 0.0f;
+		float total = 0.0f;
+	};
 
 	class LUMOS_EXPORT LumosPhysicsEngine : public ISystem
 	{
@@ -38,6 +68,14 @@ namespace Lumos
 		void OnInit() override {};
 		//Update Physics Engine
 		void OnUpdate(TimeStep* timeStep, Scene* scene) override;
+		void DeclareAccess(SystemAccess& access) const override;
+		void OnSceneAttach(Scene* scene) override;
+		void OnSceneDetach(Scene* scene) override;
+
+		//Keeps the body list in sync with the registry's Physics3DComponents through its construct/destroy signals.
+		//Attaching to a scene connects to its registry, detaching disconnects
+		void ConnectRegistry(entt::registry& registry);
+		void DisconnectRegistry();
 
 		//Getters / Setters
 		bool IsPaused() const { return m_IsPaused; }
@@ -49,7 +87,7 @@ namespace Lumos
 		float GetDampingFactor() const { return m_DampingFactor; }
 		void  SetDampingFactor(float d) { m_DampingFactor = d; }
 
-        static float GetDeltaTime() { return s_UpdateTimestep; }
+        float GetDeltaTime() const { return m_UpdateTimestep; }
 
 		Ref<Broadphase> GetBroadphase() const { return m_BroadphaseDetection; }
 		_FORCE_INLINE_ void SetBroadphase(const Ref<Broadphase>& bp)
@@ -59,11 +97,48 @@ namespace Lumos
 
 		int GetNumberCollisionPairs() const { return static_cast<int>(m_BroadphaseCollisionPairs.size()); }
 		int GetNumberPhysicsObjects() const { return static_cast<int>(m_PhysicsObjects.size()); }
+		int GetNumberIslands() const { return static_cast<int>(m_Islands.size()); }
+		int GetNumberBullets() const { return static_cast<int>(m_Bullets.size()); }
+		int GetNumberConstraints() const { return static_cast<int>(m_Constraints.size()); }
 
 		IntegrationType GetIntegrationType() const { return m_IntegrationType; }
 		void SetIntegrationType(const IntegrationType& type){ m_IntegrationType = type; }
 
+		NarrowphaseType GetNarrowphaseType() const { return m_NarrowphaseType; }
+		void SetNarrowphaseType(NarrowphaseType type) { m_NarrowphaseType = type; }
+
+		//Deterministic mode always steps by the fixed timestep, keeps bodies in entity order and
+		//solves/integrates on the calling thread, so the same inputs give the same results on every run
+		bool IsDeterministic() const { return m_Deterministic; }
+		void SetDeterministic(bool deterministic) { m_Deterministic = deterministic; m_BodyListChanged = true; }
+
+		u64 GetStepCount() const { return m_StepCount; }
+		const BodyStateStore& GetBodyStates() const { return m_BodyStates; }
+		const PhysicsStepTimings& GetStepTimings() const { return m_StepTimings; }
+
+		//Substeps per frame and solver iterations per step are picked to fit its millisecond budget.
+		//Deterministic mode always uses the maximum iterations.
+		PhysicsBudget& GetBudget() { return m_Budget; }
+
+		//Runs fixed steps on the current bodies without touching entity transforms, used to re-simulate after RestoreState
+		void Simulate(u32 stepCount);
+
+		//Compact binary copy of the simulated state of every body, in body list order.
+		//RestoreState fails if the body count no longer matches.
+		void SaveState(std::vector<u8>& out_state);
+		bool RestoreState(const std::vector<u8>& state);
+
         void ClearConstraints();
+
+		//<----- SCENE QUERIES ----->
+		// Run against the broadphase structure from the last physics step. Call from the main thread.
+		// Returns the closest hit along the ray
+		bool Raycast(const Maths::Ray& ray, float maxDistance, RaycastHit* out_hit = nullptr);
+		// Casts all rays in parallel on the job system, out_hits[i].body is null if ray i missed
+		void RaycastBatch(const std::vector<Maths::Ray>& rays, float maxDistance, std::vector<RaycastHit>& out_hits);
+		// Bodies whose collision shape overlaps the sphere / box
+		void OverlapSphere(const Maths::Vector3& centre, float radius, std::vector<PhysicsObject3D*>& out_objects);
+		void OverlapAABB(const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects);
         
 		void OnImGui() override;
 	protected:
@@ -77,12 +152,43 @@ namespace Lumos
 		//Handles narrowphase collision detection
 		void NarrowPhaseCollisions();
 
-		//Updates all physics objects position, orientation, velocity etc (default method uses symplectic euler integration)
+		//Updates all physics objects position, orientation, velocity etc through the structure of arrays body store
 		void UpdatePhysicsObjects();
-		void UpdatePhysicsObject(const Ref<PhysicsObject3D>& obj) const;
 
-		//Solves all engine constraints (constraints and manifolds)
+		//Groups bodies connected by manifolds/constraints into islands (union-find)
+		void BuildIslands();
+		u32 FindIslandRoot(u32 index);
+		void UnionIslands(PhysicsObject3D* a, PhysicsObject3D* b);
+		bool IsIslandBody(const PhysicsObject3D* obj) const;
+
+		//Solves all engine constraints (constraints and manifolds), one job per island
 		void SolveConstraints();
+		void SolveIsland(PhysicsIsland& island) const;
+
+		//Puts whole islands to sleep once every body in them is at rest
+		void UpdateIslandSleeping();
+
+		//Continuous collision detection for bullets. Sweeps each bullet against its broadphase pairs before
+		//integration, then pulls it back to the earliest time of impact so the next step resolves the contact
+		void ComputeTimeOfImpacts();
+		void ClampBulletMotion();
+
+		//Body list maintenance from the registry signals
+		void OnBodyConstruct(entt::entity entity, entt::registry& registry, Physics3DComponent& component);
+		void OnBodyReplace(entt::entity entity, entt::registry& registry, Physics3DComponent& component);
+		void OnBodyDestroy(entt::entity entity, entt::registry& registry);
+		void AddBody(entt::entity entity, const Ref<PhysicsObject3D>& object);
+		void RemoveBody(entt::entity entity);
+		void SyncBodyList();
+
+		//Copies the pose of bodies that moved since the last write back into their entity transforms, in parallel,
+		//and reports the moved transforms to any Transform dirty sets
+		void WriteBackTransforms(entt::registry& registry);
+
+		//Rebuilds any stale cached transforms/AABBs/axes so parallel queries only read object state
+		void PrepareSceneQueries();
+		bool RaycastCandidates(const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& candidates, RaycastHit* out_hit) const;
+		void OverlapShape(const Maths::BoundingBox& bounds, const PhysicsObject3D* probe, const CollisionShape* probeShape, std::vector<PhysicsObject3D*>& out_objects);
 
 	protected:
 		bool		m_IsPaused;
@@ -90,17 +196,40 @@ namespace Lumos
 		Maths::Vector3 m_Gravity;
 		float		m_DampingFactor;
 
-		std::vector<Ref<PhysicsObject3D>> m_PhysicsObjects;
+		std::vector<Ref<PhysicsObject3D>> m_PhysicsObjects;		// Bodies stepped this frame, the broadphase may reorder them
+		std::vector<Ref<PhysicsObject3D>> m_OrderedObjects;		// Persistent body list, in entity order when deterministic
+		std::vector<entt::entity>		  m_BodyEntities;		// Entity of each body in m_OrderedObjects
+		std::unordered_map<entt::entity, u32> m_BodyLookup;		// Entity -> index into m_OrderedObjects
+		entt::registry*					  m_Registry = nullptr;
+		bool							  m_BodyListChanged = false;
+		std::vector<u8>					  m_Moved;				// Per body, set by the write back jobs
+		BodyStateStore					  m_BodyStates;
 		std::vector<CollisionPair>  m_BroadphaseCollisionPairs;
 
 		std::vector<Constraint*>	m_Constraints;			// Misc constraints between pairs of objects
 		std::vector<Manifold*>		m_Manifolds;			// Contact constraints between pairs of objects
 		std::mutex					m_ManifoldsMutex;
 
+		std::vector<PhysicsIsland>	m_Islands;
+		std::vector<u32>			m_IslandParents;		// Union-find parent per body in m_PhysicsObjects
+		std::vector<u32>			m_IslandLookup;			// Root body index -> index into m_Islands
+
+		std::vector<BulletMotion>	m_Bullets;
+		std::vector<u32>			m_BulletLookup;			// Body index -> index into m_Bullets
+
 		Ref<Broadphase> m_BroadphaseDetection;
 		IntegrationType m_IntegrationType;
+		NarrowphaseType m_NarrowphaseType;
+
+		PhysicsBudget m_Budget;
+		u32			  m_SolverIterations;		// Iterations used by the current step
 
 		bool m_MultipleUpdates = true;
-        static float s_UpdateTimestep;
+		bool m_Deterministic = false;
+		u64	 m_StepCount = 0;
+		PhysicsStepTimings m_StepTimings;	// Of the last step
+
+        // Length of a step, handed to the solver, the broadphase and bullet bodies each step
+        float m_UpdateTimestep = 1.0f / 60.0f;
 	};
 }
@@ -15,6 +15,7 @@ namespace Lumos
 	Manifold::Manifold()
 		: m_pNodeA(nullptr)
 		, m_pNodeB(nullptr)
+		, m_DeltaTime(1.0f / 60.0f)
 	{
 	}
 
@@ -43,6 +44,10 @@ namespace Lumos
 		if (m_pNodeA->GetInverseMass() + m_pNodeB->GetInverseMass() == 0.0f)
 			return;
 
+		// Bodies the solver doesn't move may be shared with islands solved on other jobs, so they are only read
+		const bool moveA = m_pNodeA->GetIsSolverDynamic();
+		const bool moveB = m_pNodeB->GetIsSolverDynamic();
+
 		Maths::Vector3 r1 = c.relPosA;
 		Maths::Vector3 r2 = c.relPosB;
 
@@ -74,7 +79,7 @@ namespace Lumos
 
 				float penetrationSlop = Maths::Min(c.collisionPenetration + baumgarteSlop, 0.0f);
 
-                b = -(baumgarteScalar / LumosPhysicsEngine::GetDeltaTime()) * penetrationSlop;
+                b = -(baumgarteScalar / m_DeltaTime) * penetrationSlop;
 			}
 
 			float b_real = Maths::Max(b, c.elatisity_term + b * 0.2f);
@@ -85,17 +90,23 @@ namespace Lumos
 			c.sumImpulseContact = Maths::Min(c.sumImpulseContact + jn, 0.0f);
 			jn = c.sumImpulseContact - oldSumImpulseContact;
 
-			m_pNodeA->SetLinearVelocity(m_pNodeA->GetLinearVelocity()
-				+ normal * (jn * m_pNodeA->GetInverseMass()));
-			m_pNodeB->SetLinearVelocity(m_pNodeB->GetLinearVelocity()
-				- normal * (jn * m_pNodeB->GetInverseMass()));
-
-			m_pNodeA->SetAngularVelocity(m_pNodeA->GetAngularVelocity()
-				+ m_pNodeA->GetInverseInertia()
-				* Maths::Vector3::Cross(r1, normal * jn));
-			m_pNodeB->SetAngularVelocity(m_pNodeB->GetAngularVelocity()
-				- m_pNodeB->GetInverseInertia()
-				* Maths::Vector3::Cross(r2, normal * jn));
+			if (moveA)
+			{
+				m_pNodeA->SetLinearVelocity(m_pNodeA->GetLinearVelocity()
+					+ normal * (jn * m_pNodeA->GetInverseMass()));
+				m_pNodeA->SetAngularVelocity(m_pNodeA->GetAngularVelocity()
+					+ m_pNodeA->GetInverseInertia()
+					* Maths::Vector3::Cross(r1, normal * jn));
+			}
+
+			if (moveB)
+			{
+				m_pNodeB->SetLinearVelocity(m_pNodeB->GetLinearVelocity()
+					- normal * (jn * m_pNodeB->GetInverseMass()));
+				m_pNodeB->SetAngularVelocity(m_pNodeB->GetAngularVelocity()
+					- m_pNodeB->GetInverseInertia()
+					* Maths::Vector3::Cross(r2, normal * jn));
+			}
 		}
 		// Friction
 	{
@@ -131,23 +142,31 @@ namespace Lumos
 
 			jt = c.sumImpulseFriction - oldImpulseTangent;
 
-			m_pNodeA->SetLinearVelocity(m_pNodeA->GetLinearVelocity()
-				+ tangent *(jt * m_pNodeA->GetInverseMass()));
-			m_pNodeB->SetLinearVelocity(m_pNodeB->GetLinearVelocity()
-				- tangent *(jt * m_pNodeB->GetInverseMass()));
-
-			m_pNodeA->SetAngularVelocity(m_pNodeA->GetAngularVelocity()
-				+ m_pNodeA->GetInverseInertia()
-				* Maths::Vector3::Cross(r1, tangent * jt));
-			m_pNodeB->SetAngularVelocity(m_pNodeB->GetAngularVelocity()
-				- m_pNodeB->GetInverseInertia()
-				* Maths::Vector3::Cross(r2, tangent * jt));
+			if (moveA)
+			{
+				m_pNodeA->SetLinearVelocity(m_pNodeA->GetLinearVelocity()
+					+ tangent *(jt * m_pNodeA->GetInverseMass()));
+				m_pNodeA->SetAngularVelocity(m_pNodeA->GetAngularVelocity()
+					+ m_pNodeA->GetInverseInertia()
+					* Maths::Vector3::Cross(r1, tangent * jt));
+			}
+
+			if (moveB)
+			{
+				m_pNodeB->SetLinearVelocity(m_pNodeB->GetLinearVelocity()
+					- tangent *(jt * m_pNodeB->GetInverseMass()));
+				m_pNodeB->SetAngularVelocity(m_pNodeB->GetAngularVelocity()
+					- m_pNodeB->GetInverseInertia()
+					* Maths::Vector3::Cross(r2, tangent * jt));
+			}
 		}
 	}
 	}
 
 	void Manifold::PreSolverStep(float dt)
 	{
+		m_DeltaTime = dt;
+
 		for (ContactPoint& contact : m_vContacts)
 		{
 			UpdateConstraint(contact);
@@ -52,5 +52,6 @@ namespace Lumos
 		PhysicsObject3D*			m_pNodeA;
 		PhysicsObject3D*			m_pNodeB;
 		std::vector<ContactPoint>	m_vContacts;
+		float						m_DeltaTime;	//Length of the step being solved, from PreSolverStep
 	};
 }
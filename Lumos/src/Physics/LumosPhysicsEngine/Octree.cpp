@@ -2,6 +2,7 @@
 
 #include "Maths/Maths.h"
 #include "Octree.h"
+#include "LumosPhysicsEngine.h"
 
 namespace Lumos
 {
@@ -31,12 +32,16 @@ namespace Lumos
 		m_RootNode->physicsObjects.reserve(m_MaxObjectsPerPartition);
 		m_RootNode->childNodes.reserve(8);
 
+		m_QueryMargin = 0.0f;
+
 		for (const auto& physicsObject : objects)
         {
             if (physicsObject && physicsObject->GetCollisionShape())
 			{
 				m_RootNode->boundingBox.Merge(physicsObject->GetWorldSpaceAABB());
 				m_RootNode->physicsObjects.emplace_back(physicsObject);
+
+				m_QueryMargin = Maths::Max(m_QueryMargin, physicsObject->GetLinearVelocity().Length() * m_Timestep);
 			}
 		}
 
@@ -110,6 +115,74 @@ namespace Lumos
 		}
 	}
 
+	void Octree::FindObjectsInAABB(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects) const
+	{
+		if (!m_RootNode)
+		{
+			Broadphase::FindObjectsInAABB(objects, box, out_objects);
+			return;
+		}
+
+		// Objects can sit in several leaves
+		const size_t first = out_objects.size();
+		QueryNode(m_RootNode.get(), box, out_objects);
+		std::sort(out_objects.begin() + first, out_objects.end());
+		out_objects.erase(std::unique(out_objects.begin() + first, out_objects.end()), out_objects.end());
+	}
+
+	void Octree::FindObjectsOnRay(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects) const
+	{
+		if (!m_RootNode)
+		{
+			Broadphase::FindObjectsOnRay(objects, ray, maxDistance, out_objects);
+			return;
+		}
+
+		const size_t first = out_objects.size();
+		QueryNode(m_RootNode.get(), ray, maxDistance, out_objects);
+		std::sort(out_objects.begin() + first, out_objects.end());
+		out_objects.erase(std::unique(out_objects.begin() + first, out_objects.end()), out_objects.end());
+	}
+
+	Maths::BoundingBox Octree::GetQueryBounds(const OctreeNode* node) const
+	{
+		return Maths::BoundingBox(node->boundingBox.min_ - Maths::Vector3(m_QueryMargin), node->boundingBox.max_ + Maths::Vector3(m_QueryMargin));
+	}
+
+	void Octree::QueryNode(const OctreeNode* node, const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects) const
+	{
+		if (box.IsInsideFast(GetQueryBounds(node)) == Maths::OUTSIDE)
+			return;
+
+		if (node->childNodes.empty())
+		{
+			for (const auto& obj : node->physicsObjects)
+			{
+				if (box.IsInsideFast(obj->GetWorldSpaceAABB()) != Maths::OUTSIDE)
+					out_objects.push_back(obj.get());
+			}
+			return;
+		}
+
+		for (const auto& child : node->childNodes)
+			QueryNode(child.get(), box, out_objects);
+	}
+
+	void Octree::QueryNode(const OctreeNode* node, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects) const
+	{
+		if (ray.HitDistance(GetQueryBounds(node)) > maxDistance)
+			return;
+
+		if (node->childNodes.empty())
+		{
+			TestRayAgainstObjects(node->physicsObjects.data(), node->physicsObjects.size(), ray, maxDistance, out_objects);
+			return;
+		}
+
+		for (const auto& child : node->childNodes)
+			QueryNode(child.get(), ray, maxDistance, out_objects);
+	}
+
 	void Octree::DebugDrawOctreeNode(OctreeNode* node)
 	{
 	}
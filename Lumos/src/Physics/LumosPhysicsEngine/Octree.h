@@ -35,15 +35,25 @@ namespace Lumos
 
 		void FindPotentialCollisionPairs(std::vector<Ref<PhysicsObject3D>>& objects, std::vector<CollisionPair> &collisionPairs) override;
 		void DebugDraw() override;
+
+		void FindObjectsInAABB(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects) const override;
+		void FindObjectsOnRay(const std::vector<Ref<PhysicsObject3D>>& objects, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects) const override;
+
 		void Divide(const Ref<OctreeNode>& node, size_t iteration);
 		static void DebugDrawOctreeNode(OctreeNode* node);
 
 	private:
+		// Node bounds grown by the query margin, objects can have moved one step since the tree was built
+		Maths::BoundingBox GetQueryBounds(const OctreeNode* node) const;
+		void QueryNode(const OctreeNode* node, const Maths::BoundingBox& box, std::vector<PhysicsObject3D*>& out_objects) const;
+		void QueryNode(const OctreeNode* node, const Maths::Ray& ray, float maxDistance, std::vector<PhysicsObject3D*>& out_objects) const;
+
 		size_t m_MaxObjectsPerPartition;
 		size_t m_MaxPartitionDepth;
 
 		Ref<Broadphase> m_SecondaryBroadphase; //Broadphase stage used to determine collision pairs within subdivisions
 		Ref<OctreeNode> m_RootNode;
 		std::vector<Ref<OctreeNode>> m_LeafNodes;
+		float m_QueryMargin = 0.0f;
 	};
 }
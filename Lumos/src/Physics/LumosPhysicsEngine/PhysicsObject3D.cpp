@@ -9,15 +9,12 @@ namespace Lumos
 		, m_wsTransformInvalidated(true)
 		, m_RestVelocityThresholdSquared(0.001f)
 		, m_AverageSummedVelocity(0.0f)
+		, m_IslandIndex(~0u)
+		, m_IsBullet(false)
+		, m_SweepTime(1.0f / 60.0f)
+		, m_PoseChanged(true)
 		, m_wsAabbInvalidated(true)
-		, m_Position(0.0f, 0.0f, 0.0f)
-		, m_LinearVelocity(0.0f, 0.0f, 0.0f)
-		, m_Force(0.0f, 0.0f, 0.0f)
-		, m_InvMass(0.0f)
-		, m_Orientation(1.0f, 0.0f, 0.0f, 0.0f)
-		, m_AngularVelocity(0.0f, 0.0f, 0.0f)
-		, m_Torque(0.0f, 0.0f, 0.0f)
-		, m_InvInertia(Maths::Matrix3::ZERO)
+		, m_wsCollisionDataInvalidated(true)
 		, m_OnCollisionCallback(nullptr)
 	{
 		m_localBoundingBox.Define(Maths::Vector3(-0.5f), Maths::Vector3(0.5f));
@@ -27,6 +24,28 @@ namespace Lumos
 	{
 	}
 
+	PhysicsObject3D::StateSlot::StateSlot(const StateSlot& other)
+	{
+		if (other.store)
+			other.store->Read(other.index, local);
+		else
+			local = other.local;
+	}
+
+	PhysicsObject3D::StateSlot& PhysicsObject3D::StateSlot::operator=(const StateSlot& other)
+	{
+		RigidBodyState state = other.local;
+		if (other.store)
+			other.store->Read(other.index, state);
+
+		if (store)
+			store->Write(index, state);
+		else
+			local = state;
+
+		return *this;
+	}
+
 	Maths::BoundingBox PhysicsObject3D::GetWorldSpaceAABB()
 	{
 		if (m_wsAabbInvalidated)
@@ -35,6 +54,15 @@ namespace Lumos
 			m_wsAabbInvalidated = false;
 		}
 
+		if (m_IsBullet)
+		{
+			// Velocity can change without invalidating the cached box, so the sweep is added on top
+			const Maths::Vector3 motion = GetLinearVelocity() * m_SweepTime;
+			Maths::BoundingBox swept = m_wsAabb;
+			swept.Merge(Maths::BoundingBox(m_wsAabb.min_ + motion, m_wsAabb.max_ + motion));
+			return swept;
+		}
+
 		return m_wsAabb;
 	}
 
@@ -46,21 +74,84 @@ namespace Lumos
 	void PhysicsObject3D::SetIsAtRest(const bool isAtRest)
 	{
 		m_AtRest = isAtRest;
+		UpdateActive();
+	}
+
+	void PhysicsObject3D::SetIsStatic(const bool isStatic)
+	{
+		m_Static = isStatic;
+		UpdateActive();
+	}
+
+	void PhysicsObject3D::UpdateActive()
+	{
+		// Only awake, non static bodies are integrated
+		if (m_State.store)
+			m_State.store->SetActive(m_State.index, !m_Static && !m_AtRest);
 	}
 
 	const Maths::Matrix4& PhysicsObject3D::GetWorldSpaceTransform() const
 	{
 		if (m_wsTransformInvalidated)
 		{
-			m_wsTransform = m_Orientation.RotationMatrix4();
-			m_wsTransform.SetTranslation(m_Position);
+			m_wsTransform = GetOrientation().RotationMatrix4();
+			m_wsTransform.SetTranslation(GetPosition());
 
 			m_wsTransformInvalidated = false;
+			m_wsCollisionDataInvalidated = true;
 		}
 
 		return m_wsTransform;
 	}
 
+	const std::vector<Maths::Vector3>& PhysicsObject3D::GetWorldSpaceCollisionAxes() const
+	{
+		UpdateWorldSpaceCollisionData();
+		return m_wsCollisionAxes;
+	}
+
+	const std::vector<CollisionEdge>& PhysicsObject3D::GetWorldSpaceEdges() const
+	{
+		UpdateWorldSpaceCollisionData();
+		return m_wsEdges;
+	}
+
+	const std::vector<Maths::Vector3>& PhysicsObject3D::GetWorldSpaceEdgeDirections() const
+	{
+		UpdateWorldSpaceCollisionData();
+		return m_wsEdgeDirections;
+	}
+
+	void PhysicsObject3D::UpdateWorldSpaceCollisionData() const
+	{
+		//Also flags the collision data when the transform has changed
+		const Maths::Matrix4& transform = GetWorldSpaceTransform();
+
+		if (!m_wsCollisionDataInvalidated)
+			return;
+
+		m_wsCollisionDataInvalidated = false;
+
+		//Storage is reused, so this only allocates when the shape grows
+		m_wsCollisionAxes.clear();
+		m_wsEdges.clear();
+		m_wsEdgeDirections.clear();
+
+		if (!m_CollisionShape)
+			return;
+
+		const Maths::Matrix3 rotation = transform.ToMatrix3();
+
+		for (const Maths::Vector3& axis : m_CollisionShape->GetLocalCollisionAxes())
+			m_wsCollisionAxes.push_back(rotation * axis);
+
+		for (const CollisionEdge& edge : m_CollisionShape->GetLocalEdges())
+			m_wsEdges.emplace_back(transform * edge.posA, transform * edge.posB);
+
+		for (const Maths::Vector3& direction : m_CollisionShape->GetLocalEdgeDirections())
+			m_wsEdgeDirections.push_back(rotation * direction);
+	}
+
 	void PhysicsObject3D::AutoResizeBoundingBox()
 	{
 		m_localBoundingBox.Clear();
@@ -99,7 +190,7 @@ namespace Lumos
 		static const float ALPHA = 0.7f;
 
 		// Calculate exponential moving average
-		const float v = m_LinearVelocity.LengthSquared() + m_AngularVelocity.LengthSquared();
+		const float v = GetLinearVelocity().LengthSquared() + GetAngularVelocity().LengthSquared();
 		m_AverageSummedVelocity += ALPHA * (v - m_AverageSummedVelocity);
 
 		// Do test
@@ -112,8 +203,23 @@ namespace Lumos
 
 	nlohmann::json PhysicsObject3D::Serialise()
 	{
+		const Maths::Vector3 position = GetPosition();
+		const Maths::Quaternion orientation = GetOrientation();
+		const Maths::Vector3 linearVelocity = GetLinearVelocity();
+		const Maths::Vector3 angularVelocity = GetAngularVelocity();
+		const Maths::Matrix3 inverseInertia = GetInverseInertia();
+
 		nlohmann::json output;
 		output["typeID"] = LUMOS_TYPENAME(PhysicsObject3D);
+		output["position"] = { position.x, position.y, position.z };
+		output["orientation"] = { orientation.w, orientation.x, orientation.y, orientation.z };
+		output["linearVelocity"] = { linearVelocity.x, linearVelocity.y, linearVelocity.z };
+		output["angularVelocity"] = { angularVelocity.x, angularVelocity.y, angularVelocity.z };
+		output["inverseMass"] = GetInverseMass();
+		output["inverseInertia"] = std::vector<float>(inverseInertia.Data(), inverseInertia.Data() + 9);
+		output["static"] = m_Static;
+		output["elasticity"] = m_Elasticity;
+		output["friction"] = m_Friction;
 
 		//output["collisionShape"]	= m_CollisionShape;
 
@@ -122,6 +228,21 @@ namespace Lumos
 
 	void PhysicsObject3D::Deserialise(nlohmann::json& data)
 	{
+		const std::vector<float> position = data["position"].get<std::vector<float>>();
+		const std::vector<float> orientation = data["orientation"].get<std::vector<float>>();
+		const std::vector<float> linearVelocity = data["linearVelocity"].get<std::vector<float>>();
+		const std::vector<float> angularVelocity = data["angularVelocity"].get<std::vector<float>>();
+		const std::vector<float> inverseInertia = data["inverseInertia"].get<std::vector<float>>();
+
+		SetPosition(Maths::Vector3(position.data()));
+		SetOrientation(Maths::Quaternion(orientation[0], orientation[1], orientation[2], orientation[3]));
+		SetLinearVelocity(Maths::Vector3(linearVelocity.data()));
+		SetAngularVelocity(Maths::Vector3(angularVelocity.data()));
+		SetInverseMass(data["inverseMass"]);
+		SetInverseInertia(Maths::Matrix3(inverseInertia.data()));
+		SetElasticity(data["elasticity"]);
+		SetFriction(data["friction"]);
+		SetIsStatic(data["static"]);
 
 		//m_CollisionShape.Deserialise(data["collisionShape"]);
 	}
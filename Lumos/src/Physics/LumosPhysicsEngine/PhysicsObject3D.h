@@ -3,6 +3,7 @@
 #include "lmpch.h"
 #include "Physics/PhysicsObject.h"
 #include "CollisionShape.h"
+#include "BodyStateStore.h"
 
 #include "Maths/Maths.h"
 
@@ -24,27 +25,39 @@ namespace Lumos
 	class LUMOS_EXPORT PhysicsObject3D : public PhysicsObject
 	{
 		friend class LumosPhysicsEngine;
+		friend class BodyStateStore;
 
 	public:
 		PhysicsObject3D();
 		virtual ~PhysicsObject3D();
 
 		//<--------- GETTERS ------------->
-		const Maths::Vector3&	 GetPosition()			  const { return m_Position; }
-		const Maths::Vector3&	 GetLinearVelocity()	  const { return m_LinearVelocity; }
-		const Maths::Vector3&	 GetForce()				  const { return m_Force; }
-		float					 GetInverseMass()		  const { return m_InvMass; }
-		const Maths::Quaternion& GetOrientation()	      const { return m_Orientation; }
-		const Maths::Vector3&	 GetAngularVelocity()	  const { return m_AngularVelocity; }
-		const Maths::Vector3&	 GetTorque()			  const { return m_Torque; }
-		const Maths::Matrix3&	 GetInverseInertia()	  const { return m_InvInertia; }
+		Maths::Vector3			 GetPosition()			  const { return ReadVector3(BodyStateStore::PositionX, m_State.local.position); }
+		Maths::Vector3			 GetLinearVelocity()	  const { return ReadVector3(BodyStateStore::VelocityX, m_State.local.linearVelocity); }
+		Maths::Vector3			 GetForce()				  const { return ReadVector3(BodyStateStore::ForceX, m_State.local.force); }
+		float					 GetInverseMass()		  const { return m_State.store ? m_State.store->Get(BodyStateStore::InvMass, m_State.index) : m_State.local.invMass; }
+		Maths::Quaternion		 GetOrientation()	      const { return m_State.store ? m_State.store->GetOrientation(m_State.index) : m_State.local.orientation; }
+		Maths::Vector3			 GetAngularVelocity()	  const { return ReadVector3(BodyStateStore::AngularVelocityX, m_State.local.angularVelocity); }
+		Maths::Vector3			 GetTorque()			  const { return ReadVector3(BodyStateStore::TorqueX, m_State.local.torque); }
+		Maths::Matrix3			 GetInverseInertia()	  const { return m_State.store ? m_State.store->GetInverseInertia(m_State.index) : m_State.local.invInertia; }
 		const Ref<CollisionShape>&	GetCollisionShape()	  const { return m_CollisionShape; }
+		bool					 GetIsBullet()			  const { return m_IsBullet; }
+
+		//Static and infinite mass bodies are never moved by the solver, islands solved on different jobs can share them
+		bool					 GetIsSolverDynamic()	  const { return !m_Static && GetInverseMass() > 0.0f; }
 		const Maths::Matrix4&	 GetWorldSpaceTransform() const;	//Built from scratch or returned from cached value
 
+		//World space copies of the collision shape axes/edges. Rebuilt at most once per transform change
+		const std::vector<Maths::Vector3>& GetWorldSpaceCollisionAxes() const;
+		const std::vector<CollisionEdge>&  GetWorldSpaceEdges() const;
+		const std::vector<Maths::Vector3>& GetWorldSpaceEdgeDirections() const;
+
+		//For bullets this is swept along the velocity over one physics step
 		Maths::BoundingBox GetWorldSpaceAABB();
 
 		void WakeUp() override;
 		void SetIsAtRest(const bool isAtRest) override;
+		void SetIsStatic(const bool isStatic) override;
 
 		Maths::BoundingBox GetLocalBoundingBox() const
 		{
@@ -69,28 +82,49 @@ namespace Lumos
 
 		void SetPosition(const Maths::Vector3& v)
 		{
-			m_Position = v;
+			WriteVector3(BodyStateStore::PositionX, m_State.local.position, v);
 			m_wsTransformInvalidated = true;
 			m_wsAabbInvalidated = true;
+			m_PoseChanged = true;
 			//m_AtRest = false;
 		}
 
-        void SetLinearVelocity(const Maths::Vector3& v) { if(m_Static) return; m_LinearVelocity = v; }
-		void SetForce(const Maths::Vector3& v) { if(m_Static) return; m_Force = v; }
-		void SetInverseMass(const float& v) { m_InvMass = v; }
+        void SetLinearVelocity(const Maths::Vector3& v) { if(m_Static) return; WriteVector3(BodyStateStore::VelocityX, m_State.local.linearVelocity, v); }
+		void SetForce(const Maths::Vector3& v) { if(m_Static) return; WriteVector3(BodyStateStore::ForceX, m_State.local.force, v); }
+		void SetInverseMass(const float& v)
+		{
+			if (m_State.store)
+				m_State.store->Set(BodyStateStore::InvMass, m_State.index, v);
+			else
+				m_State.local.invMass = v;
+		}
 
 		void SetOrientation(const Maths::Quaternion& v)
 		{
-			m_Orientation = v;
+			if (m_State.store)
+				m_State.store->SetOrientation(m_State.index, v);
+			else
+				m_State.local.orientation = v;
+
 			m_wsTransformInvalidated = true;
+			m_PoseChanged = true;
 			//m_AtRest = false;
 		}
 
-		void SetAngularVelocity(const Maths::Vector3& v) { if(m_Static) return; m_AngularVelocity = v; }
-		void SetTorque(const Maths::Vector3& v) {if(m_Static) return;  m_Torque = v; }
-		void SetInverseInertia(const Maths::Matrix3& v) { m_InvInertia = v; }
+		void SetAngularVelocity(const Maths::Vector3& v) { if(m_Static) return; WriteVector3(BodyStateStore::AngularVelocityX, m_State.local.angularVelocity, v); }
+		void SetTorque(const Maths::Vector3& v) {if(m_Static) return; WriteVector3(BodyStateStore::TorqueX, m_State.local.torque, v); }
+		void SetInverseInertia(const Maths::Matrix3& v)
+		{
+			if (m_State.store)
+				m_State.store->SetInverseInertia(m_State.index, v);
+			else
+				m_State.local.invInertia = v;
+		}
+
+		//Fast moving bodies flagged as bullets use continuous collision detection to avoid tunnelling
+		void SetIsBullet(bool bullet) { m_IsBullet = bullet; }
 
-		void SetCollisionShape(const Ref<CollisionShape>& colShape) { m_CollisionShape = colShape; AutoResizeBoundingBox(); }
+		void SetCollisionShape(const Ref<CollisionShape>& colShape) { m_CollisionShape = colShape; m_wsCollisionDataInvalidated = true; AutoResizeBoundingBox(); }
 
 		//<---------- CALLBACKS ------------>
 		void SetOnCollisionCallback(PhysicsCollisionCallback& callback) { m_OnCollisionCallback = callback; }
@@ -131,23 +165,52 @@ namespace Lumos
 		mutable bool		m_wsTransformInvalidated;
 		float				m_RestVelocityThresholdSquared;
 		float				m_AverageSummedVelocity;
+		u32					m_IslandIndex;		//!< Index into the engine body list for the current step, used for island building
+		bool				m_IsBullet;			//!< Swept against its broadphase pairs each step instead of moving discretely
+		float				m_SweepTime;		//!< Length of the engine step its bullet bounds are swept over
+		bool				m_PoseChanged;		//!< Position/orientation changed since the engine last wrote them to the entity transform
 
 		mutable Maths::Matrix4 	   m_wsTransform;
 		Maths::BoundingBox		   m_localBoundingBox;   //!< Model orientated bounding box in model space
 		mutable bool			   m_wsAabbInvalidated;  //!< Flag indicating if the cached world space transoformed AABB is invalid
 		mutable Maths::BoundingBox m_wsAabb;			 //!< Axis aligned bounding box of this object in world space
 
-		//<---------LINEAR-------------->
-		Maths::Vector3		m_Position;
-		Maths::Vector3		m_LinearVelocity;
-		Maths::Vector3		m_Force;
-		float m_InvMass;
-
-		//<----------ANGULAR-------------->
-		Maths::Quaternion  m_Orientation;
-		Maths::Vector3	   m_AngularVelocity;
-		Maths::Vector3	   m_Torque;
-		Maths::Matrix3	   m_InvInertia;
+		void UpdateWorldSpaceCollisionData() const;
+
+		mutable bool						m_wsCollisionDataInvalidated;	//!< Set whenever the world transform is rebuilt
+		mutable std::vector<Maths::Vector3> m_wsCollisionAxes;
+		mutable std::vector<CollisionEdge>	m_wsEdges;
+		mutable std::vector<Maths::Vector3> m_wsEdgeDirections;
+
+		//<----------STATE--------------->
+		//Linear and angular state. Kept in the body until an engine attaches it, then in its slot of the engine's BodyStateStore
+		struct StateSlot
+		{
+			BodyStateStore* store = nullptr;
+			u32				index = 0;
+			RigidBodyState	local;		//!< Stale while attached
+
+			StateSlot() = default;
+			StateSlot(const StateSlot& other);				//!< Copies are never attached
+			StateSlot& operator=(const StateSlot& other);	//!< Keeps this body's slot
+		};
+
+		StateSlot m_State;
+
+		Maths::Vector3 ReadVector3(BodyStateStore::Channel x, const Maths::Vector3& local) const
+		{
+			return m_State.store ? m_State.store->GetVector3(x, m_State.index) : local;
+		}
+
+		void WriteVector3(BodyStateStore::Channel x, Maths::Vector3& local, const Maths::Vector3& v)
+		{
+			if (m_State.store)
+				m_State.store->SetVector3(x, m_State.index, v);
+			else
+				local = v;
+		}
+
+		void UpdateActive();
 
 		//<----------COLLISION------------>
 		Ref<CollisionShape> m_CollisionShape;
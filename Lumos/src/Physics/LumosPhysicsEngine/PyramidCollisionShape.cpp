@@ -17,6 +17,8 @@ namespace Lumos
 		{
 			ConstructPyramidHull();
 		}
+
+		BuildCollisionData();
 	}
 
 	PyramidCollisionShape::PyramidCollisionShape(const Maths::Vector3& halfdims)
@@ -26,24 +28,12 @@ namespace Lumos
 		m_LocalTransform = Maths::Matrix4::Scale(m_PyramidHalfDimensions);
 		m_Type = CollisionShapeType::CollisionPyramid;
 
-		Maths::Vector3 m_Points[5] = {
-			m_LocalTransform * Maths::Vector3(-1.0f, -1.0f, -1.0f),
-			m_LocalTransform * Maths::Vector3(-1.0f, -1.0f, 1.0f),
-			m_LocalTransform * Maths::Vector3(1.0f, -1.0f, 1.0f),
-			m_LocalTransform * Maths::Vector3(1.0f, -1.0f, -1.0f),
-			m_LocalTransform * Maths::Vector3(0.0f, 1.0f, 0.0f)
-		};
-
-		m_Normals[0] = Maths::Vector3::Cross(m_Points[0] - m_Points[3], m_Points[4] - m_Points[3]).Normalized();
-		m_Normals[1] = Maths::Vector3::Cross(m_Points[1] - m_Points[0], m_Points[4] - m_Points[0]).Normalized();
-		m_Normals[2] = Maths::Vector3::Cross(m_Points[2] - m_Points[1], m_Points[4] - m_Points[1]).Normalized();
-		m_Normals[3] = Maths::Vector3::Cross(m_Points[3] - m_Points[2], m_Points[4] - m_Points[2]).Normalized();
-		m_Normals[4] = Maths::Vector3(0.0f, -1.0f, 0.0f);
-
 		if (m_PyramidHull->GetNumVertices() == 0)
 		{
 			ConstructPyramidHull();
 		}
+
+		BuildCollisionData();
 	}
 
 	PyramidCollisionShape::~PyramidCollisionShape()
@@ -63,33 +53,24 @@ namespace Lumos
 		return inertia;
 	}
 
-	void PyramidCollisionShape::GetCollisionAxes(const PhysicsObject3D* currentObject, std::vector<Maths::Vector3>* out_axes) const
+	void PyramidCollisionShape::BuildCollisionData()
 	{
-		if (out_axes)
-		{
-			const Maths::Matrix3 objOrientation = currentObject->GetOrientation().RotationMatrix();
-			out_axes->push_back(objOrientation * m_Normals[0]);
-			out_axes->push_back(objOrientation * m_Normals[1]);
-			out_axes->push_back(objOrientation * m_Normals[2]);
-			out_axes->push_back(objOrientation * m_Normals[3]);
-			out_axes->push_back(objOrientation * m_Normals[4]);
-		}
-	}
+		Maths::Vector3 points[5] = {
+			m_LocalTransform * Maths::Vector3(-1.0f, -1.0f, -1.0f),
+			m_LocalTransform * Maths::Vector3(-1.0f, -1.0f, 1.0f),
+			m_LocalTransform * Maths::Vector3(1.0f, -1.0f, 1.0f),
+			m_LocalTransform * Maths::Vector3(1.0f, -1.0f, -1.0f),
+			m_LocalTransform * Maths::Vector3(0.0f, 1.0f, 0.0f)
+		};
 
-	void PyramidCollisionShape::GetEdges(const PhysicsObject3D* currentObject, std::vector<CollisionEdge>* out_edges) const
-	{
-		if (out_edges)
-		{
-			Maths::Matrix4 transform = currentObject->GetWorldSpaceTransform() * m_LocalTransform;
-			for (unsigned int i = 0; i < m_PyramidHull->GetNumEdges(); ++i)
-			{
-				const HullEdge& edge = m_PyramidHull->GetEdge(i);
-				Maths::Vector3 A = transform * m_PyramidHull->GetVertex(edge.vStart).pos;
-				Maths::Vector3 B = transform * m_PyramidHull->GetVertex(edge.vEnd).pos;
+		m_LocalCollisionAxes.clear();
+		m_LocalCollisionAxes.push_back(Maths::Vector3::Cross(points[0] - points[3], points[4] - points[3]).Normalized());
+		m_LocalCollisionAxes.push_back(Maths::Vector3::Cross(points[1] - points[0], points[4] - points[0]).Normalized());
+		m_LocalCollisionAxes.push_back(Maths::Vector3::Cross(points[2] - points[1], points[4] - points[1]).Normalized());
+		m_LocalCollisionAxes.push_back(Maths::Vector3::Cross(points[3] - points[2], points[4] - points[2]).Normalized());
+		m_LocalCollisionAxes.emplace_back(0.0f, -1.0f, 0.0f);
 
-				out_edges->emplace_back(A, B);
-			}
-		}
+		BuildLocalEdges(*m_PyramidHull);
 	}
 
 	void PyramidCollisionShape::GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const
@@ -17,8 +17,6 @@ namespace Lumos
 		//Collision Shape Functionality
 		virtual Maths::Matrix3 BuildInverseInertia(float invMass) const override;
 
-		virtual void GetCollisionAxes(const PhysicsObject3D* currentObject, std::vector<Maths::Vector3>* out_axes) const override;
-		virtual void GetEdges(const PhysicsObject3D* currentObject, std::vector<CollisionEdge>* out_edges) const override;
 
 		virtual void GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const override;
 		virtual void GetIncidentReferencePolygon(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, std::list<Maths::Vector3>* out_face, Maths::Vector3* out_normal, std::vector<Maths::Plane>* out_adjacent_planes) const override;
@@ -41,9 +39,11 @@ namespace Lumos
 		//Constructs the static cube hull
 		static void ConstructPyramidHull();
 
+		//Caches the local space face normals and edges used by SAT
+		void BuildCollisionData();
+
 	protected:
 		Maths::Vector3		m_PyramidHalfDimensions;
-		Maths::Vector3		m_Normals[5];
 		
 		static Scope<Hull> m_PyramidHull;
 	};
@@ -38,16 +38,6 @@ namespace Lumos
 		return inertia;
 	}
 
-	void SphereCollisionShape::GetCollisionAxes(const PhysicsObject3D* currentObject, std::vector<Maths::Vector3>* out_axes) const
-	{
-		/* There is infinite edges so handle seperately */
-	}
-
-	void SphereCollisionShape::GetEdges(const PhysicsObject3D* currentObject, std::vector<CollisionEdge>* out_edges) const
-	{
-		/* There is infinite edges on a sphere so handle seperately */
-	}
-
 	void SphereCollisionShape::GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const
 	{
 		Maths::Matrix4 transform;
@@ -45,7 +45,7 @@ namespace Lumos
 		{
 			float distanceOffset = ab.Length() - m_restDistance;
 			float baumgarteScalar = 0.1f;
-			b = -(baumgarteScalar / LumosPhysicsEngine::GetDeltaTime()) * distanceOffset;
+			b = -(baumgarteScalar / m_DeltaTime) * distanceOffset;
 		}
 
 		float jn = (-(Maths::Vector3::Dot(v0 - v1, abn) + b) * m_springConstant) - (m_dampingFactor * (v0 - v1).Length());
@@ -13,13 +13,18 @@ namespace Lumos
 			float springConstant, float dampingFactor);
 
 		virtual void ApplyImpulse() override;
+		virtual void PreSolverStep(float dt) override { m_DeltaTime = dt; }
 		virtual void DebugDraw() const override;
 
+		PhysicsObject3D* GetObjectA() const override { return m_pObj1; }
+		PhysicsObject3D* GetObjectB() const override { return m_pObj2; }
+
 	protected:
 		PhysicsObject3D *m_pObj1;
 		PhysicsObject3D *m_pObj2;
 
 		float m_restDistance;
+		float m_DeltaTime = 1.0f / 60.0f;	//Length of the step being solved
 
 		float m_springConstant;
 		float m_dampingFactor;
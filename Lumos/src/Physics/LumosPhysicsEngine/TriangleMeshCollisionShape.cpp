@@ -0,0 +1,505 @@
+#include "lmpch.h"
+#include "TriangleMeshCollisionShape.h"
+#include "PhysicsObject3D.h"
+#include "Graphics/Mesh.h"
+
+namespace Lumos
+{
+	namespace
+	{
+		const u32 BinCount = 12;
+		const u32 NoParent = ~0u;
+
+		struct BuildTask
+		{
+			u32 start;
+			u32 count;
+			u32 parent;	//!< Inner node whose right child this range becomes
+			u32 depth;
+		};
+
+		float SurfaceArea(const Maths::BoundingBox& box)
+		{
+			const Maths::Vector3 size = box.Size();
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		//Two sided Moller-Trumbore, the ray direction does not need to be normalised
+		bool RayTriangle(const Maths::Vector3& origin, const Maths::Vector3& direction, const Maths::Vector3& a, const Maths::Vector3& b, const Maths::Vector3& c, float* out_t)
+		{
+			const Maths::Vector3 e1 = b - a;
+			const Maths::Vector3 e2 = c - a;
+			const Maths::Vector3 p = direction.CrossProduct(e2);
+
+			const float det = e1.DotProduct(p);
+			if (abs(det) < 1e-12f)
+				return false;
+
+			const float invDet = 1.0f / det;
+			const Maths::Vector3 s = origin - a;
+			const float u = s.DotProduct(p) * invDet;
+			if (u < 0.0f || u > 1.0f)
+				return false;
+
+			const Maths::Vector3 q = s.CrossProduct(e1);
+			const float v = direction.DotProduct(q) * invDet;
+			if (v < 0.0f || u + v > 1.0f)
+				return false;
+
+			*out_t = e2.DotProduct(q) * invDet;
+			return *out_t >= 0.0f;
+		}
+	}
+
+	TriangleMeshCollisionShape::TriangleMeshCollisionShape()
+	{
+		m_Type = CollisionTriangleMesh;
+		m_Bounds.Clear();
+	}
+
+	TriangleMeshCollisionShape::TriangleMeshCollisionShape(const std::vector<Maths::Vector3>& vertices, const std::vector<u32>& indices)
+	{
+		m_Type = CollisionTriangleMesh;
+		Build(vertices, indices);
+	}
+
+	TriangleMeshCollisionShape::~TriangleMeshCollisionShape()
+	{
+	}
+
+	Ref<TriangleMeshCollisionShape> TriangleMeshCollisionShape::CreateFromMesh(const Graphics::Vertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount)
+	{
+		std::vector<Maths::Vector3> positions(vertexCount);
+		for (u32 i = 0; i < vertexCount; ++i)
+			positions[i] = vertices[i].Position;
+
+		return CreateRef<TriangleMeshCollisionShape>(positions, std::vector<u32>(indices, indices + indexCount));
+	}
+
+	void TriangleMeshCollisionShape::Build(const std::vector<Maths::Vector3>& vertices, const std::vector<u32>& indices)
+	{
+		m_Vertices = vertices;
+		m_Indices.clear();
+		m_Nodes.clear();
+		m_Bounds.Clear();
+
+		// Leaves address their first triangle with the bits below the count
+		const u32 maxTriangles = LeafFirstMask;
+		u32 triangleCount = static_cast<u32>(indices.size() / 3);
+		if (triangleCount > maxTriangles)
+		{
+			Debug::Log::Warning("Triangle mesh collision shape has too many triangles, only the first {0} are used", maxTriangles);
+			triangleCount = maxTriangles;
+		}
+
+		const u32 vertexCount = static_cast<u32>(vertices.size());
+
+		std::vector<Maths::BoundingBox> triangleBounds(triangleCount);
+		std::vector<Maths::Vector3> centroids(triangleCount);
+		std::vector<u32> order;
+		order.reserve(triangleCount);
+
+		for (u32 i = 0; i < triangleCount; ++i)
+		{
+			const u32* index = &indices[i * 3];
+			if (index[0] >= vertexCount || index[1] >= vertexCount || index[2] >= vertexCount)
+				continue;
+
+			Maths::BoundingBox& box = triangleBounds[i];
+			box.Clear();
+			box.Merge(vertices[index[0]]);
+			box.Merge(vertices[index[1]]);
+			box.Merge(vertices[index[2]]);
+
+			centroids[i] = box.Center();
+			m_Bounds.Merge(box);
+			order.push_back(i);
+		}
+
+		if (order.empty())
+			return;
+
+		const Maths::Vector3 size = m_Bounds.Size();
+		auto quantizeScale = [](float extent) { return extent > Maths::M_EPSILON ? 65535.0f / extent : 0.0f; };
+		auto dequantizeScale = [](float extent) { return extent > Maths::M_EPSILON ? extent / 65535.0f : 0.0f; };
+		m_QuantizeScale = Maths::Vector3(quantizeScale(size.x), quantizeScale(size.y), quantizeScale(size.z));
+		m_DequantizeScale = Maths::Vector3(dequantizeScale(size.x), dequantizeScale(size.y), dequantizeScale(size.z));
+
+		m_Nodes.reserve(order.size() / 2 + 1);
+
+		std::vector<BuildTask> tasks;
+		tasks.push_back({ 0, static_cast<u32>(order.size()), NoParent, 0 });
+
+		Maths::BoundingBox binBounds[BinCount];
+		u32 binCounts[BinCount];
+		float leftAreas[BinCount];
+		u32 leftCounts[BinCount];
+
+		while (!tasks.empty())
+		{
+			const BuildTask task = tasks.back();
+			tasks.pop_back();
+
+			const u32 nodeIndex = static_cast<u32>(m_Nodes.size());
+			if (task.parent != NoParent)
+				m_Nodes[task.parent].data = nodeIndex;
+
+			u32* begin = order.data() + task.start;
+			u32* end = begin + task.count;
+
+			Maths::BoundingBox box, centroidBox;
+			box.Clear();
+			centroidBox.Clear();
+			for (u32* it = begin; it != end; ++it)
+			{
+				box.Merge(triangleBounds[*it]);
+				centroidBox.Merge(centroids[*it]);
+			}
+
+			BVHNode node;
+			Quantize(box, node.min, node.max);
+
+			u32 split = 0;
+
+			// Past half the depth budget the tree falls back to median splits, which are guaranteed to finish in time
+			if (task.count > 1 && task.depth < MaxTreeDepth / 2)
+			{
+				// Cost of a leaf is one test per triangle, a split adds one traversal step.
+				// Ranges too large for a leaf take the best split even if it does not pay off.
+				const float parentArea = Maths::Max(SurfaceArea(box), Maths::M_EPSILON);
+				float bestCost = task.count > MaxLeafTriangles ? FLT_MAX : static_cast<float>(task.count);
+				int bestAxis = -1;
+				u32 bestBin = 0;
+
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					const float axisMin = centroidBox.min_[axis];
+					const float extent = centroidBox.max_[axis] - axisMin;
+					if (extent <= Maths::M_EPSILON)
+						continue;
+
+					const float binScale = BinCount / extent;
+
+					for (u32 b = 0; b < BinCount; ++b)
+					{
+						binBounds[b].Clear();
+						binCounts[b] = 0;
+					}
+
+					for (u32* it = begin; it != end; ++it)
+					{
+						const u32 b = Maths::Min(static_cast<u32>((centroids[*it][axis] - axisMin) * binScale), BinCount - 1);
+						binBounds[b].Merge(triangleBounds[*it]);
+						++binCounts[b];
+					}
+
+					Maths::BoundingBox accumulated;
+					accumulated.Clear();
+					u32 count = 0;
+					for (u32 b = 0; b < BinCount - 1; ++b)
+					{
+						if (binCounts[b] > 0)
+							accumulated.Merge(binBounds[b]);
+						count += binCounts[b];
+						leftAreas[b] = count > 0 ? SurfaceArea(accumulated) : 0.0f;
+						leftCounts[b] = count;
+					}
+
+					accumulated.Clear();
+					count = 0;
+					for (u32 b = BinCount - 1; b > 0; --b)
+					{
+						if (binCounts[b] > 0)
+							accumulated.Merge(binBounds[b]);
+						count += binCounts[b];
+
+						// Split between bin b - 1 and b
+						if (count == 0 || leftCounts[b - 1] == 0)
+							continue;
+
+						const float cost = 1.0f + (leftAreas[b - 1] * leftCounts[b - 1] + SurfaceArea(accumulated) * count) / parentArea;
+						if (cost < bestCost)
+						{
+							bestCost = cost;
+							bestAxis = axis;
+							bestBin = b - 1;
+						}
+					}
+				}
+
+				if (bestAxis >= 0)
+				{
+					const float axisMin = centroidBox.min_[bestAxis];
+					const float binScale = BinCount / (centroidBox.max_[bestAxis] - axisMin);
+
+					u32* middle = std::partition(begin, end, [&](u32 triangle)
+					{
+						return Maths::Min(static_cast<u32>((centroids[triangle][bestAxis] - axisMin) * binScale), BinCount - 1) <= bestBin;
+					});
+
+					split = static_cast<u32>(middle - begin);
+					if (split == task.count)
+						split = 0;
+				}
+			}
+
+			if (split == 0 && task.count > MaxLeafTriangles)
+			{
+				const Maths::Vector3 extent = centroidBox.Size();
+				const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+				split = task.count / 2;
+				std::nth_element(begin, begin + split, end, [&](u32 a, u32 b) { return centroids[a][axis] < centroids[b][axis]; });
+			}
+
+			if (split == 0)
+			{
+				node.data = LeafFlag | ((task.count - 1) << LeafCountShift) | task.start;
+				m_Nodes.push_back(node);
+				continue;
+			}
+
+			node.data = 0;
+			m_Nodes.push_back(node);
+
+			// The left range is built next so it directly follows its parent
+			tasks.push_back({ task.start + split, task.count - split, nodeIndex, task.depth + 1 });
+			tasks.push_back({ task.start, split, NoParent, task.depth + 1 });
+		}
+
+		m_Indices.resize(order.size() * 3);
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			const u32* index = &indices[order[i] * 3];
+			m_Indices[i * 3 + 0] = index[0];
+			m_Indices[i * 3 + 1] = index[1];
+			m_Indices[i * 3 + 2] = index[2];
+		}
+	}
+
+	void TriangleMeshCollisionShape::Quantize(const Maths::BoundingBox& box, u16* out_min, u16* out_max) const
+	{
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			// Rounded outwards so the quantized box always contains the original
+			const float lower = floorf((box.min_[axis] - m_Bounds.min_[axis]) * m_QuantizeScale[axis]);
+			const float upper = ceilf((box.max_[axis] - m_Bounds.min_[axis]) * m_QuantizeScale[axis]);
+
+			out_min[axis] = static_cast<u16>(Maths::Clamp(lower, 0.0f, 65535.0f));
+			out_max[axis] = static_cast<u16>(Maths::Clamp(upper, 0.0f, 65535.0f));
+		}
+	}
+
+	Maths::BoundingBox TriangleMeshCollisionShape::Dequantize(const BVHNode& node) const
+	{
+		const Maths::Vector3 min(node.min[0] * m_DequantizeScale.x, node.min[1] * m_DequantizeScale.y, node.min[2] * m_DequantizeScale.z);
+		const Maths::Vector3 max(node.max[0] * m_DequantizeScale.x, node.max[1] * m_DequantizeScale.y, node.max[2] * m_DequantizeScale.z);
+
+		return Maths::BoundingBox(m_Bounds.min_ + min, m_Bounds.min_ + max);
+	}
+
+	void TriangleMeshCollisionShape::QueryAABB(const Maths::BoundingBox& box, std::vector<u32>& out_triangles) const
+	{
+		if (m_Nodes.empty())
+			return;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			if (box.max_[axis] < m_Bounds.min_[axis] || box.min_[axis] > m_Bounds.max_[axis])
+				return;
+		}
+
+		u16 queryMin[3], queryMax[3];
+		Quantize(box, queryMin, queryMax);
+
+		u32 stack[MaxTreeDepth];
+		u32 stackSize = 0;
+		u32 index = 0;
+
+		for (;;)
+		{
+			const BVHNode& node = m_Nodes[index];
+
+			const bool overlap =
+				queryMin[0] <= node.max[0] && queryMax[0] >= node.min[0] &&
+				queryMin[1] <= node.max[1] && queryMax[1] >= node.min[1] &&
+				queryMin[2] <= node.max[2] && queryMax[2] >= node.min[2];
+
+			if (overlap)
+			{
+				if (node.data & LeafFlag)
+				{
+					const u32 first = node.data & LeafFirstMask;
+					const u32 count = ((node.data & ~LeafFlag) >> LeafCountShift) + 1;
+					for (u32 i = 0; i < count; ++i)
+						out_triangles.push_back(first + i);
+				}
+				else
+				{
+					stack[stackSize++] = node.data;
+					++index;
+					continue;
+				}
+			}
+
+			if (stackSize == 0)
+				break;
+
+			index = stack[--stackSize];
+		}
+	}
+
+	bool TriangleMeshCollisionShape::Raycast(const Maths::Ray& ray, float maxDistance, float* out_distance, u32* out_triangle) const
+	{
+		if (m_Nodes.empty())
+			return false;
+
+		const Maths::Vector3 invDirection(1.0f / ray.direction_.x, 1.0f / ray.direction_.y, 1.0f / ray.direction_.z);
+
+		float closest = maxDistance;
+		u32 closestTriangle = NoParent;
+
+		u32 stack[MaxTreeDepth];
+		u32 stackSize = 0;
+		u32 index = 0;
+
+		for (;;)
+		{
+			const BVHNode& node = m_Nodes[index];
+			const Maths::BoundingBox box = Dequantize(node);
+
+			float tMin = 0.0f;
+			float tMax = closest;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const float t0 = (box.min_[axis] - ray.origin_[axis]) * invDirection[axis];
+				const float t1 = (box.max_[axis] - ray.origin_[axis]) * invDirection[axis];
+				tMin = Maths::Max(tMin, Maths::Min(t0, t1));
+				tMax = Maths::Min(tMax, Maths::Max(t0, t1));
+			}
+
+			if (tMin <= tMax)
+			{
+				if (node.data & LeafFlag)
+				{
+					const u32 first = node.data & LeafFirstMask;
+					const u32 count = ((node.data & ~LeafFlag) >> LeafCountShift) + 1;
+
+					Maths::Vector3 triangle[3];
+					float t;
+					for (u32 i = first; i < first + count; ++i)
+					{
+						GetTriangle(i, triangle);
+						if (RayTriangle(ray.origin_, ray.direction_, triangle[0], triangle[1], triangle[2], &t) && t <= closest)
+						{
+							closest = t;
+							closestTriangle = i;
+						}
+					}
+				}
+				else
+				{
+					stack[stackSize++] = node.data;
+					++index;
+					continue;
+				}
+			}
+
+			if (stackSize == 0)
+				break;
+
+			index = stack[--stackSize];
+		}
+
+		if (closestTriangle == NoParent)
+			return false;
+
+		if (out_distance) *out_distance = closest;
+		if (out_triangle) *out_triangle = closestTriangle;
+
+		return true;
+	}
+
+	bool TriangleMeshCollisionShape::Raycast(const PhysicsObject3D* currentObject, const Maths::Ray& ray, float maxDistance, float* out_distance, Maths::Vector3* out_normal) const
+	{
+		const Maths::Matrix4 transform = GetMeshTransform(currentObject);
+		const Maths::Matrix4 inverse = transform.Inverse();
+
+		// Not normalised, so distances along the local ray match the world ray
+		Maths::Ray localRay;
+		localRay.origin_ = inverse * ray.origin_;
+		localRay.direction_ = inverse.ToMatrix3() * ray.direction_;
+
+		u32 triangle;
+		if (!Raycast(localRay, maxDistance, out_distance, &triangle))
+			return false;
+
+		if (out_normal)
+		{
+			Maths::Vector3 vertices[3];
+			GetTriangle(triangle, vertices);
+
+			const Maths::Vector3 a = transform * vertices[0];
+			Maths::Vector3 normal = (transform * vertices[1] - a).CrossProduct(transform * vertices[2] - a).Normalized();
+			if (normal.DotProduct(ray.direction_) > 0.0f)
+				normal = -normal;
+
+			*out_normal = normal;
+		}
+
+		return true;
+	}
+
+	Maths::Matrix4 TriangleMeshCollisionShape::GetMeshTransform(const PhysicsObject3D* currentObject) const
+	{
+		if (currentObject == nullptr)
+			return m_LocalTransform;
+
+		return currentObject->GetWorldSpaceTransform() * m_LocalTransform;
+	}
+
+	void TriangleMeshCollisionShape::GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const
+	{
+		const Maths::Matrix4 transform = GetMeshTransform(currentObject);
+
+		if (m_Nodes.empty())
+		{
+			if (out_min) *out_min = transform.Translation();
+			if (out_max) *out_max = transform.Translation();
+			return;
+		}
+
+		float minCorrelation = FLT_MAX, maxCorrelation = -FLT_MAX;
+
+		for (int i = 0; i < 8; ++i)
+		{
+			const Maths::Vector3 corner(
+				(i & 1) ? m_Bounds.max_.x : m_Bounds.min_.x,
+				(i & 2) ? m_Bounds.max_.y : m_Bounds.min_.y,
+				(i & 4) ? m_Bounds.max_.z : m_Bounds.min_.z);
+
+			const Maths::Vector3 point = transform * corner;
+			const float correlation = axis.DotProduct(point);
+
+			if (correlation < minCorrelation)
+			{
+				minCorrelation = correlation;
+				if (out_min) *out_min = point;
+			}
+
+			if (correlation > maxCorrelation)
+			{
+				maxCorrelation = correlation;
+				if (out_max) *out_max = point;
+			}
+		}
+	}
+
+	void TriangleMeshCollisionShape::GetIncidentReferencePolygon(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, std::list<Maths::Vector3>* out_face, Maths::Vector3* out_normal, std::vector<Maths::Plane>* out_adjacent_planes) const
+	{
+	}
+
+	void TriangleMeshCollisionShape::DebugDraw(const PhysicsObject3D* currentObject) const
+	{
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "lmpch.h"
+#include "CollisionShape.h"
+#include "Maths/Ray.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		struct Vertex;
+	}
+
+	//Static triangle soup for level geometry (terrain, imported levels). Triangles are one sided,
+	//bodies are pushed out along the counter clockwise face normal.
+	//Triangles are kept in a bounding volume hierarchy built with the binned surface area heuristic.
+	//Node bounds are quantized to 16 bits relative to the mesh bounds so a node is 16 bytes.
+	//Only valid on static bodies, the inverse inertia is zero.
+	class LUMOS_EXPORT TriangleMeshCollisionShape : public CollisionShape
+	{
+	public:
+		static const u32 MaxLeafTriangles = 4;
+		static const u32 MaxTreeDepth = 128;
+
+		struct BVHNode
+		{
+			u16 min[3];
+			u16 max[3];
+			u32 data;	//!< Leaves: LeafFlag | (count - 1) << LeafCountShift | first triangle. Inner nodes: right child, the left child is the next node
+		};
+
+		static const u32 LeafFlag = 0x80000000u;
+		static const u32 LeafCountShift = 28;
+		static const u32 LeafFirstMask = (1u << LeafCountShift) - 1;
+
+		TriangleMeshCollisionShape();
+		TriangleMeshCollisionShape(const std::vector<Maths::Vector3>& vertices, const std::vector<u32>& indices);
+		~TriangleMeshCollisionShape();
+
+		static Ref<TriangleMeshCollisionShape> CreateFromMesh(const Graphics::Vertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount);
+
+		//Collision Shape Functionality
+		virtual Maths::Matrix3 BuildInverseInertia(float invMass) const override { return Maths::Matrix3::ZERO; }
+		virtual float GetSize() const override { return m_Bounds.HalfSize().Length(); }
+
+		//Conservative, returns the corners of the mesh bounds
+		virtual void GetMinMaxVertexOnAxis(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, Maths::Vector3* out_min, Maths::Vector3* out_max) const override;
+
+		//Unused, manifolds are built per triangle by CollisionDetection
+		virtual void GetIncidentReferencePolygon(const PhysicsObject3D* currentObject, const Maths::Vector3& axis, std::list<Maths::Vector3>* out_face, Maths::Vector3* out_normal, std::vector<Maths::Plane>* out_adjacent_planes) const override;
+
+		virtual void DebugDraw(const PhysicsObject3D* currentObject) const override;
+
+		u32 GetNumTriangles() const { return static_cast<u32>(m_Indices.size() / 3); }
+		u32 GetNumNodes() const { return static_cast<u32>(m_Nodes.size()); }
+		const Maths::BoundingBox& GetBounds() const { return m_Bounds; }
+
+		//Mesh space vertices of a triangle. Triangle ids are in tree order, not in the order they were given.
+		void GetTriangle(u32 triangle, Maths::Vector3* out_vertices) const
+		{
+			const u32* index = &m_Indices[triangle * 3];
+			out_vertices[0] = m_Vertices[index[0]];
+			out_vertices[1] = m_Vertices[index[1]];
+			out_vertices[2] = m_Vertices[index[2]];
+		}
+
+		Maths::Matrix4 GetMeshTransform(const PhysicsObject3D* currentObject) const;
+
+		//Appends the triangles whose node bounds overlap a mesh space box
+		void QueryAABB(const Maths::BoundingBox& box, std::vector<u32>& out_triangles) const;
+
+		//Closest hit along a mesh space ray. The direction does not need to be unit length, distances are in multiples of it.
+		bool Raycast(const Maths::Ray& ray, float maxDistance, float* out_distance, u32* out_triangle) const;
+
+		//World space ray against the mesh of a body, the normal faces the ray
+		bool Raycast(const PhysicsObject3D* currentObject, const Maths::Ray& ray, float maxDistance, float* out_distance, Maths::Vector3* out_normal) const;
+
+	protected:
+		void Build(const std::vector<Maths::Vector3>& vertices, const std::vector<u32>& indices);
+
+		void Quantize(const Maths::BoundingBox& box, u16* out_min, u16* out_max) const;
+		Maths::BoundingBox Dequantize(const BVHNode& node) const;
+
+	protected:
+		std::vector<Maths::Vector3> m_Vertices;
+		std::vector<u32>			m_Indices;	//!< Three per triangle, sorted so every leaf owns a contiguous range
+		std::vector<BVHNode>		m_Nodes;	//!< Depth first, the root is node 0
+
+		Maths::BoundingBox m_Bounds;
+		Maths::Vector3	   m_QuantizeScale;
+		Maths::Vector3	   m_DequantizeScale;
+	};
+}
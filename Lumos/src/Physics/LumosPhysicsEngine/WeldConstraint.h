@@ -21,6 +21,9 @@ namespace Lumos
 		virtual void ApplyImpulse() override;
 		virtual void DebugDraw() const override;
 
+		PhysicsObject3D* GetObjectA() const override { return m_pObj1; }
+		PhysicsObject3D* GetObjectB() const override { return m_pObj2; }
+
 	protected:
 		PhysicsObject3D *m_pObj1;
 		PhysicsObject3D *m_pObj2;
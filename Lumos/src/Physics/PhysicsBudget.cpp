@@ -0,0 +1,134 @@
+#include "lmpch.h"
+#include "PhysicsBudget.h"
+#include "Maths/MathDefs.h"
+
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+	PhysicsBudget::PhysicsBudget(u32 minIterations, u32 maxIterations, u32 maxSubsteps, float budgetMs)
+		: m_MinIterations(minIterations)
+		, m_MaxIterations(maxIterations)
+		, m_MaxSubsteps(maxSubsteps)
+		, m_BudgetMs(budgetMs)
+		, m_SolverIterations(maxIterations)
+	{
+	}
+
+	u32 PhysicsBudget::BeginFrame(float& accumulator, float timestep, bool keepTime)
+	{
+		const u32 pending = timestep > 0.0f ? static_cast<u32>(accumulator / timestep) : 0;
+
+		if (keepTime)
+		{
+			m_Substeps = Maths::Min(pending, m_MaxSubsteps);
+			m_SolverIterations = m_MaxIterations;
+			accumulator -= m_Substeps * timestep;
+			return m_Substeps;
+		}
+
+		if (pending == 0)
+		{
+			m_Substeps = 0;
+			return 0;
+		}
+
+		// Steps that fit in the budget at the lowest iteration count, always at least one so the simulation keeps moving
+		u32 affordable = m_MaxSubsteps;
+		const float minStepCost = m_BaseCostMs + m_IterationCostMs * m_MinIterations;
+		if (m_HasMeasurement && minStepCost > 0.0f)
+			affordable = Maths::Clamp(static_cast<u32>(m_BudgetMs / minStepCost), 1u, m_MaxSubsteps);
+
+		m_Substeps = Maths::Min(pending, affordable);
+
+		// Whatever is left of the budget per step goes to the solver
+		m_SolverIterations = m_MaxIterations;
+		if (m_HasMeasurement && m_IterationCostMs > 0.0f)
+		{
+			const float iterations = (m_BudgetMs / m_Substeps - m_BaseCostMs) / m_IterationCostMs;
+			m_SolverIterations = static_cast<u32>(Maths::Clamp(iterations, float(m_MinIterations), float(m_MaxIterations)));
+		}
+
+		accumulator -= m_Substeps * timestep;
+
+		if (accumulator >= timestep)
+		{
+			m_DroppedSteps += static_cast<u64>(accumulator / timestep);
+			accumulator = fmodf(accumulator, timestep);
+		}
+
+		return m_Substeps;
+	}
+
+	void PhysicsBudget::RecordStep(float stepMs, float solverMs, u32 iterations)
+	{
+		const float baseCost = Maths::Max(stepMs - solverMs, 0.0f);
+		const float iterationCost = iterations > 0 ? solverMs / iterations : 0.0f;
+
+		if (!m_HasMeasurement)
+		{
+			m_BaseCostMs = baseCost;
+			m_IterationCostMs = iterationCost;
+			m_HasMeasurement = true;
+			return;
+		}
+
+		// Smoothed so one slow step doesn't swing the next frame's decisions
+		const float smoothing = 0.1f;
+		m_BaseCostMs += (baseCost - m_BaseCostMs) * smoothing;
+		m_IterationCostMs += (iterationCost - m_IterationCostMs) * smoothing;
+	}
+
+	void PhysicsBudget::OnImGui()
+	{
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Budget (ms)");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::InputFloat("##Budget", &m_BudgetMs);
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Max Substeps");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		int maxSubsteps = static_cast<int>(m_MaxSubsteps);
+		if (ImGui::InputInt("##Max Substeps", &maxSubsteps))
+			m_MaxSubsteps = static_cast<u32>(Maths::Max(maxSubsteps, 1));
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Substeps");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::Text("%u", m_Substeps);
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Solver Iterations");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::Text("%u (%u - %u)", m_SolverIterations, m_MinIterations, m_MaxIterations);
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Step Cost (ms)");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::Text("%.3f + %.4f per iteration", m_BaseCostMs, m_IterationCostMs);
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+
+		ImGui::AlignTextToFramePadding();
+		ImGui::TextUnformatted("Dropped Steps");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		ImGui::Text("%llu", static_cast<unsigned long long>(m_DroppedSteps));
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "lmpch.h"
+
+namespace Lumos
+{
+	//Picks how many fixed steps a physics engine runs each frame and how many solver iterations each step gets,
+	//from a millisecond budget and the measured cost of previous steps. When the budget can't cover all the
+	//time that has built up, iterations are lowered first, then the extra steps are dropped instead of
+	//carried over, so a slow frame can't make the next one slower.
+	class LUMOS_EXPORT PhysicsBudget
+	{
+	public:
+		PhysicsBudget(u32 minIterations, u32 maxIterations, u32 maxSubsteps = 5, float budgetMs = 5.0f);
+
+		//Returns the number of steps to run and takes their time out of the accumulator.
+		//keepTime never drops time, used by deterministic modes that must not change the result with the frame rate.
+		u32 BeginFrame(float& accumulator, float timestep, bool keepTime = false);
+
+		//Measured cost of one step, solverMs being the part spent in the solver iterations
+		void RecordStep(float stepMs, float solverMs, u32 iterations);
+
+		u32 GetSolverIterations() const { return m_SolverIterations; }
+		u32 GetMinIterations() const { return m_MinIterations; }
+		u32 GetMaxIterations() const { return m_MaxIterations; }
+
+		float GetBudget() const { return m_BudgetMs; }
+		void  SetBudget(float budgetMs) { m_BudgetMs = budgetMs; }
+
+		u32  GetMaxSubsteps() const { return m_MaxSubsteps; }
+		void SetMaxSubsteps(u32 maxSubsteps) { m_MaxSubsteps = maxSubsteps; }
+
+		//Adds rows to the calling engine's two column ImGui layout
+		void OnImGui();
+
+	protected:
+		u32	  m_MinIterations;
+		u32	  m_MaxIterations;
+		u32	  m_MaxSubsteps;
+		float m_BudgetMs;
+
+		// Smoothed cost of a step outside the solver, and of one solver iteration
+		float m_BaseCostMs = 0.0f;
+		float m_IterationCostMs = 0.0f;
+		bool  m_HasMeasurement = false;
+
+		// Decisions of the last frame, shown in ImGui
+		u32 m_SolverIterations;
+		u32 m_Substeps = 0;
+		u64 m_DroppedSteps = 0;
+	};
+}
@@ -5,6 +5,7 @@
 
 namespace Lumos
 {
+	class B2PhysicsEngine;
 
 	enum class LUMOS_EXPORT Shape
 	{
@@ -22,6 +23,8 @@ namespace Lumos
 			position = Maths::Vector3(0.0f);
 			scale = Maths::Vector3(1.0f);
 			isStatic = false;
+			world = 0;
+			engine = nullptr;
 		}
 
 		float mass;
@@ -29,6 +32,9 @@ namespace Lumos
 		Maths::Vector3 scale;
 		bool isStatic;
 		Shape shape;
+		u32 world; // 2D only, index of the B2PhysicsEngine world the body is created in
+		B2PhysicsEngine* engine; // 2D only, the scene's Scene::GetSystemManager() engine. Null falls back to the application's,
+		                         // which a simulated scene's engine asserts on when it syncs the body.
 	};
 
 	class LUMOS_EXPORT PhysicsObject : public Serialisable
@@ -43,7 +49,7 @@ namespace Lumos
 		bool GetIsAtRest()    const { return m_AtRest; }
 		float GetElasticity() const { return m_Elasticity; }
 		float GetFriction()   const { return m_Friction; }
-		void SetIsStatic(const bool isStatic)   { m_Static = isStatic; }
+		virtual void SetIsStatic(const bool isStatic)   { m_Static = isStatic; }
 
 		void SetElasticity(const float elasticity) { m_Elasticity = elasticity; }
 		void SetFriction(const float friction)   { m_Friction = friction; }
@@ -0,0 +1,84 @@
+#include "lmpch.h"
+#include "HeadlessWindow.h"
+
+namespace Lumos
+{
+	HeadlessWindow::HeadlessWindow(const WindowProperties& properties)
+	{
+		m_Init = false;
+		m_VSync = properties.VSync;
+		SetHasResized(false);
+		m_Data.m_RenderAPI = static_cast<Graphics::RenderAPI>(properties.RenderAPI);
+
+		m_Init = Init(properties);
+
+		Graphics::GraphicsContext::Create(properties, nullptr);
+	}
+
+	HeadlessWindow::~HeadlessWindow()
+	{
+	}
+
+	bool HeadlessWindow::Init(const WindowProperties& properties)
+	{
+		LUMOS_LOG_INFO("Creating headless window - Title : {0}, Width : {1}, Height : {2}", properties.Title, properties.Width, properties.Height);
+
+		m_Data.Title = properties.Title;
+		m_Data.Width = properties.Width;
+		m_Data.Height = properties.Height;
+		m_Data.VSync = properties.VSync;
+		m_Data.Exit = false;
+
+		return true;
+	}
+
+	void HeadlessWindow::ToggleVSync()
+	{
+		SetVSync(!m_VSync);
+	}
+
+	void HeadlessWindow::SetVSync(bool set)
+	{
+		m_VSync = set;
+		m_Data.VSync = set;
+	}
+
+	void HeadlessWindow::SetWindowTitle(const String& title)
+	{
+		m_Data.Title = title;
+	}
+
+	void HeadlessWindow::SetBorderlessWindow(bool borderless)
+	{
+	}
+
+	void HeadlessWindow::OnUpdate()
+	{
+	}
+
+	void HeadlessWindow::HideMouse(bool hide)
+	{
+	}
+
+	void HeadlessWindow::SetMousePosition(const Maths::Vector2& pos)
+	{
+	}
+
+	void HeadlessWindow::UpdateCursorImGui()
+	{
+	}
+
+	void HeadlessWindow::SetIcon(const String& file, const String& smallIconFilePath)
+	{
+	}
+
+	void HeadlessWindow::MakeDefault()
+	{
+		CreateFunc = CreateFuncHeadless;
+	}
+
+	Window* HeadlessWindow::CreateFuncHeadless(const WindowProperties& properties)
+	{
+		return lmnew HeadlessWindow(properties);
+	}
+}
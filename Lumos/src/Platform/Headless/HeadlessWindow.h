@@ -1,6 +1,7 @@
 #pragma once
 #include "lmpch.h"
 #include "Core/OS/Window.h"
+#include "Graphics/API/GraphicsContext.h"
 
 namespace Lumos
 {
@@ -37,7 +38,7 @@ namespace Lumos
 
     protected:
 
-		static Window* CreateFuncGLFW(const WindowProperties& properties);
+		static Window* CreateFuncHeadless(const WindowProperties& properties);
 
 		struct WindowData
 		{
@@ -0,0 +1,84 @@
+#include "lmpch.h"
+#include "RenderAPINone.h"
+#include "HeadlessWindow.h"
+
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NoneContext::NoneContext(const WindowProperties& properties, void* deviceContext)
+		{
+		}
+
+		NoneContext::~NoneContext()
+		{
+		}
+
+		void NoneContext::OnImGui()
+		{
+			ImGui::TextUnformatted("No render API");
+		}
+
+		void NoneContext::MakeDefault()
+		{
+			CreateFunc = CreateFuncNone;
+		}
+
+		GraphicsContext* NoneContext::CreateFuncNone(const WindowProperties& properties, void* cont)
+		{
+			return lmnew NoneContext(properties, cont);
+		}
+
+		NoneCommandBuffer::NoneCommandBuffer()
+		{
+		}
+
+		NoneCommandBuffer::~NoneCommandBuffer()
+		{
+		}
+
+		bool NoneCommandBuffer::Init(bool primary)
+		{
+			return true;
+		}
+
+		void NoneCommandBuffer::Unload()
+		{
+		}
+
+		void NoneCommandBuffer::BeginRecording()
+		{
+		}
+
+		void NoneCommandBuffer::BeginRecordingSecondary(RenderPass* renderPass, Framebuffer* framebuffer)
+		{
+		}
+
+		void NoneCommandBuffer::EndRecording()
+		{
+		}
+
+		void NoneCommandBuffer::ExecuteSecondary(CommandBuffer* primaryCmdBuffer)
+		{
+		}
+
+		void NoneCommandBuffer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNone;
+		}
+
+		CommandBuffer* NoneCommandBuffer::CreateFuncNone()
+		{
+			return lmnew NoneCommandBuffer();
+		}
+
+		void None::MakeDefault()
+		{
+			NoneContext::MakeDefault();
+			NoneCommandBuffer::MakeDefault();
+			HeadlessWindow::MakeDefault();
+		}
+	}
+}
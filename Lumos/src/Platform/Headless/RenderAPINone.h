@@ -1,10 +1,32 @@
+#pragma once
 #include "lmpch.h"
+#include "Graphics/API/GraphicsContext.h"
 #include "Graphics/API/CommandBuffer.h"
 
 namespace Lumos
 {
 	namespace Graphics
 	{
+		//Context for RenderAPI::NONE, there is no device to set up or present to
+		class LUMOS_EXPORT NoneContext : public GraphicsContext
+		{
+		public:
+			NoneContext(const WindowProperties& properties, void* deviceContext);
+			~NoneContext();
+
+			void Init() override {};
+			void Present() override {};
+
+			size_t GetMinUniformBufferOffsetAlignment() const override { return 1; }
+
+			bool FlipImGUITexture() const override { return false; }
+
+			void OnImGui() override;
+			static void MakeDefault();
+		protected:
+			static GraphicsContext* CreateFuncNone(const WindowProperties& properties, void* cont);
+		};
+
 		class NoneCommandBuffer : public CommandBuffer
 		{
 		public:
@@ -22,7 +44,13 @@ namespace Lumos
 			void UpdateViewport(u32 width, u32 height) override {};
             static void MakeDefault();
         protected:
-            static CommandBuffer* CreateFuncGL();
+            static CommandBuffer* CreateFuncNone();
 		};
+
+		//Nothing can be drawn without a device, so this also replaces the platform window with a HeadlessWindow
+		namespace None
+		{
+			void MakeDefault();
+		}
 	}
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
 
 namespace Lumos
 {
@@ -116,4 +117,35 @@ namespace Lumos
         fclose(file);
         return size > 0;
     }
+
+    const u8* FileSystem::MapFile(const String& path, i64& out_size)
+    {
+        out_size = 0;
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return nullptr;
+
+        struct stat buffer;
+        if (fstat(file, &buffer) != 0 || buffer.st_size == 0)
+        {
+            close(file);
+            return nullptr;
+        }
+
+        void* data = mmap(nullptr, buffer.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        // The mapping keeps the file alive
+        close(file);
+
+        if (data == MAP_FAILED)
+            return nullptr;
+
+        out_size = buffer.st_size;
+        return static_cast<const u8*>(data);
+    }
+
+    void FileSystem::UnmapFile(const u8* data, i64 size)
+    {
+        if (data)
+            munmap(const_cast<u8*>(data), size);
+    }
 }
@@ -112,6 +112,35 @@ namespace Lumos
 	{
 		return WriteFile(path, (u8*)&text[0]);
 	}
+
+	const u8* FileSystem::MapFile(const String& path, i64& out_size)
+	{
+		out_size = 0;
+		const HANDLE file = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		const i64 size = GetFileSizeInternal(file);
+		const HANDLE mapping = size > 0 ? CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : NULL;
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+		// The view keeps the mapping and the file alive
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+
+		if (!data)
+			return nullptr;
+
+		out_size = size;
+		return static_cast<const u8*>(data);
+	}
+
+	void FileSystem::UnmapFile(const u8* data, i64 size)
+	{
+		if (data)
+			UnmapViewOfFile(data);
+	}
 }
 
 #endif
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "Maths/Transform.h"
 #include "Core/OS/Window.h"
 #include "Core/VFS.h"
+#include "App/Application.h"
+#include "Physics/LumosPhysicsEngine/LumosPhysicsEngine.h"
 
 #include <imgui/imgui.h>
 #include <sol/sol.hpp>
@@ -22,6 +24,7 @@ namespace Lumos
 		BindMathsLua(m_State);
 		BindImGuiLua(m_State);
 		BindECSLua(m_State);
+		BindPhysicsLua(m_State);
 	}
 
 	void LuaManager::TestLua()
@@ -212,6 +215,61 @@ namespace Lumos
     }
 
 
+    void LuaManager::BindPhysicsLua(sol::state* state)
+    {
+        state->new_usertype<Maths::Ray>("Ray",
+            sol::constructors<Maths::Ray(), Maths::Ray(const Maths::Vector3&, const Maths::Vector3&)>(),
+            "origin", &Maths::Ray::origin_,
+            "direction", &Maths::Ray::direction_
+            );
+
+        state->new_usertype<PhysicsObject3D>("PhysicsObject3D",
+            "GetPosition", &PhysicsObject3D::GetPosition,
+            "SetPosition", &PhysicsObject3D::SetPosition,
+            "GetLinearVelocity", &PhysicsObject3D::GetLinearVelocity,
+            "SetLinearVelocity", &PhysicsObject3D::SetLinearVelocity,
+            "GetIsStatic", &PhysicsObject3D::GetIsStatic,
+            "WakeUp", &PhysicsObject3D::WakeUp
+            );
+
+        state->new_usertype<RaycastHit>("RaycastHit",
+            "body", &RaycastHit::body,
+            "point", &RaycastHit::point,
+            "normal", &RaycastHit::normal,
+            "distance", &RaycastHit::distance
+            );
+
+        // Scene queries against the 3D physics world, misses return nil / empty tables
+        state->set_function("Raycast", [](const Maths::Vector3& origin, const Maths::Vector3& direction, float maxDistance) -> sol::optional<RaycastHit>
+        {
+            RaycastHit hit;
+            if (Application::Instance()->GetSystem<LumosPhysicsEngine>()->Raycast(Maths::Ray(origin, direction), maxDistance, &hit))
+                return hit;
+            return sol::nullopt;
+        });
+
+        state->set_function("RaycastBatch", [](std::vector<Maths::Ray> rays, float maxDistance)
+        {
+            std::vector<RaycastHit> hits;
+            Application::Instance()->GetSystem<LumosPhysicsEngine>()->RaycastBatch(rays, maxDistance, hits);
+            return sol::as_table(std::move(hits));
+        });
+
+        state->set_function("OverlapSphere", [](const Maths::Vector3& centre, float radius)
+        {
+            std::vector<PhysicsObject3D*> objects;
+            Application::Instance()->GetSystem<LumosPhysicsEngine>()->OverlapSphere(centre, radius, objects);
+            return sol::as_table(std::move(objects));
+        });
+
+        state->set_function("OverlapAABB", [](const Maths::Vector3& min, const Maths::Vector3& max)
+        {
+            std::vector<PhysicsObject3D*> objects;
+            Application::Instance()->GetSystem<LumosPhysicsEngine>()->OverlapAABB(Maths::BoundingBox(min, max), objects);
+            return sol::as_table(std::move(objects));
+        });
+    }
+
     void LuaManager::BindImGuiLua(sol::state* solState)
     {
     #if 0
@@ -25,6 +25,7 @@ namespace Lumos
         void BindImGuiLua(sol::state* solState);
         void BindECSLua(sol::state* state);
         void BindMathsLua(sol::state* state);
+        void BindPhysicsLua(sol::state* state);
 
 		sol::state* GetState() const { return m_State; }
 
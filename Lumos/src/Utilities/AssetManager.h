@@ -23,6 +23,9 @@ namespace Lumos
         
         bool Exists(const String& name) const;
 
+		//Name the asset was added with, empty if it isn't in this manager
+		String GetName(const T* asset) const;
+
 		_ALWAYS_INLINE_ void Clear()
 		{
 			m_Assets.clear();
@@ -59,6 +62,18 @@ namespace Lumos
         return s != m_Assets.end();
     }
 
+	template <class T>
+	String AssetManager<T>::GetName(const T* asset) const
+	{
+		for (auto& entry : m_Assets)
+		{
+			if (entry.second.get() == asset)
+				return entry.first;
+		}
+
+		return String();
+	}
+
 	template<>
 	_FORCE_INLINE_ void LUMOS_EXPORT AssetManager<Sound>::LoadAsset(const String& name, const String& filePath)
 	{
@@ -18,6 +18,21 @@ namespace Lumos
             m_Elapsed += m_Timestep;
         }
 
+        //Advances by a set amount rather than from a clock, for fixed rate updates
+        _FORCE_INLINE_ void Step(float timeStep)
+        {
+            m_Timestep = timeStep;
+            m_LastTime += timeStep;
+            m_Elapsed += timeStep;
+        }
+
+        //Replaces the length of the last step, e.g. with a recorded one. The clock is kept, so Update carries on from it
+        _FORCE_INLINE_ void SetStep(float timeStep)
+        {
+            m_Elapsed += timeStep - m_Timestep;
+            m_Timestep = timeStep;
+        }
+
         _FORCE_INLINE_ float GetMillis() const { return m_Timestep; }
         _FORCE_INLINE_ float GetElapsedMillis() const { return m_Elapsed; }
 
@@ -10,9 +10,9 @@ GraphicsScene::~GraphicsScene() = default;
 void GraphicsScene::OnInit()
 {
 	Scene::OnInit();
-	Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetDampingFactor(0.998f);
-	Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetIntegrationType(IntegrationType::RUNGE_KUTTA_4);
-	Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetBroadphase(Lumos::CreateRef<Octree>(5, 3, Lumos::CreateRef<SortAndSweepBroadphase>()));
+	GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetDampingFactor(0.998f);
+	GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetIntegrationType(IntegrationType::RUNGE_KUTTA_4);
+	GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetBroadphase(Lumos::CreateRef<Octree>(5, 3, Lumos::CreateRef<SortAndSweepBroadphase>()));
 
 	LoadModels();
 
@@ -17,9 +17,9 @@ void MaterialTest::OnInit()
 {
 	Scene::OnInit();
 
-	Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetDampingFactor(0.998f);
-	Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetIntegrationType(IntegrationType::RUNGE_KUTTA_4);
-	Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetBroadphase(Lumos::CreateRef<Octree>(5, 3, Lumos::CreateRef<SortAndSweepBroadphase>()));
+	GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetDampingFactor(0.998f);
+	GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetIntegrationType(IntegrationType::RUNGE_KUTTA_4);
+	GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetBroadphase(Lumos::CreateRef<Octree>(5, 3, Lumos::CreateRef<SortAndSweepBroadphase>()));
 
 	LoadModels();
 
@@ -88,7 +88,7 @@ void MaterialTest::OnCleanupScene()
 	{
 		SAFE_DELETE(m_pCamera)
 			SAFE_DELETE(m_EnvironmentMap);
-		Application::Instance()->GetSystem<LumosPhysicsEngine>()->ClearConstraints();
+		GetSystemManager()->GetSystem<LumosPhysicsEngine>()->ClearConstraints();
 	}
 
 	Scene::OnCleanupScene();
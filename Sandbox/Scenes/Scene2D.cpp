@@ -54,7 +54,7 @@ void Scene2D::OnInit()
 {
 	Scene::OnInit();
 
-	Application::Instance()->GetSystem<LumosPhysicsEngine>()->SetPaused(true);
+	GetSystemManager()->GetSystem<LumosPhysicsEngine>()->SetPaused(true);
 
 	m_pCamera = new Camera2D(static_cast<float>(m_ScreenWidth) / static_cast<float>(m_ScreenHeight), MAX_HEIGHT);
 
@@ -86,6 +86,7 @@ void Scene2D::OnInit()
 	params.scale = Vector3(1.0f / 2.0f, 1.0f / 2.0f, 1.0f);
 	params.shape = Shape::Square;
 	params.isStatic = false;
+	params.engine = GetSystemManager()->GetSystem<B2PhysicsEngine>();
 	auto blockPhysics = Lumos::CreateRef<PhysicsObject2D>();
 	blockPhysics->Init(params);
 	blockPhysics->GetB2Body()->SetLinearVelocity({SPEED, 0.0f});
@@ -94,7 +95,7 @@ void Scene2D::OnInit()
 	m_Registry.assign<Physics2DComponent>(s_player.entity, blockPhysics);
 	m_Registry.assign<Maths::Transform>(s_player.entity, Maths::Vector3(1.0f, 1.0f,0.0f));
 
-	Application::Instance()->GetSystem<B2PhysicsEngine>()->GetB2World()->SetContactListener(&myContactListenerInstance);
+	GetSystemManager()->GetSystem<B2PhysicsEngine>()->GetB2World()->SetContactListener(&myContactListenerInstance);
 
 	m_Pillars.resize(10);
 	for (int i = 0; i < 10; i +=2)
@@ -210,6 +211,7 @@ void Scene2D::LoadSprites()
 		params.scale = Vector3(size / 2.0f, 1.0f);
 		params.shape = Shape::Square;
 		params.isStatic = false;
+		params.engine = GetSystemManager()->GetSystem<B2PhysicsEngine>();
         auto blockPhysics = Lumos::CreateRef<PhysicsObject2D>();
 		blockPhysics->Init(params);
 
@@ -224,6 +226,7 @@ void Scene2D::LoadSprites()
 	groundParams.scale = Vector3(25.0f, 5.0f, 1.0f);
 	groundParams.shape = Shape::Square;
 	groundParams.isStatic = true;
+	groundParams.engine = GetSystemManager()->GetSystem<B2PhysicsEngine>();
 	Lumos::Ref<PhysicsObject2D> groundPhysics = Lumos::CreateRef<PhysicsObject2D>();
 	groundPhysics->Init(groundParams);
     
@@ -288,6 +291,7 @@ void Scene2D::CreatePillar(int index, float offset)
 	params.scale = scale;
 	params.shape = Shape::Square;
 	params.isStatic = true;
+	params.engine = GetSystemManager()->GetSystem<B2PhysicsEngine>();
 	auto blockPhysics = Lumos::CreateRef<PhysicsObject2D>();
 	blockPhysics->Init(params);
 	blockPhysics->GetB2Body()->SetLinearVelocity({ 1.0f, 0.0f });
@@ -308,6 +312,7 @@ void Scene2D::CreatePillar(int index, float offset)
 	params.scale = scale;
 	params.shape = Shape::Square;
 	params.isStatic = true;
+	params.engine = GetSystemManager()->GetSystem<B2PhysicsEngine>();
 	blockPhysics = Lumos::CreateRef<PhysicsObject2D>();
 	blockPhysics->Init(params);
 	blockPhysics->GetB2Body()->SetLinearVelocity({ 1.0f, 0.0f });
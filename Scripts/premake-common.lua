@@ -96,4 +96,197 @@
 --		["SDKROOT"] = "macosx";	
 --	}
 --	end
---end	
\ No newline at end of file
+--end	
+
+
+-- Console app linking Lumos without Sandbox's scenes or assets, e.g. Benchmarks and HeadlessHost.
+-- Call from the project's own premake5.lua, paths are relative to it.
+function LumosConsoleApp(name)
+	project(name)
+		kind "ConsoleApp"
+		language "C++"
+
+		files
+		{
+			"**.h",
+			"**.cpp"
+		}
+
+		sysincludedirs
+		{
+			"../Lumos/external/spdlog/include",
+			"../Lumos/external/",
+			"../Lumos/external/stb/",
+			"../Dependencies/lua/src/",
+			"../Dependencies/glfw/include/",
+			"../Lumos/external/glad/include/",
+			"../Dependencies/OpenAL/include/",
+			"../Dependencies/stb/",
+			"../Dependencies/Box2D/",
+			"../Dependencies/vulkan/",
+			"../Dependencies/",
+			"../Lumos/external/",
+			"../Lumos/external/jsonhpp/",
+			"../Lumos/external/spdlog/include",
+	        "../Lumos/src"
+		}
+
+		links
+		{
+			"Lumos",
+			"lua",
+			"Box2D",
+			"imgui"
+		}
+
+		cwd = os.getcwd() .. "/.."
+
+		defines
+		{
+			--"LUMOS_DYNAMIC",
+	        "LUMOS_ROOT_DIR="  .. cwd
+		}
+
+		filter "system:windows"
+			cppdialect "C++17"
+			staticruntime "On"
+			systemversion "latest"
+
+			defines
+			{
+				"LUMOS_PLATFORM_WINDOWS",
+				"LUMOS_RENDER_API_OPENGL",
+				"LUMOS_RENDER_API_VULKAN",
+				"VK_USE_PLATFORM_WIN32_KHR",
+				"WIN32_LEAN_AND_MEAN",
+				"_CRT_SECURE_NO_WARNINGS",
+				"_DISABLE_EXTENDED_ALIGNED_STORAGE"
+			}
+
+			buildoptions
+			{
+				"/MP"
+			}
+
+			links
+			{
+				"glfw",
+			}
+
+		filter "system:macosx"
+			cppdialect "C++17"
+			staticruntime "On"
+			systemversion "latest"
+
+			defines
+			{
+				"LUMOS_PLATFORM_MACOS",
+				"LUMOS_PLATFORM_UNIX",
+				"LUMOS_RENDER_API_OPENGL",
+				"LUMOS_RENDER_API_VULKAN",
+				"VK_USE_PLATFORM_MACOS_MVK",
+				"LUMOS_IMGUI"
+			}
+
+			linkoptions 
+			{ 
+				"-framework OpenGL",
+				"-framework Cocoa",
+				"-framework IOKit", 
+				"-framework CoreVideo",
+				"-framework OpenAL",
+				"-framework QuartzCore"
+			}
+
+			links
+			{
+				"glfw"	
+			}
+
+			filter {"system:macosx", "configurations:release"}
+
+				local source = "../Dependencies/vulkan/libs/macOS/**"
+				local target = "../bin/release/"
+			
+				buildmessage("copying "..source.." -> "..target)
+			
+				postbuildcommands {
+					"{COPY} "..source.." "..target
+				}
+
+			filter {"system:macosx", "configurations:Production"}
+
+				local source = "../Dependencies/vulkan/libs/macOS/**"
+				local target = "../bin/dist/"
+			
+				buildmessage("copying "..source.." -> "..target)
+			
+				postbuildcommands {
+					"{COPY} "..source.." "..target
+				}
+
+			filter {"system:macosx", "configurations:debug"}
+
+				local source = "../Dependencies/vulkan/libs/macOS/**"
+				local target = "../bin/debug/"
+			
+				buildmessage("copying "..source.." -> "..target)
+			
+				postbuildcommands {
+					"{COPY} "..source.." "..target
+				}
+
+		filter "system:linux"
+			cppdialect "C++17"
+			staticruntime "On"
+			systemversion "latest"
+
+			defines
+			{
+				"LUMOS_PLATFORM_LINUX",
+				"LUMOS_PLATFORM_UNIX",
+				"LUMOS_RENDER_API_OPENGL",
+				"LUMOS_RENDER_API_VULKAN",
+				"VK_USE_PLATFORM_XCB_KHR",
+				"LUMOS_IMGUI"
+			}
+
+			buildoptions
+			{
+				"-msse4.1",
+				"-fpermissive",
+				"-Wattributes",
+				"-fPIC",
+				"-Wignored-attributes"
+			}
+
+			links
+			{
+				"glfw"
+			}
+
+			links { "X11", "pthread"}
+
+			linkoptions
+			{
+				"-L%{cfg.targetdir}"
+			}
+
+			linkoptions{ "-Wl,-rpath=\\$$ORIGIN" }
+
+		filter "configurations:Debug"
+			defines "LUMOS_DEBUG"
+			symbols "On"
+			runtime "Debug"
+
+		filter "configurations:Release"
+			defines "LUMOS_RELEASE"
+			optimize "On"
+			symbols "On"
+			runtime "Release"
+
+		filter "configurations:Production"
+			defines "LUMOS_DIST"
+			optimize "On"
+			runtime "Release"
+end
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "ECS/DirtySet.h"
+
+TEST_CASE("Component dirty sets", "[Lumos::DirtySet]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	entt::registry registry;
+
+	std::vector<entt::entity> entities(100);
+	registry.create(entities.begin(), entities.end());
+	for (auto entity : entities)
+		registry.assign<Transform>(entity);
+
+	// Components added before the set connected aren't changes
+	DirtySet<Transform> renderer(registry);
+	DirtySet<Transform> physics(registry);
+	REQUIRE(renderer.Empty());
+	REQUIRE(HasChangeListeners<Transform>(registry));
+	REQUIRE_FALSE(HasChangeListeners<NameComponent>(registry));
+
+	registry.replace<Transform>(entities[3], Vector3(1.0f, 0.0f, 0.0f));
+	registry.get<Transform>(entities[5]).SetLocalPosition(Vector3(2.0f, 0.0f, 0.0f));
+	MarkChanged<Transform>(registry, entities[5]);
+	MarkChanged<Transform>(registry, entities[5]);
+
+	auto created = registry.create();
+	registry.assign<Transform>(created);
+	registry.assign<NameComponent>(created, "Untracked");
+	REQUIRE(renderer.Size() == 3);
+
+	// Removed components drop out, marking an entity without one does nothing
+	registry.remove<Transform>(created);
+	MarkChanged<Transform>(registry, created);
+	REQUIRE(renderer.Size() == 2);
+
+	std::vector<entt::entity> visited;
+	renderer.Consume([&](entt::entity entity, Transform& transform)
+	{
+		visited.push_back(entity);
+
+		// Changes reported while consuming are seen next time
+		if (entity == entities[3])
+			MarkChanged<Transform>(registry, entities[7]);
+	});
+
+	std::sort(visited.begin(), visited.end());
+	REQUIRE(visited == std::vector<entt::entity>{ entities[3], entities[5] });
+	REQUIRE(renderer.Size() == 1);
+	REQUIRE(renderer.Contains(entities[7]));
+
+	// Each set has its own changes
+	REQUIRE(physics.Size() == 3);
+	REQUIRE(physics.Contains(entities[7]));
+
+	// Entities destroyed since the change aren't visited, even if their index is reused
+	registry.destroy(entities[7]);
+	registry.destroy(entities[3]);
+	auto reused = registry.create();
+	registry.assign<NameComponent>(reused, "Reused");
+
+	u32 count = 0;
+	physics.Consume([&](entt::entity entity, Transform& transform) { count++; });
+	REQUIRE(count == 1);
+	REQUIRE(physics.Empty());
+	REQUIRE(renderer.Empty());
+
+	// The signals stay connected until the last set disconnects
+	renderer.Disconnect();
+	registry.replace<Transform>(entities[9]);
+	REQUIRE(physics.Contains(entities[9]));
+
+	physics.Disconnect();
+	REQUIRE_FALSE(HasChangeListeners<Transform>(registry));
+	registry.replace<Transform>(entities[10]);
+	REQUIRE(physics.Empty());
+}
@@ -0,0 +1,100 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "App/InputRecorder.h"
+#include "Events/ApplicationEvent.h"
+
+TEST_CASE("Input recording and replay", "[Lumos::InputRecorder]")
+{
+	using namespace Lumos;
+
+	if (!Input::GetInput())
+		Input::Create();
+
+	const String path = "InputRecording.lir";
+	const float steps[] = { 0.016f, 0.033f, 0.008f };
+
+	InputRecorder recorder;
+	REQUIRE(recorder.StartRecording(path));
+
+	// Events before the first frame starts aren't recorded
+	KeyPressedEvent early(10, 0);
+	REQUIRE(recorder.OnEvent(early));
+
+	TimeStep timeStep(0.0f);
+	float now = 0.0f;
+	for (int frame = 0; frame < 3; frame++)
+	{
+		now += steps[frame];
+		timeStep.Update(now);
+		recorder.BeginFrame(timeStep);
+
+		if (frame == 0)
+		{
+			KeyPressedEvent pressed(65, 2);
+			MouseMovedEvent moved(12.5f, -3.25f);
+			recorder.OnEvent(pressed);
+			recorder.OnEvent(moved);
+		}
+		else if (frame == 2)
+		{
+			// Resizes follow the real window, they aren't recorded
+			WindowResizeEvent resize(800, 600);
+			MouseButtonReleasedEvent released(1);
+			WindowCloseEvent close;
+			recorder.OnEvent(resize);
+			recorder.OnEvent(released);
+			recorder.OnEvent(close);
+		}
+	}
+
+	REQUIRE(recorder.GetFrameCount() == 3);
+	REQUIRE(recorder.StopRecording());
+	REQUIRE_FALSE(recorder.IsRecording());
+
+	InputRecorder replay;
+	REQUIRE(replay.StartReplay(path));
+	REQUIRE(replay.GetFrameCount() == 3);
+
+	std::vector<std::vector<String>> replayed(3);
+	TimeStep replayStep(0.0f);
+	for (int frame = 0; frame < 3; frame++)
+	{
+		// A slower clock doesn't change the replayed steps
+		replayStep.Update(float(frame + 1));
+		replay.BeginFrame(replayStep);
+		REQUIRE(replayStep.GetMillis() == Approx(steps[frame]));
+
+		// Live input is dropped, other window events pass
+		MouseMovedEvent live(0.0f, 0.0f);
+		WindowResizeEvent resize(640, 480);
+		REQUIRE_FALSE(replay.OnEvent(live));
+		REQUIRE(replay.OnEvent(resize));
+
+		replay.EndFrame([&](Event& e)
+		{
+			REQUIRE(replay.OnEvent(e));
+			replayed[frame].push_back(e.ToString());
+		});
+	}
+
+	REQUIRE(replayed[0] == std::vector<String>{ KeyPressedEvent(65, 2).ToString(), MouseMovedEvent(12.5f, -3.25f).ToString() });
+	REQUIRE(replayed[1].empty());
+	REQUIRE(replayed[2] == std::vector<String>{ MouseButtonReleasedEvent(1).ToString(), WindowCloseEvent().ToString() });
+
+	// The replay ends after its last frame and live input comes back
+	REQUIRE_FALSE(replay.IsReplaying());
+	REQUIRE(replay.GetReplayedFrameCount() == 3);
+	MouseMovedEvent live(0.0f, 0.0f);
+	REQUIRE(replay.OnEvent(live));
+
+	// Anything else isn't a recording
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << "Not a recording";
+	}
+	REQUIRE_FALSE(replay.StartReplay(path));
+	REQUIRE_FALSE(replay.IsReplaying());
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,114 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "App/LevelStreamer.h"
+#include "App/SceneGraph.h"
+#include "Physics/LumosPhysicsEngine/CuboidCollisionShape.h"
+
+namespace
+{
+	// A row of bodies from x to x + 10, each parented to the first
+	void SaveChunk(const String& path, float x, int bodyCount)
+	{
+		using namespace Lumos;
+		using namespace Maths;
+
+		entt::registry registry;
+		SceneGraph sceneGraph;
+		sceneGraph.Init(registry);
+
+		Ref<CollisionShape> shape = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+		auto root = registry.create();
+		registry.assign<Transform>(root, Vector3(x, 0.0f, 0.0f));
+
+		for (int i = 0; i < bodyCount; i++)
+		{
+			auto entity = registry.create();
+			registry.assign<Transform>(entity);
+			registry.assign<Hierarchy>(entity, root);
+
+			auto body = CreateRef<PhysicsObject3D>();
+			body->SetCollisionShape(shape);
+			body->SetPosition(Vector3(x + 10.0f * i / bodyCount, 0.0f, 0.0f));
+			registry.assign<Physics3DComponent>(entity, body);
+		}
+
+		SceneBinarySerialiser::Save(registry, path);
+	}
+
+	void UpdateUntilStreamed(Lumos::LevelStreamer& streamer, entt::registry& registry, const Lumos::Maths::Vector3& camera, int& out_updates, float& out_longestMs)
+	{
+		out_updates = 0;
+		out_longestMs = 0.0f;
+		do
+		{
+			Lumos::Timer timer;
+			streamer.Update(registry, camera);
+			out_longestMs = Lumos::Maths::Max(out_longestMs, timer.GetMS(1000.0f));
+
+			Lumos::System::JobSystem::Wait();
+			out_updates++;
+		} while (streamer.IsStreaming() && out_updates < 100000);
+	}
+}
+
+TEST_CASE("Level streaming", "[Lumos::LevelStreamer]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+	using ChunkState = LevelStreamer::ChunkState;
+
+	if (!VFS::Get())
+		VFS::OnInit();
+
+	const int bodyCount = 2000;
+	const String paths[] = { "LevelChunk0.lsb", "LevelChunk1.lsb", "LevelChunk2.lsb" };
+	for (int i = 0; i < 3; i++)
+		SaveChunk(paths[i], 100.0f * i, bodyCount);
+
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	LevelStreamer streamer;
+	streamer.SetDistances(50.0f, 60.0f);
+	for (int i = 0; i < 3; i++)
+		streamer.AddChunk(paths[i], BoundingBox(Vector3(100.0f * i, -1.0f, -1.0f), Vector3(100.0f * i + 10.0f, 1.0f, 1.0f)));
+	streamer.AddChunk("Missing.lsb", BoundingBox(Vector3(-10.0f), Vector3(0.0f)));
+
+	// Only the chunks in range load, a missing file is skipped
+	int updates;
+	float longestMs;
+	UpdateUntilStreamed(streamer, registry, Vector3(0.0f), updates, longestMs);
+	REQUIRE(streamer.GetChunkState(0) == ChunkState::Loaded);
+	REQUIRE(streamer.GetChunkState(1) == ChunkState::Unloaded);
+	REQUIRE(streamer.GetChunkState(3) == ChunkState::Unloaded);
+	REQUIRE(registry.alive() == bodyCount + 1);
+	REQUIRE(registry.size<Physics3DComponent>() == bodyCount);
+	REQUIRE((registry.get<Hierarchy>(streamer.GetChunkEntities(0)[0]).first() != entt::null));
+
+	// A small budget spreads the work over many updates, each overrunning by at most a batch of records
+	streamer.SetFrameBudget(0.1f);
+	UpdateUntilStreamed(streamer, registry, Vector3(100.0f, 0.0f, 0.0f), updates, longestMs);
+	REQUIRE(updates > 10);
+	REQUIRE(longestMs < 10.0f);
+	REQUIRE(streamer.GetChunkState(0) == ChunkState::Unloaded);
+	REQUIRE(streamer.GetChunkState(1) == ChunkState::Loaded);
+	REQUIRE(registry.alive() == bodyCount + 1);
+
+	// Chunks between the load and unload distance stay as they are
+	streamer.SetFrameBudget(2.0f);
+	UpdateUntilStreamed(streamer, registry, Vector3(155.0f, 0.0f, 0.0f), updates, longestMs);
+	REQUIRE(streamer.GetChunkState(1) == ChunkState::Loaded);
+	REQUIRE(streamer.GetChunkState(2) == ChunkState::Loaded);
+	REQUIRE(registry.alive() == 2 * (bodyCount + 1));
+
+	for (u32 i = 0; i < registry.size<Physics3DComponent>(); i++)
+		REQUIRE(registry.raw<Physics3DComponent>()[i].GetPhysicsObject()->GetPosition().x >= 100.0f);
+
+	streamer.Clear(registry);
+	REQUIRE(registry.alive() == 0);
+
+	for (auto& path : paths)
+		std::remove(path.c_str());
+}
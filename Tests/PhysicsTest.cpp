@@ -0,0 +1,686 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "Physics/LumosPhysicsEngine/CollisionDetection.h"
+#include "Physics/LumosPhysicsEngine/CapsuleCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/Octree.h"
+#include "Physics/LumosPhysicsEngine/BruteForceBroadphase.h"
+#include "Physics/LumosPhysicsEngine/HullCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/TriangleMeshCollisionShape.h"
+#include "Physics/PhysicsBudget.h"
+
+#include <random>
+
+namespace
+{
+	using namespace Lumos;
+
+	Ref<PhysicsObject3D> CreateBody(const Ref<CollisionShape>& shape, const Maths::Vector3& position, const Maths::Quaternion& orientation)
+	{
+		auto body = CreateRef<PhysicsObject3D>();
+		body->SetCollisionShape(shape);
+		body->SetPosition(position);
+		body->SetOrientation(orientation);
+		return body;
+	}
+
+	Maths::Quaternion RandomOrientation(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+		return Maths::Quaternion(angle(rng), angle(rng), angle(rng));
+	}
+
+	void AddBody(entt::registry& registry, Ref<PhysicsObject3D>& body)
+	{
+		auto entity = registry.create();
+		registry.assign<Maths::Transform>(entity);
+		registry.assign<Physics3DComponent>(entity, body);
+	}
+
+	//Static floor with a few tumbling boxes falling onto it
+	std::vector<Ref<PhysicsObject3D>> CreateBoxPile(entt::registry& registry)
+	{
+		std::vector<Ref<PhysicsObject3D>> bodies;
+
+		auto floor = CreateBody(CreateRef<CuboidCollisionShape>(Maths::Vector3(10.0f, 0.5f, 10.0f)), Maths::Vector3(0.0f, -0.5f, 0.0f), Maths::Quaternion());
+		floor->SetIsStatic(true);
+		bodies.push_back(floor);
+
+		std::mt19937 rng(7);
+		auto cube = CreateRef<CuboidCollisionShape>(Maths::Vector3(0.5f));
+		for (int i = 0; i < 8; ++i)
+		{
+			auto box = CreateBody(cube, Maths::Vector3(float(i % 2) * 0.6f, 1.0f + float(i) * 1.1f, float(i % 3) * 0.4f), RandomOrientation(rng));
+			box->SetInverseMass(1.0f);
+			box->SetInverseInertia(cube->BuildInverseInertia(1.0f));
+			bodies.push_back(box);
+		}
+
+		for (auto& body : bodies)
+			AddBody(registry, body);
+
+		return bodies;
+	}
+}
+
+TEST_CASE("GJK/EPA matches SAT for cuboids", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> offset(-1.5f, 1.5f);
+	std::uniform_real_distribution<float> extent(0.25f, 1.0f);
+
+	auto collisionDetection = CollisionDetection::Instance();
+
+	int colliding = 0;
+	int shallow = 0;
+	for (int i = 0; i < 500; ++i)
+	{
+		auto shapeA = CreateRef<CuboidCollisionShape>(Vector3(extent(rng), extent(rng), extent(rng)));
+		auto shapeB = CreateRef<CuboidCollisionShape>(Vector3(extent(rng), extent(rng), extent(rng)));
+
+		auto bodyA = CreateBody(shapeA, Vector3(0.0f), RandomOrientation(rng));
+		auto bodyB = CreateBody(shapeB, Vector3(offset(rng), offset(rng), offset(rng)), RandomOrientation(rng));
+
+		CollisionData satData, gjkData;
+		const bool sat = collisionDetection->CheckCollision(NarrowphaseType::SAT, bodyA.get(), bodyB.get(), shapeA.get(), shapeB.get(), &satData);
+		const bool gjk = collisionDetection->CheckCollision(NarrowphaseType::GJK_EPA, bodyA.get(), bodyB.get(), shapeA.get(), shapeB.get(), &gjkData);
+
+		// Grazing contacts can legitimately differ between the two tests
+		if (sat != gjk && fabs(satData.penetration) < 1e-3f)
+			continue;
+
+		REQUIRE(sat == gjk);
+
+		if (sat)
+		{
+			colliding++;
+
+			// SAT measures overlap from one side of each axis, so for deep contacts it can only overestimate
+			REQUIRE(-gjkData.penetration <= -satData.penetration + 1e-2f);
+
+			if (satData.penetration > -0.25f)
+			{
+				shallow++;
+				REQUIRE(gjkData.penetration == Approx(satData.penetration).margin(1e-2f));
+				REQUIRE(Vector3::Dot(gjkData.normal, satData.normal) > 0.9f);
+			}
+		}
+	}
+
+	REQUIRE(colliding > 0);
+	REQUIRE(shallow > 0);
+}
+
+TEST_CASE("GJK/EPA separating and touching shapes", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	auto collisionDetection = CollisionDetection::Instance();
+
+	auto cube = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+	auto sphere = CreateRef<SphereCollisionShape>(0.5f);
+	auto capsule = CreateRef<CapsuleCollisionShape>(0.5f, 2.0f);
+
+	auto bodyA = CreateBody(cube, Vector3(0.0f), Maths::Quaternion());
+
+	{
+		auto bodyB = CreateBody(cube, Vector3(2.0f, 0.0f, 0.0f), Maths::Quaternion());
+		REQUIRE_FALSE(collisionDetection->CheckConvexCollision(bodyA.get(), bodyB.get(), cube.get(), cube.get()));
+	}
+
+	{
+		CollisionData data;
+		auto bodyB = CreateBody(cube, Vector3(0.9f, 0.0f, 0.0f), Maths::Quaternion());
+		REQUIRE(collisionDetection->CheckConvexCollision(bodyA.get(), bodyB.get(), cube.get(), cube.get(), &data));
+		REQUIRE(data.penetration == Approx(-0.1f).margin(1e-3f));
+		REQUIRE(data.normal.x == Approx(1.0f).margin(1e-3f));
+	}
+
+	{
+		CollisionData data;
+		auto bodyB = CreateBody(sphere, Vector3(0.0f, 0.8f, 0.0f), Maths::Quaternion());
+		REQUIRE(collisionDetection->CheckConvexCollision(bodyA.get(), bodyB.get(), cube.get(), sphere.get(), &data));
+		REQUIRE(data.penetration == Approx(-0.2f).margin(1e-2f));
+		REQUIRE(data.normal.y == Approx(1.0f).margin(1e-2f));
+	}
+
+	{
+		// Capsule lies along z, so it reaches the cube from further away along that axis than its radius
+		CollisionData data;
+		auto bodyB = CreateBody(capsule, Vector3(0.0f, 0.0f, 1.9f), Maths::Quaternion());
+		REQUIRE(collisionDetection->CheckConvexCollision(bodyA.get(), bodyB.get(), cube.get(), capsule.get(), &data));
+		REQUIRE(data.penetration == Approx(-0.1f).margin(1e-2f));
+
+		auto bodyC = CreateBody(capsule, Vector3(1.9f, 0.0f, 0.0f), Maths::Quaternion());
+		REQUIRE_FALSE(collisionDetection->CheckConvexCollision(bodyA.get(), bodyC.get(), cube.get(), capsule.get()));
+	}
+}
+
+TEST_CASE("SAT cached axes follow body transform", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	auto collisionDetection = CollisionDetection::Instance();
+	auto cube = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+
+	auto bodyA = CreateBody(cube, Vector3(0.0f), Maths::Quaternion());
+	auto bodyB = CreateBody(cube, Vector3(2.0f, 0.0f, 0.0f), Maths::Quaternion());
+
+	REQUIRE(bodyA->GetWorldSpaceCollisionAxes().size() == 3);
+	REQUIRE(bodyA->GetWorldSpaceEdges().size() == 12);
+	REQUIRE(bodyA->GetWorldSpaceEdgeDirections().size() == 3);
+
+	REQUIRE_FALSE(collisionDetection->CheckCollision(bodyA.get(), bodyB.get(), cube.get(), cube.get()));
+
+	// Cached world space data must be rebuilt after the body moves
+	CollisionData data;
+	bodyB->SetPosition(Vector3(0.9f, 0.0f, 0.0f));
+	REQUIRE(collisionDetection->CheckCollision(bodyA.get(), bodyB.get(), cube.get(), cube.get(), &data));
+	REQUIRE(data.penetration == Approx(-0.1f).margin(1e-3f));
+
+	// Rotated 45 degrees about y the corner reaches sqrt(0.5) along x
+	bodyB->SetPosition(Vector3(1.15f, 0.0f, 0.0f));
+	REQUIRE_FALSE(collisionDetection->CheckCollision(bodyA.get(), bodyB.get(), cube.get(), cube.get()));
+	bodyB->SetOrientation(Maths::Quaternion(0.0f, 45.0f, 0.0f));
+	REQUIRE(collisionDetection->CheckCollision(bodyA.get(), bodyB.get(), cube.get(), cube.get(), &data));
+	REQUIRE(Vector3::Dot(bodyB->GetWorldSpaceCollisionAxes()[0], Vector3(1.0f, 0.0f, 0.0f)) == Approx(sqrtf(0.5f)).margin(1e-3f));
+}
+
+TEST_CASE("Swept sphere time of impact against a thin wall", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	auto wallShape = CreateRef<CuboidCollisionShape>(Vector3(0.05f, 2.0f, 2.0f));
+	auto wall = CreateBody(wallShape, Vector3(0.0f), Maths::Quaternion());
+
+	const float slop = 0.01f;
+	float toi = 0.0f;
+
+	// 10 units in one step, would tunnel straight through a discrete test
+	REQUIRE(CollisionDetection::SweptSphereTimeOfImpact(Vector3(-5.0f, 0.0f, 0.0f), 0.25f, Vector3(10.0f, 0.0f, 0.0f), wall.get(), wallShape.get(), slop, &toi));
+	const float hitX = -5.0f + 10.0f * toi;
+	REQUIRE(hitX + 0.25f >= -0.05f);
+	REQUIRE(hitX + 0.25f <= -0.05f + 2.0f * slop);
+
+	// Passing beside the wall or stopping short of it is not a hit
+	REQUIRE_FALSE(CollisionDetection::SweptSphereTimeOfImpact(Vector3(-5.0f, 3.0f, 0.0f), 0.25f, Vector3(10.0f, 0.0f, 0.0f), wall.get(), wallShape.get(), slop, &toi));
+	REQUIRE_FALSE(CollisionDetection::SweptSphereTimeOfImpact(Vector3(-5.0f, 0.0f, 0.0f), 0.25f, Vector3(4.0f, 0.0f, 0.0f), wall.get(), wallShape.get(), slop, &toi));
+
+	// Diagonal approach towards the edge of the wall
+	REQUIRE(CollisionDetection::SweptSphereTimeOfImpact(Vector3(-3.0f, -3.0f, 0.0f), 0.25f, Vector3(6.0f, 6.0f, 0.0f), wall.get(), wallShape.get(), slop, &toi));
+	REQUIRE(toi < 0.5f);
+
+	// Swept bounds cover the whole step for bullets, bodies no engine has stepped sweep over a 1/60 step
+	auto bullet = CreateBody(CreateRef<SphereCollisionShape>(0.25f), Vector3(-5.0f, 0.0f, 0.0f), Maths::Quaternion());
+	bullet->SetLinearVelocity(Vector3(10.0f * 60.0f, 0.0f, 0.0f));
+	REQUIRE(bullet->GetWorldSpaceAABB().max_.x < 0.0f);
+	bullet->SetIsBullet(true);
+	REQUIRE(bullet->GetWorldSpaceAABB().max_.x > 5.0f);
+}
+
+TEST_CASE("Ray queries against shapes and broadphase", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	auto cube = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+	auto sphere = CreateRef<SphereCollisionShape>(0.5f);
+	auto capsule = CreateRef<CapsuleCollisionShape>(0.5f, 2.0f);
+
+	const Ray ray(Vector3(-10.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f));
+
+	float distance;
+	Vector3 normal;
+
+	auto box = CreateBody(cube, Vector3(0.0f), Maths::Quaternion());
+	REQUIRE(CollisionDetection::CheckRayCollision(ray, 100.0f, box.get(), cube.get(), &distance, &normal));
+	REQUIRE(distance == Approx(9.5f).margin(1e-3f));
+	REQUIRE(normal.x == Approx(-1.0f).margin(1e-3f));
+	REQUIRE_FALSE(CollisionDetection::CheckRayCollision(ray, 9.0f, box.get(), cube.get(), &distance));
+
+	// Corner first at 45 degrees
+	auto rotatedBox = CreateBody(cube, Vector3(0.0f), Maths::Quaternion(0.0f, 45.0f, 0.0f));
+	REQUIRE(CollisionDetection::CheckRayCollision(ray, 100.0f, rotatedBox.get(), cube.get(), &distance));
+	REQUIRE(distance == Approx(10.0f - sqrtf(0.5f)).margin(1e-3f));
+
+	auto ball = CreateBody(sphere, Vector3(0.0f, 0.25f, 0.0f), Maths::Quaternion());
+	REQUIRE(CollisionDetection::CheckRayCollision(ray, 100.0f, ball.get(), sphere.get(), &distance, &normal));
+	REQUIRE(distance == Approx(10.0f - sqrtf(0.1875f)).margin(1e-3f));
+
+	// Capsule along z is hit on its side, and along its axis on the cap
+	auto pill = CreateBody(capsule, Vector3(0.0f), Maths::Quaternion());
+	REQUIRE(CollisionDetection::CheckRayCollision(ray, 100.0f, pill.get(), capsule.get(), &distance, &normal));
+	REQUIRE(distance == Approx(9.5f).margin(1e-3f));
+	REQUIRE(normal.x == Approx(-1.0f).margin(1e-3f));
+	REQUIRE(CollisionDetection::CheckRayCollision(Ray(Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 1.0f)), 100.0f, pill.get(), capsule.get(), &distance));
+	REQUIRE(distance == Approx(8.5f).margin(1e-3f));
+	REQUIRE_FALSE(CollisionDetection::CheckRayCollision(Ray(Vector3(-10.0f, 0.0f, 1.6f), Vector3(1.0f, 0.0f, 0.0f)), 100.0f, pill.get(), capsule.get(), &distance));
+
+	// Broadphase candidates, one row of boxes along x, the ray along y only crosses one of them
+	std::vector<Ref<PhysicsObject3D>> objects;
+	for (int i = 0; i < 11; ++i)
+		objects.push_back(CreateBody(cube, Vector3(float(i) * 2.0f, 0.0f, 0.0f), Maths::Quaternion()));
+
+	std::vector<CollisionPair> pairs;
+	auto octree = CreateRef<Octree>(2, 4, CreateRef<BruteForceBroadphase>());
+	octree->FindPotentialCollisionPairs(objects, pairs);
+	BruteForceBroadphase bruteForce;
+
+	const Ray down(Vector3(6.0f, 10.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f));
+	for (Broadphase* broadphase : { static_cast<Broadphase*>(octree.get()), static_cast<Broadphase*>(&bruteForce) })
+	{
+		std::vector<PhysicsObject3D*> candidates;
+		broadphase->FindObjectsOnRay(objects, down, 100.0f, candidates);
+		REQUIRE(candidates.size() == 1);
+		REQUIRE(candidates[0] == objects[3].get());
+
+		candidates.clear();
+		broadphase->FindObjectsOnRay(objects, ray, 100.0f, candidates);
+		REQUIRE(candidates.size() == objects.size());
+
+		candidates.clear();
+		broadphase->FindObjectsInAABB(objects, BoundingBox(Vector3(3.2f, -1.0f, -1.0f), Vector3(6.8f, 1.0f, 1.0f)), candidates);
+		REQUIRE(candidates.size() == 2);
+	}
+}
+
+TEST_CASE("Quickhull collision shape", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	// Cube corners plus interior and face points, coplanar triangles merge back into quads
+	std::vector<Vector3> cubePoints;
+	for (int i = 0; i < 8; ++i)
+		cubePoints.emplace_back((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f);
+	for (int i = 0; i < 200; ++i)
+		cubePoints.emplace_back(unit(rng) * 0.5f, unit(rng) * 0.5f, i % 2 ? 0.5f : unit(rng) * 0.5f);
+
+	auto hullCube = CreateRef<HullCollisionShape>(cubePoints);
+	REQUIRE(hullCube->GetNumVertices() == 8);
+	REQUIRE(hullCube->GetNumFaces() == 6);
+	REQUIRE(hullCube->GetLocalCollisionAxes().size() == 3);
+
+	// Same SAT result as the cuboid it approximates
+	auto cube = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+	auto a = CreateBody(cube, Vector3(0.0f), Maths::Quaternion());
+	auto b = CreateBody(hullCube, Vector3(0.7f, 0.3f, 0.0f), Maths::Quaternion(0.0f, 30.0f, 0.0f));
+	auto c = CreateBody(cube, Vector3(0.7f, 0.3f, 0.0f), Maths::Quaternion(0.0f, 30.0f, 0.0f));
+
+	CollisionData hullData, cubeData;
+	REQUIRE(CollisionDetection::Instance()->CheckCollision(a.get(), b.get(), cube.get(), hullCube.get(), &hullData));
+	REQUIRE(CollisionDetection::Instance()->CheckCollision(a.get(), c.get(), cube.get(), cube.get(), &cubeData));
+	REQUIRE(hullData.penetration == Approx(cubeData.penetration).margin(1e-4f));
+
+	// Points on a sphere are simplified down to the requested vertex count, support queries match a linear scan
+	std::vector<Vector3> spherePoints;
+	for (int i = 0; i < 2000; ++i)
+		spherePoints.push_back(Vector3(unit(rng), unit(rng), unit(rng)).Normalized());
+
+	HullCollisionShape sphereHull(spherePoints, 24);
+	REQUIRE(sphereHull.GetNumVertices() <= 24);
+	REQUIRE(sphereHull.GetNumVertices() >= 12);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		const Vector3 axis = Vector3(unit(rng), unit(rng), unit(rng)).Normalized();
+		Vector3 min, max;
+		sphereHull.GetMinMaxVertexOnAxis(nullptr, axis, &min, &max);
+
+		float best = -Maths::M_INFINITY, worst = Maths::M_INFINITY;
+		for (const Vector3& v : sphereHull.GetVertices())
+		{
+			best = Maths::Max(best, axis.DotProduct(v));
+			worst = Maths::Min(worst, axis.DotProduct(v));
+		}
+
+		REQUIRE(axis.DotProduct(max) == Approx(best));
+		REQUIRE(axis.DotProduct(min) == Approx(worst));
+	}
+
+	// Loading a serialised hull gives the same shape without building it again
+	nlohmann::json data = sphereHull.Serialise();
+	HullCollisionShape loaded;
+	loaded.Deserialise(data);
+	REQUIRE(loaded.GetNumVertices() == sphereHull.GetNumVertices());
+	REQUIRE(loaded.GetNumFaces() == sphereHull.GetNumFaces());
+	REQUIRE(loaded.GetLocalEdges().size() == sphereHull.GetLocalEdges().size());
+
+	// Flat input falls back to a thin box
+	std::vector<Vector3> quad = { Vector3(-1.0f, 0.0f, -1.0f), Vector3(1.0f, 0.0f, -1.0f), Vector3(1.0f, 0.0f, 1.0f), Vector3(-1.0f, 0.0f, 1.0f) };
+	HullCollisionShape flat(quad);
+	REQUIRE(flat.GetNumVertices() == 8);
+}
+
+TEST_CASE("Deterministic stepping and state rollback", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+
+	auto simulate = [](std::vector<u8>& out_state)
+	{
+		entt::registry registry;
+		CreateBoxPile(registry);
+
+		LumosPhysicsEngine engine;
+		engine.SetDeterministic(true);
+		engine.SetBroadphase(CreateRef<BruteForceBroadphase>());
+		engine.ConnectRegistry(registry);
+		engine.Simulate(120);
+		engine.SaveState(out_state);
+	};
+
+	std::vector<u8> first, second;
+	simulate(first);
+	simulate(second);
+	REQUIRE(first.size() > 0);
+	REQUIRE(first == second);
+
+	// Roll back 10 steps and re-simulate them
+	entt::registry registry;
+	auto bodies = CreateBoxPile(registry);
+
+	LumosPhysicsEngine engine;
+	engine.SetDeterministic(true);
+	engine.SetBroadphase(CreateRef<BruteForceBroadphase>());
+	engine.ConnectRegistry(registry);
+	engine.Simulate(110);
+
+	std::vector<u8> snapshot, resimulated;
+	engine.SaveState(snapshot);
+	engine.Simulate(10);
+	REQUIRE(engine.GetStepCount() == 120);
+
+	bodies[1]->SetLinearVelocity(Maths::Vector3(5.0f, 0.0f, 0.0f));
+	REQUIRE(engine.RestoreState(snapshot));
+	REQUIRE(engine.GetStepCount() == 110);
+	engine.Simulate(10);
+	engine.SaveState(resimulated);
+	REQUIRE(resimulated == first);
+
+	// Bodies follow the registry, and a state saved with a different body set is rejected
+	REQUIRE(engine.GetNumberPhysicsObjects() == 9);
+	registry.destroy(*registry.view<Physics3DComponent>().begin());
+	engine.Simulate(0);
+	REQUIRE(engine.GetNumberPhysicsObjects() == 8);
+	REQUIRE_FALSE(engine.RestoreState(snapshot));
+
+	AddBody(registry, bodies[1]);
+	engine.Simulate(0);
+	REQUIRE(engine.GetNumberPhysicsObjects() == 9);
+}
+
+TEST_CASE("Bodies keep their state in the engine's body store", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+
+	entt::registry registry;
+	auto body = CreateBody(CreateRef<SphereCollisionShape>(0.5f), Maths::Vector3(1.0f, 2.0f, 3.0f), Maths::Quaternion());
+	body->SetInverseMass(1.0f);
+	body->SetLinearVelocity(Maths::Vector3(0.0f, 0.0f, 4.0f));
+	AddBody(registry, body);
+
+	LumosPhysicsEngine engine;
+	engine.SetBroadphase(CreateRef<BruteForceBroadphase>());
+	engine.ConnectRegistry(registry);
+
+	// Attached bodies read and write their slot
+	const BodyStateStore& store = engine.GetBodyStates();
+	REQUIRE(store.GetBodyCount() == 1);
+	REQUIRE(store.GetVector3(BodyStateStore::PositionX, 0) == Maths::Vector3(1.0f, 2.0f, 3.0f));
+	body->SetPosition(Maths::Vector3(0.0f, 5.0f, 0.0f));
+	REQUIRE(store.GetVector3(BodyStateStore::PositionX, 0) == Maths::Vector3(0.0f, 5.0f, 0.0f));
+
+	// Copies aren't attached
+	PhysicsObject3D copy(*body);
+	copy.SetPosition(Maths::Vector3(9.0f));
+	REQUIRE(copy.GetLinearVelocity() == body->GetLinearVelocity());
+	REQUIRE(body->GetPosition() == Maths::Vector3(0.0f, 5.0f, 0.0f));
+
+	// A second entity with the same body shares its slot
+	AddBody(registry, body);
+	REQUIRE(store.GetBodyCount() == 1);
+
+	// Integrated in place, sleeping bodies keep their state
+	engine.Simulate(1);
+	REQUIRE(body->GetPosition().z > 0.0f);
+	REQUIRE(store.Get(BodyStateStore::PositionZ, 0) == body->GetPosition().z);
+
+	body->SetIsAtRest(true);
+	const Maths::Vector3 resting = body->GetPosition();
+	engine.Simulate(1);
+	REQUIRE(body->GetPosition() == resting);
+
+	// The state is copied back once the last entity using the body is gone
+	registry.destroy(*registry.view<Physics3DComponent>().begin());
+	REQUIRE(store.GetBodyCount() == 1);
+	registry.destroy(*registry.view<Physics3DComponent>().begin());
+	REQUIRE(store.GetBodyCount() == 0);
+	REQUIRE(body->GetPosition() == resting);
+}
+
+TEST_CASE("Triangle mesh collision shape", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	REQUIRE(sizeof(TriangleMeshCollisionShape::BVHNode) == 16);
+
+	// Grid of quads facing up, heights given per vertex
+	auto createGrid = [](int size, const std::function<float(float, float)>& height)
+	{
+		std::vector<Vector3> vertices;
+		std::vector<u32> indices;
+
+		for (int z = 0; z <= size; ++z)
+			for (int x = 0; x <= size; ++x)
+				vertices.emplace_back(float(x - size / 2), height(float(x), float(z)), float(z - size / 2));
+
+		for (int z = 0; z < size; ++z)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				const u32 i = u32(z * (size + 1) + x);
+				const u32 row = u32(size + 1);
+				indices.insert(indices.end(), { i, i + row, i + 1, i + 1, i + row, i + row + 1 });
+			}
+		}
+
+		return CreateRef<TriangleMeshCollisionShape>(vertices, indices);
+	};
+
+	auto terrain = createGrid(96, [](float x, float z) { return sinf(x * 0.3f) * cosf(z * 0.2f) * 2.0f; });
+	REQUIRE(terrain->GetNumTriangles() == 96 * 96 * 2);
+
+	auto terrainBody = CreateBody(terrain, Vector3(3.0f, -1.0f, 2.0f), Maths::Quaternion(0.0f, 30.0f, 0.0f));
+
+	auto rayTriangle = [](const Ray& ray, const Vector3* v, float* out_t)
+	{
+		const Vector3 e1 = v[1] - v[0], e2 = v[2] - v[0];
+		const Vector3 p = ray.direction_.CrossProduct(e2);
+		const float det = e1.DotProduct(p);
+		if (abs(det) < 1e-12f)
+			return false;
+
+		const Vector3 s = ray.origin_ - v[0];
+		const float u = s.DotProduct(p) / det;
+		const Vector3 q = s.CrossProduct(e1);
+		const float w = ray.direction_.DotProduct(q) / det;
+		*out_t = e2.DotProduct(q) / det;
+		return u >= 0.0f && w >= 0.0f && u + w <= 1.0f && *out_t >= 0.0f;
+	};
+
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> coord(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	const Matrix4 transform = terrainBody->GetWorldSpaceTransform();
+	Vector3 triangle[3];
+
+	// BVH raycasts match testing every triangle
+	for (int i = 0; i < 200; ++i)
+	{
+		const Ray ray(Vector3(coord(rng), 10.0f, coord(rng)), Vector3(unit(rng), -1.0f, unit(rng)));
+
+		float expected = M_INFINITY, t;
+		for (u32 j = 0; j < terrain->GetNumTriangles(); ++j)
+		{
+			terrain->GetTriangle(j, triangle);
+			for (Vector3& v : triangle)
+				v = transform * v;
+
+			if (rayTriangle(ray, triangle, &t))
+				expected = Min(expected, t);
+		}
+
+		float distance;
+		Vector3 normal;
+		const bool hit = CollisionDetection::CheckRayCollision(ray, 100.0f, terrainBody.get(), terrain.get(), &distance, &normal);
+		REQUIRE(hit == (expected <= 100.0f));
+		if (hit)
+		{
+			REQUIRE(distance == Approx(expected).margin(0.001f));
+			REQUIRE(normal.DotProduct(ray.direction_) < 0.0f);
+		}
+	}
+
+	// Box queries return every triangle that overlaps the box
+	for (int i = 0; i < 50; ++i)
+	{
+		const Vector3 centre(coord(rng) * 0.8f, unit(rng) * 2.0f, coord(rng) * 0.8f);
+		const BoundingBox box(centre - Vector3(1.5f), centre + Vector3(1.5f));
+
+		std::vector<u32> found;
+		terrain->QueryAABB(box, found);
+		std::sort(found.begin(), found.end());
+
+		for (u32 j = 0; j < terrain->GetNumTriangles(); ++j)
+		{
+			terrain->GetTriangle(j, triangle);
+			BoundingBox bounds(triangle, 3);
+			if (bounds.IsInside(box) != OUTSIDE)
+				REQUIRE(std::binary_search(found.begin(), found.end(), j));
+		}
+	}
+
+	// Sphere, box and capsule dropped onto a flat mesh come to rest on it.
+	// Capsule pairs are only handled by GJK, the mesh pairs go through the mesh path either way.
+	entt::registry registry;
+
+	auto floor = CreateBody(createGrid(20, [](float, float) { return 0.0f; }), Vector3(0.0f), Maths::Quaternion());
+	floor->SetIsStatic(true);
+	floor->SetElasticity(0.0f);
+	AddBody(registry, floor);
+
+	auto sphereShape = CreateRef<SphereCollisionShape>(0.5f);
+	auto boxShape = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+	auto capsuleShape = CreateRef<CapsuleCollisionShape>(0.4f, 1.5f);
+
+	std::vector<Ref<PhysicsObject3D>> bodies = {
+		CreateBody(sphereShape, Vector3(-3.0f, 2.0f, 0.0f), Maths::Quaternion()),
+		CreateBody(boxShape, Vector3(0.0f, 2.0f, 0.0f), Maths::Quaternion()),
+		CreateBody(capsuleShape, Vector3(3.0f, 2.0f, 0.0f), Maths::Quaternion())
+	};
+
+	for (auto& body : bodies)
+	{
+		body->SetInverseMass(1.0f);
+		body->SetInverseInertia(body->GetCollisionShape()->BuildInverseInertia(1.0f));
+		AddBody(registry, body);
+	}
+
+	LumosPhysicsEngine engine;
+	engine.SetDeterministic(true);
+	engine.SetBroadphase(CreateRef<BruteForceBroadphase>());
+	engine.SetNarrowphaseType(NarrowphaseType::GJK_EPA);
+	engine.ConnectRegistry(registry);
+	engine.Simulate(240);
+
+	REQUIRE(bodies[0]->GetPosition().y == Approx(0.5f).margin(0.02f));
+	REQUIRE(bodies[1]->GetPosition().y == Approx(0.5f).margin(0.02f));
+	REQUIRE(bodies[2]->GetPosition().y == Approx(0.4f).margin(0.02f));
+}
+
+TEST_CASE("Physics budget picks substeps and solver iterations", "[Lumos::Physics]")
+{
+	using namespace Lumos;
+
+	const float timestep = 1.0f / 60.0f;
+	PhysicsBudget budget(10, 50, 5, 4.0f);
+
+	// Without measurements every pending step runs at full iterations
+	float accumulator = timestep * 3.5f;
+	REQUIRE(budget.BeginFrame(accumulator, timestep) == 3);
+	REQUIRE(budget.GetSolverIterations() == 50);
+	REQUIRE(accumulator == Approx(timestep * 0.5f));
+
+	// 0.2ms outside the solver and 0.02ms per iteration: two steps fit the budget with 90 iterations, so the maximum is used
+	budget.RecordStep(0.2f + 0.02f * 50, 0.02f * 50, 50);
+	accumulator = timestep * 2.0f;
+	REQUIRE(budget.BeginFrame(accumulator, timestep) == 2);
+	REQUIRE(budget.GetSolverIterations() == 50);
+
+	// Four steps get (1ms - 0.2ms) / 0.02ms = 40 iterations each
+	accumulator = timestep * 4.0f;
+	REQUIRE(budget.BeginFrame(accumulator, timestep) == 4);
+	REQUIRE(budget.GetSolverIterations() == 40);
+
+	// A step costing more than the budget still runs once a frame at the lowest iterations, the backlog is dropped
+	PhysicsBudget slow(10, 50, 5, 4.0f);
+	slow.RecordStep(5.0f + 0.1f * 50, 0.1f * 50, 50);
+	accumulator = timestep * 4.5f;
+	REQUIRE(slow.BeginFrame(accumulator, timestep) == 1);
+	REQUIRE(slow.GetSolverIterations() == 10);
+	REQUIRE(accumulator < timestep);
+
+	// Keeping time runs at full iterations and carries the remainder over
+	accumulator = timestep * 7.0f;
+	REQUIRE(slow.BeginFrame(accumulator, timestep, true) == 5);
+	REQUIRE(slow.GetSolverIterations() == 50);
+	REQUIRE(accumulator == Approx(timestep * 2.0f));
+}
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE("Narrowphase Benchmark", "[Lumos::Physics][!benchmark]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+	auto collisionDetection = CollisionDetection::Instance();
+	auto shape = CreateRef<CuboidCollisionShape>(Vector3(0.5f));
+
+	std::vector<Ref<PhysicsObject3D>> bodies;
+	for (int i = 0; i < 256; ++i)
+		bodies.push_back(CreateBody(shape, Vector3(offset(rng), offset(rng), offset(rng)), RandomOrientation(rng)));
+
+	auto run = [&](NarrowphaseType type)
+	{
+		int hits = 0;
+		CollisionData data;
+		for (size_t i = 0; i + 1 < bodies.size(); i += 2)
+			hits += collisionDetection->CheckCollision(type, bodies[i].get(), bodies[i + 1].get(), shape.get(), shape.get(), &data) ? 1 : 0;
+		return hits;
+	};
+
+	BENCHMARK("SAT cuboid pairs")
+	{
+		return run(NarrowphaseType::SAT);
+	};
+
+	BENCHMARK("GJK/EPA cuboid pairs")
+	{
+		return run(NarrowphaseType::GJK_EPA);
+	};
+}
+#endif
@@ -0,0 +1,151 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "App/Prefab.h"
+#include "App/SceneGraph.h"
+#include "Physics/LumosPhysicsEngine/SphereCollisionShape.h"
+
+namespace
+{
+	// A physics body root with two children, the first with a child of its own
+	entt::entity CreatePrefabSource(entt::registry& registry, const Lumos::Maths::Vector3& position)
+	{
+		using namespace Lumos;
+		using namespace Maths;
+
+		auto root = registry.create();
+		registry.assign<NameComponent>(root, "Root");
+		registry.assign<Transform>(root);
+
+		auto body = CreateRef<PhysicsObject3D>();
+		body->SetPosition(position);
+		body->SetInverseMass(0.5f);
+		body->SetCollisionShape(CreateRef<SphereCollisionShape>(0.5f));
+		body->SetInverseInertia(body->GetCollisionShape()->BuildInverseInertia(0.5f));
+		registry.assign<Physics3DComponent>(root, body);
+
+		auto left = registry.create();
+		registry.assign<NameComponent>(left, "Left");
+		registry.assign<Transform>(left, Vector3(-1.0f, 0.0f, 0.0f));
+		registry.assign<Hierarchy>(left, root);
+
+		auto right = registry.create();
+		registry.assign<NameComponent>(right, "Right");
+		registry.assign<Transform>(right, Vector3(1.0f, 0.0f, 0.0f));
+		registry.assign<Hierarchy>(right, root);
+
+		auto leaf = registry.create();
+		registry.assign<Transform>(leaf, Vector3(0.0f, 2.0f, 0.0f));
+		registry.assign<Hierarchy>(leaf, left);
+
+		return root;
+	}
+}
+
+TEST_CASE("Prefab instancing", "[Lumos::Prefab]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	auto source = CreatePrefabSource(registry, Vector3(1.0f, 2.0f, 3.0f));
+	Prefab prefab(registry, source);
+	REQUIRE(prefab.GetNodeCount() == 4);
+	REQUIRE(prefab.GetOrigin().y == Approx(2.0f));
+
+	// Changes after capture don't reach the prefab
+	registry.get<NameComponent>(source).name = "Changed";
+	registry.get<Physics3DComponent>(source).GetPhysicsObject()->SetInverseMass(1.0f);
+
+	std::vector<Vector3> positions;
+	for (int i = 0; i < 1000; i++)
+		positions.push_back(Vector3(float(i), 0.0f, 0.0f));
+
+	auto roots = prefab.Instantiate(registry, positions);
+	REQUIRE(roots.size() == 1000);
+	REQUIRE(registry.alive() == 4004);
+	REQUIRE(registry.size<Transform>() == 4004);
+	REQUIRE(registry.size<NameComponent>() == 3003);
+	REQUIRE(registry.size<Physics3DComponent>() == 1001);
+
+	const auto& sourceShape = registry.get<Physics3DComponent>(source).GetPhysicsObject()->GetCollisionShape();
+	for (int i = 0; i < 1000; i++)
+	{
+		auto root = roots[i];
+		REQUIRE(registry.get<NameComponent>(root).name == "Root");
+
+		// Bodies are per instance, shapes are shared
+		const auto& body = registry.get<Physics3DComponent>(root).GetPhysicsObject();
+		REQUIRE(body != registry.get<Physics3DComponent>(source).GetPhysicsObject());
+		REQUIRE(body->GetCollisionShape() == sourceShape);
+		REQUIRE(body->GetInverseMass() == Approx(0.5f));
+		REQUIRE(body->GetPosition().x == Approx(float(i)));
+		REQUIRE(body->GetPosition().y == Approx(0.0f));
+
+		// Children are linked in their original order
+		auto& hierarchy = registry.get<Hierarchy>(root);
+		auto left = hierarchy.first();
+		REQUIRE((left != entt::null));
+		REQUIRE(registry.get<NameComponent>(left).name == "Left");
+		REQUIRE(registry.get<Hierarchy>(left).parent() == root);
+
+		auto right = registry.get<Hierarchy>(left).next();
+		REQUIRE((right != entt::null));
+		REQUIRE(registry.get<NameComponent>(right).name == "Right");
+		REQUIRE((registry.get<Hierarchy>(right).next() == entt::null));
+
+		auto leaf = registry.get<Hierarchy>(left).first();
+		REQUIRE((leaf != entt::null));
+		REQUIRE(registry.get<Transform>(leaf).GetLocalPosition().y == Approx(2.0f));
+		REQUIRE((registry.get<Hierarchy>(leaf).next() == entt::null));
+	}
+
+	// Roots without a body are placed through their transform
+	auto bodyless = registry.create();
+	registry.assign<Transform>(bodyless, Vector3(5.0f, 0.0f, 0.0f));
+	Prefab transformPrefab(registry, bodyless);
+	auto instance = transformPrefab.Instantiate(registry, Vector3(7.0f, 1.0f, 0.0f));
+	REQUIRE(registry.get<Transform>(instance).GetLocalPosition().x == Approx(7.0f));
+	REQUIRE(registry.get<Transform>(instance).GetLocalPosition().y == Approx(1.0f));
+}
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE("Prefab Benchmark", "[Lumos::Prefab][!benchmark]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	const int instanceCount = 10000;
+
+	std::vector<Vector3> positions;
+	for (int i = 0; i < instanceCount; i++)
+		positions.push_back(Vector3(float(i % 100), float(i / 100), 0.0f));
+
+	BENCHMARK("Build each entity")
+	{
+		entt::registry registry;
+		SceneGraph sceneGraph;
+		sceneGraph.Init(registry);
+
+		for (auto& position : positions)
+			CreatePrefabSource(registry, position);
+
+		return registry.alive();
+	};
+
+	BENCHMARK("Prefab instantiate")
+	{
+		entt::registry registry;
+		SceneGraph sceneGraph;
+		sceneGraph.Init(registry);
+
+		Prefab prefab(registry, CreatePrefabSource(registry, Vector3(0.0f)));
+		prefab.Instantiate(registry, positions);
+
+		return registry.alive();
+	};
+}
+#endif
@@ -0,0 +1,91 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "App/SceneGraph.h"
+#include "ECS/DirtySet.h"
+
+TEST_CASE("Scene graph world matrices", "[Lumos::SceneGraph]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	// root -> child -> grandchild, plus a second root with many children to cover the parallel path
+	auto root = registry.create();
+	registry.assign<Transform>(root, Vector3(1.0f, 0.0f, 0.0f));
+
+	auto child = registry.create();
+	registry.assign<Transform>(child, Vector3(0.0f, 2.0f, 0.0f));
+	registry.assign<Hierarchy>(child, root);
+
+	auto grandchild = registry.create();
+	registry.assign<Transform>(grandchild, Vector3(0.0f, 0.0f, 3.0f));
+	registry.assign<Hierarchy>(grandchild, child);
+
+	auto wideRoot = registry.create();
+	registry.assign<Transform>(wideRoot, Vector3(-1.0f, 0.0f, 0.0f));
+
+	std::vector<entt::entity> leaves;
+	for (int i = 0; i < 1000; i++)
+	{
+		auto leaf = registry.create();
+		registry.assign<Transform>(leaf, Vector3(0.0f, float(i), 0.0f));
+		registry.assign<Hierarchy>(leaf, wideRoot);
+		leaves.push_back(leaf);
+	}
+
+	sceneGraph.Update(registry);
+	REQUIRE(sceneGraph.GetNodeCount() == 1004);
+	REQUIRE(sceneGraph.GetDepthCount() == 3);
+
+	auto worldPosition = [&](entt::entity entity) { return registry.get<Transform>(entity).GetWorldMatrix().Translation(); };
+
+	REQUIRE(worldPosition(grandchild).x == Approx(1.0f));
+	REQUIRE(worldPosition(grandchild).y == Approx(2.0f));
+	REQUIRE(worldPosition(grandchild).z == Approx(3.0f));
+	for (int i = 0; i < 1000; i++)
+	{
+		REQUIRE(worldPosition(leaves[i]).x == Approx(-1.0f));
+		REQUIRE(worldPosition(leaves[i]).y == Approx(float(i)));
+	}
+
+	// Moving a parent updates its subtree, unchanged subtrees are left alone
+	const u32 grandchildVersion = registry.get<Transform>(grandchild).GetWorldVersion();
+	const u32 leafVersion = registry.get<Transform>(leaves[1]).GetWorldVersion();
+	DirtySet<Transform> changed(registry);
+	sceneGraph.Update(registry);
+	REQUIRE(registry.get<Transform>(grandchild).GetWorldVersion() == grandchildVersion);
+	REQUIRE(changed.Empty());
+
+	registry.get<Transform>(leaves[0]).SetWorldMatrix(Matrix4::Translation(Vector3(100.0f, 0.0f, 0.0f)));
+	registry.get<Transform>(root).SetLocalPosition(Vector3(5.0f, 0.0f, 0.0f));
+	sceneGraph.Update(registry);
+
+	REQUIRE(worldPosition(grandchild).x == Approx(5.0f));
+	REQUIRE(registry.get<Transform>(grandchild).GetWorldVersion() != grandchildVersion);
+	REQUIRE(worldPosition(leaves[0]).x == Approx(100.0f));
+	REQUIRE(registry.get<Transform>(leaves[1]).GetWorldVersion() == leafVersion);
+
+	// Recomputed world matrices are reported to dirty sets
+	REQUIRE(changed.Size() == 3);
+	REQUIRE(changed.Contains(grandchild));
+	REQUIRE_FALSE(changed.Contains(leaves[1]));
+	changed.Disconnect();
+
+	// Reparenting rebuilds the hierarchy
+	auto& hierarchy = registry.get<Hierarchy>(grandchild);
+	Hierarchy::Reparent(grandchild, wideRoot, registry, hierarchy);
+	sceneGraph.Update(registry);
+
+	REQUIRE(sceneGraph.GetDepthCount() == 2);
+	REQUIRE(worldPosition(grandchild).x == Approx(-1.0f));
+	REQUIRE(worldPosition(grandchild).y == Approx(0.0f));
+
+	// Destroyed transforms drop out of the flat list
+	registry.destroy(child);
+	sceneGraph.Update(registry);
+	REQUIRE(sceneGraph.GetNodeCount() == 1003);
+}
@@ -0,0 +1,280 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "App/SceneGraph.h"
+#include "App/SceneBinarySerialiser.h"
+#include "Physics/LumosPhysicsEngine/CuboidCollisionShape.h"
+#include "Physics/LumosPhysicsEngine/SphereCollisionShape.h"
+
+#include <fstream>
+
+namespace
+{
+	// A root with a chain of children, and bodies sharing one of two shapes
+	void CreateTestScene(entt::registry& registry, int bodyCount)
+	{
+		using namespace Lumos;
+		using namespace Maths;
+
+		Ref<CollisionShape> cuboid = CreateRef<CuboidCollisionShape>(Vector3(0.5f, 1.0f, 1.5f));
+		Ref<CollisionShape> sphere = CreateRef<SphereCollisionShape>(2.0f);
+
+		auto root = registry.create();
+		registry.assign<Transform>(root, Vector3(1.0f, 2.0f, 3.0f));
+
+		auto parent = root;
+		for (int i = 0; i < bodyCount; i++)
+		{
+			auto entity = registry.create();
+			auto& transform = registry.assign<Transform>(entity, Vector3(float(i), 0.0f, 0.0f));
+			transform.SetLocalScale(Vector3(1.0f, 2.0f, float(i + 1)));
+			transform.SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(0.0f, float(i), 0.0f));
+			registry.assign<Hierarchy>(entity, parent);
+
+			if (i % 10 == 9)
+				parent = entity;
+
+			auto body = CreateRef<PhysicsObject3D>();
+			body->SetCollisionShape(i % 2 ? cuboid : sphere);
+			body->SetPosition(Vector3(float(i), 1.0f, 0.0f));
+			body->SetLinearVelocity(Vector3(0.0f, float(i), 0.0f));
+			body->SetInverseMass(1.0f / float(i + 1));
+			body->SetFriction(0.25f);
+			if (i % 7 == 0)
+				body->SetIsStatic(true);
+			registry.assign<Physics3DComponent>(entity, body);
+		}
+	}
+
+	template<typename T>
+	void RequireEqual(const T& a, const T& b, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			REQUIRE(a[i] == Approx(b[i]));
+	}
+}
+
+TEST_CASE("Binary scene round trip", "[Lumos::SceneBinarySerialiser]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	const String path = "SceneBinaryTest.lsb";
+
+	entt::registry source;
+	SceneGraph sourceGraph;
+	sourceGraph.Init(source);
+	CreateTestScene(source, 100);
+	REQUIRE(SceneBinarySerialiser::Save(source, path));
+
+	entt::registry loaded;
+	SceneGraph loadedGraph;
+	loadedGraph.Init(loaded);
+	REQUIRE(SceneBinarySerialiser::Load(loaded, path));
+
+	REQUIRE(loaded.alive() == source.alive());
+	REQUIRE(loaded.size<Transform>() == source.size<Transform>());
+	REQUIRE(loaded.size<Hierarchy>() == source.size<Hierarchy>());
+	REQUIRE(loaded.size<Physics3DComponent>() == source.size<Physics3DComponent>());
+
+	// Both registries started empty, so the entities get their ids back
+	source.each([&](entt::entity entity) { REQUIRE(loaded.valid(entity)); });
+
+	source.view<Transform>().each([&](entt::entity entity, Transform& expected)
+	{
+		auto& transform = loaded.get<Transform>(entity);
+		RequireEqual(transform.GetLocalPosition(), expected.GetLocalPosition(), 3);
+		RequireEqual(transform.GetLocalScale(), expected.GetLocalScale(), 3);
+		REQUIRE(transform.GetLocalOrientation().w == Approx(expected.GetLocalOrientation().w));
+		REQUIRE(transform.GetLocalOrientation().y == Approx(expected.GetLocalOrientation().y));
+	});
+
+	source.view<Hierarchy>().each([&](entt::entity entity, Hierarchy& expected)
+	{
+		auto& hierarchy = loaded.get<Hierarchy>(entity);
+		REQUIRE(hierarchy.parent() == expected.parent());
+		REQUIRE(hierarchy.first() == expected.first());
+		REQUIRE(hierarchy.next() == expected.next());
+		REQUIRE(hierarchy.prev() == expected.prev());
+	});
+
+	std::set<CollisionShape*> shapes;
+	source.view<Physics3DComponent>().each([&](entt::entity entity, Physics3DComponent& component)
+	{
+		auto& expected = *component.GetPhysicsObject();
+		auto& body = *loaded.get<Physics3DComponent>(entity).GetPhysicsObject();
+		RequireEqual(body.GetPosition(), expected.GetPosition(), 3);
+		RequireEqual(body.GetLinearVelocity(), expected.GetLinearVelocity(), 3);
+		REQUIRE(body.GetInverseMass() == Approx(expected.GetInverseMass()));
+		REQUIRE(body.GetFriction() == Approx(expected.GetFriction()));
+		REQUIRE(body.GetIsStatic() == expected.GetIsStatic());
+		REQUIRE(body.GetCollisionShape()->GetType() == expected.GetCollisionShape()->GetType());
+		shapes.insert(body.GetCollisionShape().get());
+	});
+
+	// Shared shapes stay shared
+	REQUIRE(shapes.size() == 2);
+
+	// Files that aren't binary scenes are rejected
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << "{ \"not\": \"a binary scene\" }";
+	}
+	entt::registry rejected;
+	REQUIRE_FALSE(SceneBinarySerialiser::Load(rejected, path));
+	REQUIRE(rejected.alive() == 0);
+
+	std::remove(path.c_str());
+}
+
+TEST_CASE("Binary scene malformed files", "[Lumos::SceneBinarySerialiser]")
+{
+	using namespace Lumos;
+	using namespace SceneBinary;
+
+	const String path = "SceneBinaryMalformed.lsb";
+
+	struct File
+	{
+		FileHeader header;
+		SectionHeader sections[2];
+		TransformRecord transforms[2];
+	};
+
+	auto write = [&](const File& contents)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&contents), sizeof(contents));
+	};
+
+	File contents = {};
+	contents.header = { Magic, Version, 2, 2 };
+	contents.sections[0] = { SectionTransforms, 2, offsetof(File, transforms) };
+	contents.transforms[0].orientation[0] = 1.0f;
+	contents.transforms[1].orientation[0] = 1.0f;
+	contents.transforms[1].position[0] = 5.0f;
+
+	// Offset plus size wraps around to the start of the file
+	contents.sections[1] = { SectionBodies3D, 2, sizeof(FileHeader) - 2 * sizeof(Body3DRecord) };
+
+	// The second record for the same entity is skipped, the body section is dropped
+	write(contents);
+	entt::registry registry;
+	REQUIRE(SceneBinarySerialiser::Load(registry, path));
+	REQUIRE(registry.alive() == 2);
+	REQUIRE(registry.size<Maths::Transform>() == 1);
+	REQUIRE(registry.raw<Maths::Transform>()[0].GetLocalPosition().x == 0.0f);
+	REQUIRE(registry.size<Physics3DComponent>() == 0);
+
+	// More entities than the file has bytes
+	contents.header.entityCount = ~0u;
+	write(contents);
+	entt::registry rejected;
+	REQUIRE_FALSE(SceneBinarySerialiser::Load(rejected, path));
+	REQUIRE(rejected.alive() == 0);
+
+	std::remove(path.c_str());
+}
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE("Scene Serialisation Benchmark", "[Lumos::SceneBinarySerialiser][!benchmark]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	const int bodyCount = 10000;
+	const String binaryPath = "SceneBenchmark.lsb";
+	const String jsonPath = "SceneBenchmark.json";
+
+	entt::registry source;
+	SceneGraph sourceGraph;
+	sourceGraph.Init(source);
+	CreateTestScene(source, bodyCount);
+
+	// The JSON path writes each component through its own Serialise, as the editor does. The source registry was
+	// empty, so entity ids are creation indices and parents come before their children.
+	auto saveJson = [&]()
+	{
+		nlohmann::json output;
+		source.each([&](entt::entity entity)
+		{
+			nlohmann::json components;
+			if (auto transform = source.try_get<Transform>(entity))
+				components["transform"] = transform->Serialise();
+			auto hierarchy = source.try_get<Hierarchy>(entity);
+			if (hierarchy && hierarchy->parent() != entt::null)
+				components["parent"] = u32(hierarchy->parent());
+			if (auto physics = source.try_get<Physics3DComponent>(entity))
+				components["physics3D"] = physics->GetPhysicsObject()->Serialise();
+			output["entities"][u32(entity)] = components;
+		});
+
+		std::ofstream file(jsonPath);
+		file << output;
+		return file.good();
+	};
+
+	auto loadJson = [&]()
+	{
+		entt::registry registry;
+		SceneGraph sceneGraph;
+		sceneGraph.Init(registry);
+
+		std::ifstream file(jsonPath);
+		nlohmann::json input;
+		file >> input;
+
+		auto& entities = input["entities"];
+		std::vector<entt::entity> created(entities.size());
+		registry.create(created.begin(), created.end());
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			auto& components = entities[i];
+			if (components.count("parent") && !registry.has<Hierarchy>(created[i]))
+				registry.assign<Hierarchy>(created[i], created[components["parent"].get<u32>()]);
+			if (components.count("transform"))
+				registry.assign<Transform>(created[i]).Deserialise(components["transform"]);
+			if (components.count("physics3D"))
+			{
+				auto body = CreateRef<PhysicsObject3D>();
+				body->Deserialise(components["physics3D"]);
+				registry.assign<Physics3DComponent>(created[i], body);
+			}
+		}
+
+		return registry.alive();
+	};
+
+	auto loadBinary = [&]()
+	{
+		entt::registry registry;
+		SceneGraph sceneGraph;
+		sceneGraph.Init(registry);
+		SceneBinarySerialiser::Load(registry, binaryPath);
+		return registry.alive();
+	};
+
+	BENCHMARK("Binary save")
+	{
+		return SceneBinarySerialiser::Save(source, binaryPath);
+	};
+
+	BENCHMARK("JSON save")
+	{
+		return saveJson();
+	};
+
+	BENCHMARK("Binary load")
+	{
+		return loadBinary();
+	};
+
+	BENCHMARK("JSON load")
+	{
+		return loadJson();
+	};
+
+	std::remove(binaryPath.c_str());
+	std::remove(jsonPath.c_str());
+}
+#endif
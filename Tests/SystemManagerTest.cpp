@@ -0,0 +1,238 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "ECS/SystemManager.h"
+#include "ECS/DirtySet.h"
+#include "Core/JobSystem.h"
+
+namespace
+{
+	using namespace Lumos;
+
+	struct ComponentA {};
+	struct ComponentB {};
+	struct Body2D {};
+	struct Body3D {};
+
+	//Records the order systems finish in and runs a nested parallel loop to check workers can wait on their own jobs
+	class TestSystem : public ISystem
+	{
+	public:
+		TestSystem(std::function<void(SystemAccess&)> declare, std::vector<int>& order, std::mutex& mutex, int id)
+			: m_Declare(declare), m_Order(order), m_Mutex(mutex), m_Id(id)
+		{
+		}
+
+		void OnInit() override {}
+		void OnImGui() override {}
+
+		void OnUpdate(TimeStep* dt, Scene* scene) override
+		{
+			std::atomic<u32> sum{ 0 };
+			System::JobSystem::Dispatch(64, 4, [&](JobDispatchArgs args) { sum.fetch_add(args.jobIndex); });
+			System::JobSystem::Wait();
+			REQUIRE(sum.load() == 64 * 63 / 2);
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Order.push_back(m_Id);
+		}
+
+		void DeclareAccess(SystemAccess& access) const override
+		{
+			if (m_Declare)
+				m_Declare(access);
+			else
+				ISystem::DeclareAccess(access);
+		}
+
+		void OnSceneAttach(Scene* scene) override
+		{
+			attached = scene;
+			attachCount++;
+		}
+
+		void OnSceneDetach(Scene* scene) override
+		{
+			REQUIRE(attached == scene);
+			attached = nullptr;
+		}
+
+		Scene* attached = nullptr;
+		int attachCount = 0;
+
+	private:
+		std::function<void(SystemAccess&)> m_Declare;
+		std::vector<int>& m_Order;
+		std::mutex& m_Mutex;
+		int m_Id;
+	};
+
+	template<int Id>
+	class NumberedSystem : public TestSystem
+	{
+	public:
+		using TestSystem::TestSystem;
+	};
+}
+
+TEST_CASE("System access conflicts", "[Lumos::ECS]")
+{
+	using namespace Lumos;
+
+	SystemAccess readA, writeA, writeB, transform2D, transform3D, transform;
+	readA.Read<ComponentA>();
+	writeA.Write<ComponentA>();
+	writeB.Write<ComponentB>();
+	transform2D.Write<Maths::Transform, Body2D, Body3D>();
+	transform3D.Write<Maths::Transform, Body3D>();
+	transform.Read<Maths::Transform>();
+
+	REQUIRE_FALSE(readA.ConflictsWith(readA));
+	REQUIRE(readA.ConflictsWith(writeA));
+	REQUIRE_FALSE(writeA.ConflictsWith(writeB));
+	REQUIRE_FALSE(transform2D.ConflictsWith(transform3D));
+	REQUIRE(transform2D.ConflictsWith(transform2D));
+
+	// Filters that can match the same entity conflict
+	SystemAccess overlapping;
+	overlapping.Write<Maths::Transform, Body2D>();
+	REQUIRE(overlapping.ConflictsWith(transform3D));
+	REQUIRE(transform.ConflictsWith(transform3D));
+	REQUIRE(SystemAccess().WriteAll().ConflictsWith(readA));
+}
+
+TEST_CASE("System manager stages", "[Lumos::ECS]")
+{
+	using namespace Lumos;
+
+	std::vector<int> order;
+	std::mutex mutex;
+
+	SystemManager manager;
+	manager.RegisterSystem<NumberedSystem<0>>([](SystemAccess& a) { a.Write<ComponentA>(); }, order, mutex, 0);
+	manager.RegisterSystem<NumberedSystem<1>>([](SystemAccess& a) { a.Write<ComponentB>(); }, order, mutex, 1);
+	manager.RegisterSystem<NumberedSystem<2>>([](SystemAccess& a) { a.Read<ComponentA>(); }, order, mutex, 2);
+	manager.RegisterSystem<NumberedSystem<3>>(nullptr, order, mutex, 3);
+
+	REQUIRE(manager.GetSystem<NumberedSystem<2>>() != nullptr);
+	REQUIRE(manager.HasSystem<NumberedSystem<3>>());
+
+	// The schedule is built before the first update, which already runs in stages
+	for (int i = 0; i < 20; i++)
+	{
+		order.clear();
+		manager.OnUpdate(nullptr, nullptr);
+		REQUIRE(manager.GetStageCount() == 3);
+
+		// 0 and 1 share a stage, 2 waits for 0, 3 declares nothing and runs alone last
+		REQUIRE(order.size() == 4);
+		REQUIRE(order[2] == 2);
+		REQUIRE(order[3] == 3);
+	}
+
+	REQUIRE(manager.GetSystemCount() == 4);
+	for (u32 i = 0; i < manager.GetSystemCount(); i++)
+		REQUIRE(manager.GetLastUpdateTime(i) > 0.0f);
+
+	manager.RemoveSystem<NumberedSystem<3>>();
+	REQUIRE_FALSE(manager.HasSystem<NumberedSystem<3>>());
+	REQUIRE(manager.GetSystemCount() == 3);
+	manager.OnUpdate(nullptr, nullptr);
+	REQUIRE(manager.GetStageCount() == 2);
+}
+
+TEST_CASE("System manager scene attach", "[Lumos::ECS]")
+{
+	using namespace Lumos;
+
+	std::vector<int> order;
+	std::mutex mutex;
+
+	SystemManager manager;
+	auto system = manager.RegisterSystem<NumberedSystem<0>>(nullptr, order, mutex, 0);
+
+	Scene first("First");
+	Scene second("Second");
+
+	// Attached once before the first update with a scene
+	manager.OnUpdate(nullptr, &first);
+	manager.OnUpdate(nullptr, &first);
+	REQUIRE(system->attached == &first);
+	REQUIRE(system->attachCount == 1);
+
+	// Switching scenes detaches the last one
+	manager.OnUpdate(nullptr, &second);
+	REQUIRE(system->attached == &second);
+	REQUIRE(system->attachCount == 2);
+
+	// A cleaned up scene is attached again on its next update
+	manager.DetachScene(&second);
+	REQUIRE(system->attached == nullptr);
+	manager.OnUpdate(nullptr, &second);
+	REQUIRE(system->attached == &second);
+	REQUIRE(system->attachCount == 3);
+
+	// Added systems are attached to the current scene too
+	auto added = manager.RegisterSystem<NumberedSystem<1>>(nullptr, order, mutex, 1);
+	manager.OnUpdate(nullptr, &second);
+	REQUIRE(added->attached == &second);
+	REQUIRE(system->attachCount == 4);
+
+	manager.DetachScene(&second);
+}
+
+TEST_CASE("Physics engines reporting transform changes", "[Lumos::ECS]")
+{
+	using namespace Lumos;
+
+	SystemManager systems;
+	auto physics3D = systems.RegisterSystem<LumosPhysicsEngine>();
+	auto physics2D = systems.RegisterSystem<B2PhysicsEngine>();
+	physics3D->SetDefaults();
+	physics2D->SetDefaults();
+	physics3D->SetPaused(false);
+	physics2D->SetPaused(false);
+
+	Scene scene("Transform Changes");
+	scene.SetSystemManager(&systems);
+	auto& registry = scene.GetRegistry();
+
+	const int bodyCount = 64;
+	for (int i = 0; i < bodyCount; i++)
+	{
+		auto body = CreateRef<PhysicsObject3D>();
+		body->SetCollisionShape(CreateRef<SphereCollisionShape>(0.5f));
+		body->SetPosition(Maths::Vector3(float(i) * 2.0f, 10.0f, 0.0f));
+		body->SetInverseMass(1.0f);
+
+		auto entity = registry.create();
+		registry.assign<Maths::Transform>(entity);
+		registry.assign<Physics3DComponent>(entity, body);
+
+		PhysicsObjectParamaters params;
+		params.position = Maths::Vector3(float(i) * 2.0f, 10.0f, 0.0f);
+		params.engine = physics2D.get();
+		auto body2D = CreateRef<PhysicsObject2D>();
+		body2D->Init(params);
+
+		auto entity2D = registry.create();
+		registry.assign<Maths::Transform>(entity2D);
+		registry.assign<Physics2DComponent>(entity2D, body2D);
+	}
+
+	// Both engines report the bodies they move to the same dirty sets
+	DirtySet<Maths::Transform> changed(registry);
+
+	TimeStep timeStep(0.0f);
+	for (int frame = 0; frame < 10; frame++)
+	{
+		timeStep.Step(1.0f / 60.0f);
+		systems.OnUpdate(&timeStep, &scene);
+
+		REQUIRE(systems.GetStageCount() == 2);
+		REQUIRE(changed.Size() == bodyCount * 2);
+		changed.Clear();
+	}
+
+	scene.OnCleanupScene();
+}
@@ -0,0 +1,67 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include "App/SceneGraph.h"
+#include "App/TransformInterpolator.h"
+
+TEST_CASE("Transform interpolation between ticks", "[Lumos::TransformInterpolator]")
+{
+	using namespace Lumos;
+	using namespace Maths;
+
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	auto moving = registry.create();
+	registry.assign<Transform>(moving, Vector3(0.0f, 0.0f, 0.0f));
+	auto child = registry.create();
+	registry.assign<Transform>(child, Vector3(0.0f, 1.0f, 0.0f));
+	registry.assign<Hierarchy>(child, moving);
+	auto still = registry.create();
+	registry.assign<Transform>(still, Vector3(5.0f, 0.0f, 0.0f));
+
+	TransformInterpolator interpolator;
+	sceneGraph.Update(registry);
+	interpolator.Capture(registry);
+	REQUIRE(interpolator.GetMovingCount() == 0);
+
+	// One tick moves the root, its child follows through the scene graph
+	registry.get<Transform>(moving).SetLocalPosition(Vector3(2.0f, 0.0f, 0.0f));
+	registry.get<Transform>(moving).SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(0.0f, 90.0f, 0.0f));
+	sceneGraph.Update(registry);
+	interpolator.Capture(registry);
+	REQUIRE(interpolator.GetMovingCount() == 2);
+
+	interpolator.Apply(registry, 0.5f);
+	REQUIRE(registry.get<Transform>(moving).GetWorldPosition().x == Approx(1.0f));
+	REQUIRE(registry.get<Transform>(child).GetWorldPosition().x == Approx(1.0f));
+	REQUIRE(registry.get<Transform>(child).GetWorldPosition().y == Approx(1.0f));
+	REQUIRE(registry.get<Transform>(still).GetWorldPosition().x == Approx(5.0f));
+
+	const Maths::Quaternion halfway = registry.get<Transform>(moving).GetWorldOrientation();
+	REQUIRE(std::abs(halfway.w) == Approx(std::cos(3.14159265f / 8.0f)).margin(0.001f));
+
+	// Restoring puts the simulated pose back
+	interpolator.Restore(registry);
+	REQUIRE(registry.get<Transform>(moving).GetWorldPosition().x == Approx(2.0f));
+
+	// Once it stops, having been blended and restored doesn't make it moving
+	sceneGraph.Update(registry);
+	interpolator.Capture(registry);
+	REQUIRE(interpolator.GetMovingCount() == 0);
+
+	// A tick without movement leaves nothing to blend, new transforms snap to where they are
+	auto added = registry.create();
+	registry.assign<Transform>(added, Vector3(9.0f, 0.0f, 0.0f));
+	sceneGraph.Update(registry);
+	interpolator.Capture(registry);
+	sceneGraph.Update(registry);
+	interpolator.Capture(registry);
+	REQUIRE(interpolator.GetMovingCount() == 0);
+
+	interpolator.Apply(registry, 0.25f);
+	REQUIRE(registry.get<Transform>(added).GetWorldPosition().x == Approx(9.0f));
+	REQUIRE(registry.get<Transform>(moving).GetWorldPosition().x == Approx(2.0f));
+	interpolator.Restore(registry);
+}
@@ -42,7 +42,8 @@ project "Tests"
 	{
 		--"LUMOS_DYNAMIC",
         "LUMOS_ROOT_DIR="  .. cwd,
-        "CATCH_CPP11_OR_GREATER"
+        "CATCH_CPP11_OR_GREATER",
+        "CATCH_CONFIG_ENABLE_BENCHMARKING"
 	}
 
 	filter "system:windows"
@@ -31,6 +31,8 @@ workspace "Lumos"
 	require("Lumos/premake5")
 	require("Sandbox/premake5")
 	require("Tests/premake5")
+	require("Benchmarks/premake5")
+	require("HeadlessHost/premake5")
 	--require("Examples/premake5")
 
 	filter()